@@ -7,6 +7,7 @@
 #include <format>
 #include <iostream>
 #include <span>
+#include <string>
 #include <string_view>
 
 namespace {
@@ -57,6 +58,10 @@ class App : public gvdi::App {
 		bool force_x11{false};
 		// disable libdecor (Wayland).
 		bool nolibdecor{false};
+		// no window or display (GLFW null platform), for streaming the UI via remote.
+		bool headless{false};
+		// address to stream the UI to a remote-viewer from (eg "localhost:7070").
+		std::string remote{};
 	};
 
 	explicit App(Params const& params) : m_params(params) {}
@@ -88,6 +93,12 @@ class App : public gvdi::App {
 		return create_windowed_window(title.c_str(), 1280, 720);
 	}
 
+	auto get_options() const -> gvdi::Options final {
+		auto ret = gvdi::Options{};
+		ret.remote_address = m_params.remote;
+		return ret;
+	}
+
 	void pre_event_loop() final {
 		auto const gpu_info = get_gpu_info();
 		std::cout << std::format("Using GPU: {} [{}]\n", gpu_info.name, to_string_view(gpu_info.type));
@@ -106,7 +117,11 @@ class App : public gvdi::App {
 
 	// set GLFW init hints here.
 	void stage_initialize() final {
-		if (m_params.force_x11 && glfwPlatformSupported(GLFW_PLATFORM_X11)) {
+		if (m_params.headless) {
+			std::cout << "-- Headless\n";
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		}
+		if (!m_params.headless && m_params.force_x11 && glfwPlatformSupported(GLFW_PLATFORM_X11)) {
 			std::cout << "-- Forcing X11\n";
 			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
 		}
@@ -158,8 +173,14 @@ auto main(int argc, char** argv) -> int {
 				params.force_x11 = true;
 			} else if (arg == "--nolibdecor") {
 				params.nolibdecor = true;
+			} else if (arg == "--headless") {
+				params.headless = true;
+			} else if (arg == "--remote" && args.size() > 1) {
+				args = args.subspan(1);
+				params.remote = args.front();
 			} else if (arg == "--help") {
-				std::cout << std::format("Usage: {} [--force-x11] [--nolibdecor]\n", exe_name);
+				std::cout << std::format("Usage: {} [--force-x11] [--nolibdecor] [--headless] [--remote <host:port | unix:path>]\n",
+										 exe_name);
 				return EXIT_SUCCESS;
 			} else {
 				std::cerr << std::format("Unrecognized option: {}\n", arg);
@@ -1,4 +1,5 @@
 #include "gvdi/app.hpp"
+#include "gvdi/stats_window.hpp"
 #include <cstdlib>
 #include <format>
 #include <iostream>
@@ -10,7 +11,16 @@ class App : public gvdi::App {
 	void update() final {
 		// for this example we just show the demo window.
 		ImGui::ShowDemoWindow();
+		// and gvdi's telemetry, if toggled.
+		if (m_show_stats) { gvdi::show_stats_window(*this, &m_show_stats); }
 	}
+
+	// toggle the stats window on S (unless Dear ImGui is using the keyboard, eg for text input).
+	void on_key_release(int const key, int /*scancode*/, int const mods) final {
+		if (key == GLFW_KEY_S && mods == 0 && !ImGui::GetIO().WantCaptureKeyboard) { m_show_stats = !m_show_stats; }
+	}
+
+	bool m_show_stats{};
 };
 } // namespace
 
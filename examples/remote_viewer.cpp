@@ -0,0 +1,106 @@
+#include "GLFW/glfw3.h"
+#include "gvdi/app.hpp"
+#include "gvdi/build_version.hpp"
+#include "gvdi/remote.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Thin client for an App streaming its UI (eg custom-window --remote <address>).
+namespace {
+class App : public gvdi::App {
+  public:
+	explicit App(std::string address) : m_address(std::move(address)) {}
+
+  private:
+	void update() final {
+		if (!m_viewer) { return; }
+		auto const& io = ImGui::GetIO();
+		if (!m_viewer->draw(*ImGui::GetBackgroundDrawList(), {0.0f, 0.0f}, io.DisplaySize)) {
+			std::cout << std::format("Disconnected from {}\n", m_address);
+			set_should_close_window(true);
+		}
+	}
+
+	auto create_glfw_window() -> GLFWwindow* final {
+		auto const title = std::format("gvdi v{} - {}", gvdi::build_version_v, m_address);
+		return create_windowed_window(title.c_str(), 1280, 720);
+	}
+
+	void pre_first_frame() final {
+		// textures are owned by the renderer: (re)connect after every (re)boot.
+		m_viewer.reset();
+		m_viewer.emplace(*this, m_address);
+		std::cout << std::format("Connected to {}\n", m_address);
+
+		// the server's window is resized to match ours.
+		auto width = int{};
+		auto height = int{};
+		glfwGetWindowSize(get_window(), &width, &height);
+		m_viewer->on_window_resize(width, height);
+	}
+
+	// forward input to the server.
+	void on_window_resize(int const x, int const y) final { forward(&gvdi::RemoteViewer::on_window_resize, x, y); }
+	void on_window_focus(bool const focused) final { forward(&gvdi::RemoteViewer::on_window_focus, focused); }
+	void on_key_press(int const key, int const scancode, int const mods) final {
+		forward(&gvdi::RemoteViewer::on_key_press, key, scancode, mods);
+	}
+	void on_key_release(int const key, int const scancode, int const mods) final {
+		forward(&gvdi::RemoteViewer::on_key_release, key, scancode, mods);
+	}
+	void on_key_repeat(int const key, int const scancode, int const mods) final {
+		forward(&gvdi::RemoteViewer::on_key_repeat, key, scancode, mods);
+	}
+	void on_character(std::uint32_t const codepoint) final { forward(&gvdi::RemoteViewer::on_character, codepoint); }
+	void on_cursor_reposition(double const x, double const y) final { forward(&gvdi::RemoteViewer::on_cursor_reposition, x, y); }
+	void on_cursor_enter(bool const entered) final { forward(&gvdi::RemoteViewer::on_cursor_enter, entered); }
+	void on_mouse_button_press(int const button, int const mods) final {
+		forward(&gvdi::RemoteViewer::on_mouse_button_press, button, mods);
+	}
+	void on_mouse_button_release(int const button, int const mods) final {
+		forward(&gvdi::RemoteViewer::on_mouse_button_release, button, mods);
+	}
+	void on_mouse_scroll(double const x, double const y) final { forward(&gvdi::RemoteViewer::on_mouse_scroll, x, y); }
+
+	template <typename... Args>
+	void forward(void (gvdi::RemoteViewer::*callback)(Args...), Args const... args) {
+		if (m_viewer) { (*m_viewer.*callback)(args...); }
+	}
+
+	std::string m_address{};
+	std::optional<gvdi::RemoteViewer> m_viewer{};
+};
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+	try {
+		auto exe_name = std::string{"<app>"};
+		auto args = std::span{argv, static_cast<std::size_t>(argc)};
+		if (!args.empty()) {
+			exe_name = std::filesystem::path{args.front()}.filename().string();
+			args = args.subspan(1);
+		}
+
+		if (args.size() != 1 || std::string_view{args.front()} == "--help") {
+			std::cout << std::format("Usage: {} <host:port | unix:path>\n", exe_name);
+			return args.size() == 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+
+		auto app = App{args.front()};
+		app.run_event_loop();
+	} catch (std::exception const& e) {
+		std::cout << std::format("PANIC: {}\n", e.what());
+		return EXIT_FAILURE;
+	} catch (...) {
+		std::cout << "PANIC!\n";
+		return EXIT_FAILURE;
+	}
+}
@@ -1,13 +1,31 @@
 #pragma once
+#include "gvdi/compressed_bitmap.hpp"
 #include "gvdi/event_listener.hpp"
+#include "gvdi/glyph_cache.hpp"
 #include "gvdi/gpu.hpp"
+#include "gvdi/image_atlas.hpp"
+#include "gvdi/mpsc_queue.hpp"
+#include "gvdi/options.hpp"
+#include "gvdi/remote.hpp"
+#include "gvdi/render_target.hpp"
+#include "gvdi/secondary_window.hpp"
+#include "gvdi/stats.hpp"
+#include "gvdi/texture.hpp"
+#include "gvdi/virtual_image.hpp"
 #include <GLFW/glfw3.h>
 #include <imgui.h>
 #include <array>
+#include <functional>
 #include <memory>
 #include <span>
 
 namespace gvdi {
+/// \brief Counters for App::post() (unbounded) and App::try_post() (bounded).
+struct PostStats {
+	QueueStats unbounded{};
+	QueueStats bounded{};
+};
+
 /// \brief Abstract base class for a windowed app.
 /// Having more than one App instance is unsupported.
 class App : public EventListener {
@@ -18,6 +36,12 @@ class App : public EventListener {
 		gpu::Type::Cpu,
 	};
 
+	/// \brief Default capacity of the bounded post queue (see try_post()).
+	static constexpr std::size_t post_capacity_v{4096};
+
+	/// \brief Callable posted to the main thread.
+	using Task = std::function<void()>;
+
 	App(App const&) = delete;
 	App(App&&) = delete;
 	auto operator=(App const&) = delete;
@@ -26,6 +50,8 @@ class App : public EventListener {
 	virtual ~App() = default;
 
 	explicit(false) App();
+	/// \param bounded_post_capacity Capacity of the bounded post queue (rounded up to a power of two).
+	explicit App(std::size_t bounded_post_capacity);
 
 	/// \brief Entrypoint. Returns after the window and all associated resources have been destroyed.
 	/// GLFW remains initialized until App is destroyed.
@@ -40,6 +66,55 @@ class App : public EventListener {
 	[[nodiscard]] auto will_reboot() const -> bool;
 	void schedule_reboot();
 
+	/// \brief Enqueue a task to be run on the main thread before the next update().
+	/// Thread-safe and lock-free, wakes up the event loop if it is waiting on GLFW.
+	void post(Task task);
+	/// \brief Bounded variant of post(), thread-safe and lock-free.
+	/// Tasks in the bounded queue are run after those enqueued via post().
+	/// \returns false if the bounded queue is full (task is dropped).
+	[[nodiscard]] auto try_post(Task task) -> bool;
+	/// \returns Counters for post() and try_post().
+	[[nodiscard]] auto get_post_stats() const -> PostStats;
+	/// \returns Counters for streaming the UI to a RemoteViewer (see Options::remote_address), zero if disabled.
+	[[nodiscard]] auto get_remote_stats() const -> RemoteStats;
+
+	/// \returns Dear ImGui allocation telemetry, frame counters refer to the last completed frame.
+	[[nodiscard]] auto get_imgui_alloc_stats() const -> AllocStats;
+	/// \returns Renderer telemetry, default initialized until create_window() has returned.
+	/// In steady state (no resizes), FrameStats::vk_objects_created and AllocStats::frame_allocations are expected to be 0.
+	[[nodiscard]] auto get_frame_stats() const -> FrameStats;
+	/// \returns Per-heap budget / usage (via VK_EXT_memory_budget when available) and gvdi's allocation totals.
+	/// Queries the driver on each call: prefer calling it at most once per frame.
+	[[nodiscard]] auto get_memory_stats() const -> gpu::MemoryStats;
+
+	/// \brief Create a texture from RGBA8 pixels, uploaded before the next frame is rendered.
+	/// Descriptor sets are allocated from growable pools owned by gvdi and recycled when textures are destroyed.
+	/// Throws if stage_create() has not been called.
+	[[nodiscard]] auto create_texture(Bitmap const& bitmap) -> Texture;
+	/// \brief Create a texture from block compressed pixels (see parse_compressed_bitmap()), including all their levels.
+	/// Uploaded as is if the GPU supports bitmap.format, otherwise decoded to RGBA8 on the CPU (see can_decode()).
+	/// Throws if neither is possible, or if stage_create() has not been called.
+	[[nodiscard]] auto create_texture(CompressedBitmap const& bitmap) -> Texture;
+	/// \returns true if textures of format are sampled directly by the GPU, false until create_window() has returned.
+	[[nodiscard]] auto is_block_format_supported(BlockFormat format) const -> bool;
+	/// \brief Create an offscreen render target, see RenderTarget::render() for recording custom passes into it.
+	/// Throws if stage_create() has not been called.
+	[[nodiscard]] auto create_render_target(RenderTargetCreateInfo const& create_info) -> RenderTarget;
+	/// \brief Create a tiled, streaming viewer for images too large to be a single Texture (see VirtualImage).
+	/// Throws if stage_create() has not been called, or if create_info.source is null.
+	[[nodiscard]] auto create_virtual_image(VirtualImageCreateInfo const& create_info) -> VirtualImage;
+	/// \brief Create an atlas packing small images into shared textures (see ImageAtlas).
+	/// Throws if stage_create() has not been called, or if create_info is invalid.
+	[[nodiscard]] auto create_image_atlas(ImageAtlasCreateInfo const& create_info) -> ImageAtlas;
+	/// \brief Create a font whose glyphs are rasterized on first use (see GlyphCache), eg for CJK coverage.
+	/// Throws if stage_create() has not been called, or if the font cannot be loaded.
+	[[nodiscard]] auto create_glyph_cache(GlyphCacheCreateInfo const& create_info) -> GlyphCache;
+	/// \brief Create an additional window presented alongside the main one, drawn to through its draw list (see SecondaryWindow).
+	/// Throws if stage_create() has not been called, or if the window cannot be created or presented to.
+	[[nodiscard]] auto create_secondary_window(SecondaryWindowCreateInfo const& create_info) -> SecondaryWindow;
+	/// \returns Vulkan handles for creating custom pipelines / resources, null until create_window() has returned.
+	[[nodiscard]] auto get_vulkan_handles() const -> VulkanHandles;
+
   protected:
 	[[nodiscard]] static auto create_windowed_window(char const* title, int width = 800, int height = 600) -> GLFWwindow*;
 	[[nodiscard]] static auto create_fullscreen_window(char const* title) -> GLFWwindow*;
@@ -51,6 +126,8 @@ class App : public EventListener {
 	virtual auto create_glfw_window() -> GLFWwindow* { return create_windowed_window("gvdi App"); }
 	/// \brief List of GPU types in desired selection order.
 	[[nodiscard]] virtual auto get_gpu_type_priority() const -> std::span<gpu::Type const> { return gpu_priority_v; }
+	/// \brief Library options, queried in stage_create().
+	[[nodiscard]] virtual auto get_options() const -> Options { return {}; }
 
 	/// \brief Called after stage_create() and before the event loop begins.
 	virtual void pre_event_loop() {}
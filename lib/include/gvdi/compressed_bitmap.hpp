@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace gvdi {
+/// \brief Block compressed pixel formats (UNORM: sRGB variants in files are treated as UNORM, like RGBA8 Bitmaps).
+enum class BlockFormat : std::int8_t {
+	/// \brief RGB(A1), 8 bytes per 4x4 block.
+	Bc1,
+	/// \brief RGBA with explicit 4 bit alpha, 16 bytes per 4x4 block.
+	Bc2,
+	/// \brief RGBA with interpolated alpha, 16 bytes per 4x4 block.
+	Bc3,
+	/// \brief R, 8 bytes per 4x4 block.
+	Bc4,
+	/// \brief RG, 16 bytes per 4x4 block.
+	Bc5,
+	/// \brief RGBA, 16 bytes per 4x4 block.
+	Bc7,
+	/// \brief RGB, 8 bytes per 4x4 block.
+	Etc2Rgb,
+	/// \brief RGBA (EAC alpha), 16 bytes per 4x4 block.
+	Etc2Rgba,
+	Astc4x4,
+	Astc6x6,
+	Astc8x8,
+	COUNT_,
+};
+
+inline constexpr auto block_format_count_v = static_cast<std::size_t>(BlockFormat::COUNT_);
+
+struct BlockInfo {
+	int width{};
+	int height{};
+	int bytes{};
+};
+
+[[nodiscard]] constexpr auto get_block_info(BlockFormat const format) -> BlockInfo {
+	switch (format) {
+	case BlockFormat::Bc1:
+	case BlockFormat::Bc4:
+	case BlockFormat::Etc2Rgb: return BlockInfo{.width = 4, .height = 4, .bytes = 8};
+	case BlockFormat::Astc6x6: return BlockInfo{.width = 6, .height = 6, .bytes = 16};
+	case BlockFormat::Astc8x8: return BlockInfo{.width = 8, .height = 8, .bytes = 16};
+	default: return BlockInfo{.width = 4, .height = 4, .bytes = 16};
+	}
+}
+
+[[nodiscard]] constexpr auto to_string_view(BlockFormat const format) -> std::string_view {
+	switch (format) {
+	case BlockFormat::Bc1: return "BC1";
+	case BlockFormat::Bc2: return "BC2";
+	case BlockFormat::Bc3: return "BC3";
+	case BlockFormat::Bc4: return "BC4";
+	case BlockFormat::Bc5: return "BC5";
+	case BlockFormat::Bc7: return "BC7";
+	case BlockFormat::Etc2Rgb: return "ETC2 RGB";
+	case BlockFormat::Etc2Rgba: return "ETC2 RGBA";
+	case BlockFormat::Astc4x4: return "ASTC 4x4";
+	case BlockFormat::Astc6x6: return "ASTC 6x6";
+	case BlockFormat::Astc8x8: return "ASTC 8x8";
+	default: return "Unknown";
+	}
+}
+
+/// \returns true if decode_blocks() supports format (the CPU fallback for GPUs lacking it).
+[[nodiscard]] constexpr auto can_decode(BlockFormat const format) -> bool {
+	switch (format) {
+	case BlockFormat::Bc1:
+	case BlockFormat::Bc2:
+	case BlockFormat::Bc3:
+	case BlockFormat::Bc4:
+	case BlockFormat::Bc5:
+	case BlockFormat::Etc2Rgb:
+	case BlockFormat::Etc2Rgba: return true;
+	default: return false;
+	}
+}
+
+/// \brief View into block compressed pixels and their mip chain.
+struct CompressedBitmap {
+	BlockFormat format{};
+	int width{};
+	int height{};
+	/// \brief Level 0 (width x height) first, each level halves the extent (down to 1).
+	/// Blocks are tightly packed, row-major starting from the top-left.
+	std::vector<std::span<std::byte const>> levels{};
+};
+
+/// \brief Parse a KTX2 or DDS file (detected by its identifier) into views of its 2D mip chain.
+/// Supercompressed KTX2 (Basis Universal, Zstandard, ZLIB), arrays, cubemaps, and 3D images are unsupported.
+/// Throws on invalid / unsupported files. The returned views refer to bytes.
+[[nodiscard]] auto parse_compressed_bitmap(std::span<std::byte const> bytes) -> CompressedBitmap;
+
+/// \brief Decode blocks of a width x height image into tightly packed RGBA8 (width * height * 4 bytes) out.
+/// BC4 decodes to (R, 0, 0, 1), BC5 to (R, G, 0, 1): as sampled from the GPU formats.
+/// Throws if format cannot be decoded (see can_decode()) or sizes mismatch.
+void decode_blocks(BlockFormat format, std::span<std::byte const> blocks, int width, int height, std::span<std::byte> out);
+} // namespace gvdi
@@ -0,0 +1,64 @@
+#pragma once
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace gvdi {
+namespace detail {
+class GlyphAtlas;
+} // namespace detail
+
+/// \brief Parameters for App::create_glyph_cache().
+struct GlyphCacheCreateInfo {
+	/// \brief TrueType / OpenType font file contents, copied by the cache.
+	std::span<std::byte const> font{};
+	/// \brief Index of the font in a collection (TTC), 0 otherwise.
+	int font_index{};
+	/// \brief Pixel height, as ImFontConfig::SizePixels.
+	float size{16.0f};
+	/// \brief Zero terminated pairs of inclusive codepoint ranges (see ImFontAtlas::GetGlyphRanges*()), null for Basic Latin.
+	/// Only glyph metrics are loaded up front: full CJK ranges are cheap.
+	ImWchar const* ranges{};
+	/// \brief Width and height of the atlas texture (RGBA8), limits the number of distinct glyphs drawn in a single frame.
+	int atlas_size{1024};
+};
+
+/// \brief Counters for a GlyphCache.
+struct GlyphCacheStats {
+	/// \brief Glyphs in the requested ranges present in the font.
+	std::uint32_t glyphs{};
+	/// \brief Glyphs currently rasterized into the atlas.
+	std::uint32_t resident{};
+	/// \brief Atlas slots (maximum resident glyphs).
+	std::uint32_t capacity{};
+	std::uint64_t total_rasterized{};
+	std::uint64_t total_evicted{};
+	/// \brief Glyphs that could not be rasterized in the last frame (all slots in use by that frame): drawn blank.
+	std::uint32_t overflowed{};
+};
+
+/// \brief Font whose glyphs are rasterized on first use, instead of baking whole ranges into the Dear ImGui font atlas.
+/// Glyphs are packed into fixed size slots of an atlas texture, evicting the least recently drawn ones.
+/// After each frame is ended, glyphs referenced by its draw data that are not resident are rasterized,
+/// uploaded (only the affected slots), and the vertices referencing them are patched: new glyphs are visible in the same frame.
+/// Owned by the App's renderer: invalidated by App::stage_destroy() (and thus reboots).
+class GlyphCache {
+  public:
+	GlyphCache() = default;
+
+	explicit GlyphCache(std::shared_ptr<detail::GlyphAtlas> atlas);
+
+	/// \returns Font for ImGui::PushFont() (or ImGuiIO::FontDefault), null if not valid.
+	[[nodiscard]] auto get_font() const -> ImFont*;
+	[[nodiscard]] auto get_stats() const -> GlyphCacheStats;
+
+	/// \returns false if default constructed, or if the owning renderer has been destroyed.
+	[[nodiscard]] auto is_valid() const -> bool;
+	explicit operator bool() const { return is_valid(); }
+
+  private:
+	std::shared_ptr<detail::GlyphAtlas> m_atlas{};
+};
+} // namespace gvdi
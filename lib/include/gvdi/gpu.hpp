@@ -1,5 +1,8 @@
 #pragma once
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string_view>
 
 namespace gvdi::gpu {
@@ -19,4 +22,49 @@ struct Info {
 	Type type{Type::Other};
 	std::string_view name{};
 };
+
+/// \brief Categories of GPU memory allocated by gvdi.
+enum class MemoryCategory : std::int8_t { Swapchain, ImGuiBuffers, Fonts, UserTextures, COUNT_ };
+
+inline constexpr auto memory_category_count_v = static_cast<std::size_t>(MemoryCategory::COUNT_);
+
+/// \brief VK_MAX_MEMORY_HEAPS.
+inline constexpr std::size_t max_memory_heaps_v{16};
+
+[[nodiscard]] constexpr auto to_string_view(MemoryCategory const category) -> std::string_view {
+	switch (category) {
+	case MemoryCategory::Swapchain: return "Swapchain";
+	case MemoryCategory::ImGuiBuffers: return "ImGui Buffers";
+	case MemoryCategory::Fonts: return "Fonts";
+	case MemoryCategory::UserTextures: return "User Textures";
+	default: return "Unknown";
+	}
+}
+
+struct MemoryHeap {
+	std::uint64_t size{};
+	/// \brief Bytes the process can allocate from this heap without degrading performance.
+	/// Equals size if VK_EXT_memory_budget is not available.
+	std::uint64_t budget{};
+	/// \brief Bytes used by the process on this heap, 0 if VK_EXT_memory_budget is not available.
+	std::uint64_t usage{};
+	bool device_local{};
+};
+
+struct MemoryStats {
+	/// \brief Whether heap budget / usage reflect VK_EXT_memory_budget.
+	bool has_budget{};
+	/// \brief Heaps of the device, the first heap_count are valid.
+	std::array<MemoryHeap, max_memory_heaps_v> heaps{};
+	std::uint32_t heap_count{};
+	/// \brief Bytes allocated by gvdi, indexed by MemoryCategory.
+	/// Swapchain and Fonts are estimates when the memory is owned by the driver / Dear ImGui backend.
+	std::array<std::uint64_t, memory_category_count_v> allocated{};
+
+	[[nodiscard]] constexpr auto get_heaps() const -> std::span<MemoryHeap const> { return std::span{heaps}.first(heap_count); }
+
+	[[nodiscard]] constexpr auto get_allocated(MemoryCategory const category) const -> std::uint64_t {
+		return allocated.at(static_cast<std::size_t>(category));
+	}
+};
 } // namespace gvdi::gpu
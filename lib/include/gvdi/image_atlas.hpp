@@ -0,0 +1,81 @@
+#pragma once
+#include "gvdi/texture.hpp"
+#include <imgui.h>
+#include <cstdint>
+#include <memory>
+
+namespace gvdi {
+/// \brief Parameters for App::create_image_atlas().
+struct ImageAtlasCreateInfo {
+	/// \brief Width and height of each page texture (RGBA8).
+	int page_size{1024};
+	/// \brief Largest width / height accepted by ImageAtlas::add(), larger images should be Textures.
+	int max_image_size{128};
+	/// \brief Transparent pixels around each image, avoids bleeding between neighbours when filtered.
+	int padding{1};
+	/// \brief Pixels repacked per frame, bounds the per-frame upload cost of repacking.
+	std::uint32_t repack_pixels_per_frame{256 * 1024};
+};
+
+/// \brief Location of an image in an ImageAtlas, for ImGui::Image() / ImDrawList::AddImage().
+struct AtlasRegion {
+	ImTextureID id{};
+	ImVec2 uv0{};
+	ImVec2 uv1{};
+	ImVec2 size{};
+};
+
+/// \brief Counters for an ImageAtlas.
+struct ImageAtlasStats {
+	std::uint32_t images{};
+	std::uint32_t pages{};
+	/// \brief Fraction of page area occupied by live images (including padding).
+	float occupancy{};
+	std::uint64_t total_repacks{};
+	/// \brief Whether a repack is being uploaded (incrementally, see ImageAtlasCreateInfo::repack_pixels_per_frame).
+	bool repacking{};
+};
+
+/// \brief Packs many small images into shared page textures, so that consecutive images drawn from the same page
+/// share a descriptor set and a draw command (eg icon-dense toolbars and lists).
+/// Pages are packed with a skyline packer, space freed by remove() (or resizing update()s) is not reused in place:
+/// once enough has been freed, all live images are repacked into new pages (uploaded over several frames),
+/// which replace the current ones as a whole.
+/// Regions move when repacked: query get_region() each frame, instead of storing it.
+/// Owned by the App's renderer: invalidated by App::stage_destroy() (and thus reboots).
+class ImageAtlas {
+  public:
+	/// \brief Identifies an image in the atlas, stable across repacks.
+	enum class Id : std::uint32_t {};
+
+	ImageAtlas() = default;
+
+	explicit ImageAtlas(std::shared_ptr<detail::TextureStore> const& store, ImageAtlasCreateInfo const& create_info);
+
+	/// \brief Copy bitmap into the atlas, visible from the next frame.
+	/// Throws if bitmap is invalid or larger than ImageAtlasCreateInfo::max_image_size.
+	[[nodiscard]] auto add(Bitmap const& bitmap) -> Id;
+	/// \brief Replace the contents of an image, in place if its size is unchanged.
+	void update(Id id, Bitmap const& bitmap);
+	void remove(Id id);
+
+	/// \returns Region of id in the current frame, default initialized if id is not in the atlas.
+	[[nodiscard]] auto get_region(Id id) -> AtlasRegion;
+	/// \brief Draw id via ImGui::Image().
+	/// \param size Size of the image on screen, 0 uses the image's size.
+	void draw(Id id, ImVec2 size = {});
+
+	[[nodiscard]] auto get_stats() const -> ImageAtlasStats;
+
+	/// \returns false if default constructed, moved from, or if the owning renderer has been destroyed.
+	[[nodiscard]] auto is_valid() const -> bool;
+	explicit operator bool() const { return is_valid(); }
+
+  private:
+	class Impl;
+	struct Deleter {
+		void operator()(Impl* ptr) const noexcept;
+	};
+	std::unique_ptr<Impl, Deleter> m_impl{};
+};
+} // namespace gvdi
@@ -0,0 +1,203 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace gvdi {
+/// \brief Snapshot of queue counters.
+struct QueueStats {
+	/// \brief Total number of successful pushes.
+	std::uint64_t pushed{};
+	/// \brief Total number of pushes rejected due to a full queue (bounded only).
+	std::uint64_t rejected{};
+	/// \brief Highest number of queued elements observed by producers.
+	std::uint64_t peak_depth{};
+};
+
+namespace detail {
+// not std::hardware_destructive_interference_size: its value can differ between translation units.
+inline constexpr std::size_t cache_line_v{64};
+} // namespace detail
+
+/// \brief Unbounded lock-free multi-producer single-consumer queue.
+/// push() is safe to call from any thread, pop() / drain() only from the owning (consumer) thread.
+template <typename Type>
+class MpscQueue {
+  public:
+	MpscQueue(MpscQueue const&) = delete;
+	MpscQueue(MpscQueue&&) = delete;
+	auto operator=(MpscQueue const&) = delete;
+	auto operator=(MpscQueue&&) = delete;
+
+	explicit MpscQueue() : m_head(new Node{}), m_tail(m_head.load(std::memory_order_relaxed)) {}
+
+	~MpscQueue() {
+		while (m_tail != nullptr) { delete std::exchange(m_tail, m_tail->next.load(std::memory_order_relaxed)); }
+	}
+
+	void push(Type value) {
+		auto* node = new Node{.next = {}, .value = std::move(value)};
+		// count before linking so that the consumer never observes a negative depth.
+		auto const depth = m_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+		auto* prev = m_head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+		m_pushed.fetch_add(1, std::memory_order_relaxed);
+		update_peak(depth);
+	}
+
+	/// \returns false if the queue is empty (or a producer is mid-push).
+	[[nodiscard]] auto pop(Type& out) -> bool {
+		auto* next = m_tail->next.load(std::memory_order_acquire);
+		if (next == nullptr) { return false; }
+		out = std::move(next->value);
+		next->value = Type{};
+		delete std::exchange(m_tail, next);
+		m_depth.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/// \brief Pop and invoke func on each element present at the time of the call.
+	/// Elements pushed meanwhile (eg by func) are left for the next call.
+	/// \returns Number of elements drained.
+	template <typename Func>
+	auto drain(Func func) -> std::size_t {
+		// includes elements still being linked by producers: pop() stops at those.
+		auto const count = m_depth.load(std::memory_order_acquire);
+		auto ret = std::size_t{};
+		auto value = Type{};
+		while (ret < count && pop(value)) {
+			func(std::move(value));
+			++ret;
+		}
+		return ret;
+	}
+
+	[[nodiscard]] auto get_stats() const -> QueueStats {
+		return QueueStats{
+			.pushed = m_pushed.load(std::memory_order_relaxed),
+			.peak_depth = m_peak_depth.load(std::memory_order_relaxed),
+		};
+	}
+
+  private:
+	struct Node {
+		std::atomic<Node*> next{};
+		Type value{};
+	};
+
+	void update_peak(std::uint64_t const depth) {
+		auto peak = m_peak_depth.load(std::memory_order_relaxed);
+		while (depth > peak && !m_peak_depth.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {}
+	}
+
+	alignas(detail::cache_line_v) std::atomic<Node*> m_head;
+	alignas(detail::cache_line_v) Node* m_tail;
+	alignas(detail::cache_line_v) std::atomic<std::uint64_t> m_depth{};
+	std::atomic<std::uint64_t> m_pushed{};
+	std::atomic<std::uint64_t> m_peak_depth{};
+};
+
+/// \brief Bounded lock-free multi-producer single-consumer queue.
+/// Capacity is rounded up to a power of two, try_push() fails (and counts a rejection) when full.
+template <typename Type>
+class BoundedMpscQueue {
+  public:
+	BoundedMpscQueue(BoundedMpscQueue const&) = delete;
+	BoundedMpscQueue(BoundedMpscQueue&&) = delete;
+	auto operator=(BoundedMpscQueue const&) = delete;
+	auto operator=(BoundedMpscQueue&&) = delete;
+
+	~BoundedMpscQueue() = default;
+
+	explicit BoundedMpscQueue(std::size_t const capacity)
+		: m_capacity(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)), m_cells(std::make_unique<Cell[]>(m_capacity)) {
+		for (std::size_t i = 0; i < m_capacity; ++i) { m_cells[i].sequence.store(i, std::memory_order_relaxed); }
+	}
+
+	[[nodiscard]] auto try_push(Type value) -> bool {
+		auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+		auto* cell = static_cast<Cell*>(nullptr);
+		while (true) {
+			cell = &m_cells[pos & (m_capacity - 1)];
+			auto const sequence = cell->sequence.load(std::memory_order_acquire);
+			auto const diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+			if (diff == 0) {
+				if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+			} else if (diff < 0) {
+				m_rejected.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			} else {
+				pos = m_enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->value = std::move(value);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		m_pushed.fetch_add(1, std::memory_order_relaxed);
+		// the consumer may already be past pos if other producers have been drained meanwhile.
+		auto const dequeue_pos = m_dequeue_pos.load(std::memory_order_relaxed);
+		if (dequeue_pos <= pos) { update_peak(pos + 1 - dequeue_pos); }
+		return true;
+	}
+
+	[[nodiscard]] auto pop(Type& out) -> bool {
+		auto const pos = m_dequeue_pos.load(std::memory_order_relaxed);
+		auto& cell = m_cells[pos & (m_capacity - 1)];
+		auto const sequence = cell.sequence.load(std::memory_order_acquire);
+		if (sequence != pos + 1) { return false; }
+		out = std::move(cell.value);
+		cell.value = Type{};
+		m_dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+		cell.sequence.store(pos + m_capacity, std::memory_order_release);
+		return true;
+	}
+
+	/// \brief Pop and invoke func on each element present at the time of the call.
+	/// Elements pushed meanwhile (eg by func) are left for the next call.
+	/// \returns Number of elements drained.
+	template <typename Func>
+	auto drain(Func func) -> std::size_t {
+		// includes cells still being written by producers: pop() stops at those.
+		auto const count = m_enqueue_pos.load(std::memory_order_relaxed) - m_dequeue_pos.load(std::memory_order_relaxed);
+		auto ret = std::size_t{};
+		auto value = Type{};
+		while (ret < count && pop(value)) {
+			func(std::move(value));
+			++ret;
+		}
+		return ret;
+	}
+
+	[[nodiscard]] auto get_capacity() const -> std::size_t { return m_capacity; }
+
+	[[nodiscard]] auto get_stats() const -> QueueStats {
+		return QueueStats{
+			.pushed = m_pushed.load(std::memory_order_relaxed),
+			.rejected = m_rejected.load(std::memory_order_relaxed),
+			.peak_depth = m_peak_depth.load(std::memory_order_relaxed),
+		};
+	}
+
+  private:
+	struct Cell {
+		std::atomic<std::size_t> sequence{};
+		Type value{};
+	};
+
+	void update_peak(std::uint64_t const depth) {
+		auto peak = m_peak_depth.load(std::memory_order_relaxed);
+		while (depth > peak && !m_peak_depth.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {}
+	}
+
+	std::size_t m_capacity;
+	std::unique_ptr<Cell[]> m_cells;
+
+	alignas(detail::cache_line_v) std::atomic<std::size_t> m_enqueue_pos{};
+	alignas(detail::cache_line_v) std::atomic<std::size_t> m_dequeue_pos{};
+	alignas(detail::cache_line_v) std::atomic<std::uint64_t> m_pushed{};
+	std::atomic<std::uint64_t> m_rejected{};
+	std::atomic<std::uint64_t> m_peak_depth{};
+};
+} // namespace gvdi
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace gvdi {
+/// \brief Backend for Dear ImGui heap allocations.
+enum class ImGuiAllocator : std::int8_t {
+	/// \brief Global heap (malloc / free), with telemetry.
+	Heap,
+	/// \brief Size-class pools owned by the App, with telemetry.
+	/// Avoids contending with worker threads on the global heap, and fragmenting it.
+	Pooled,
+};
+
+/// \brief Library options, queried during stage_create().
+struct Options {
+	ImGuiAllocator imgui_allocator{ImGuiAllocator::Heap};
+	/// \brief Upload Dear ImGui geometry through a persistently mapped, per-frame partitioned ring buffer.
+	/// If false, the Vulkan backend's own (re)allocating and per-frame mapped buffers are used.
+	bool imgui_ring_buffer{true};
+	/// \brief Merge adjacent Dear ImGui draw commands (across draw lists) that use the same texture,
+	/// if their clip rects are equal or none of their vertices lie outside them.
+	/// Indices are rebased while uploading so that draw lists share vertex offsets. Ignored if imgui_ring_buffer is false.
+	bool imgui_batching{true};
+	/// \brief Worker threads recording secondary command buffers, 0 records everything on the main thread.
+	/// If non-zero, RenderTarget record callbacks are invoked concurrently on worker threads (and executed in submission order).
+	/// Such callbacks must be thread-safe, and must not call RenderTarget::render().
+	std::uint32_t recording_threads{};
+	/// \brief Minimum number of Dear ImGui draw commands in a frame to split its recording (by draw list) across worker threads.
+	/// 0 disables, ignored if recording_threads is 0 or imgui_ring_buffer is false.
+	/// Frames containing user draw callbacks are always recorded on the main thread.
+	std::uint32_t parallel_imgui_commands{};
+	/// \brief Enable Dear ImGui multi-viewports: windows moved outside the main window get their own platform (GLFW) windows.
+	/// Each gets its own surface and swapchain, sharing the instance, device, queue, pipelines and descriptor pools of the main window,
+	/// and all windows are submitted and presented together once per frame.
+	/// Requires imgui_ring_buffer, and a Dear ImGui build with viewports (docking branch, see GVDI_DEAR_IMGUI_DIR): ignored otherwise.
+	bool imgui_viewports{};
+	/// \brief Stream the main viewport's UI to a RemoteViewer connecting to this address ("host:port", or "unix:path"), empty disables.
+	/// An empty host (":port") listens on 127.0.0.1 only: other interfaces must be explicit (eg "0.0.0.0:port", or "[::]:port").
+	/// Only draw lists that changed since the previous frame sent are sent in full, and frames are LZ4 compressed;
+	/// a frame is skipped while the previous one is still being sent. The viewer's input is fed back to Dear ImGui and the EventListener.
+	/// While a viewer is connected, textures (except render targets) are mirrored on the CPU: existing ones are read back on connection.
+	/// Viewers are disconnected by stage_destroy() (and thus reboots).
+	/// For headless nodes, combine with GLFW's null platform (glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL)).
+	std::string remote_address{};
+};
+} // namespace gvdi
@@ -0,0 +1,101 @@
+#pragma once
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace gvdi {
+/// \brief Minimum and maximum of a range of samples, empty if max < min.
+struct MinMax {
+	float min{std::numeric_limits<float>::max()};
+	float max{std::numeric_limits<float>::lowest()};
+
+	[[nodiscard]] auto is_empty() const -> bool { return max < min; }
+
+	// NaNs are ignored.
+	void add(float const value) {
+		min = value < min ? value : min;
+		max = value > max ? value : max;
+	}
+
+	void add(MinMax const& rhs) {
+		min = rhs.min < min ? rhs.min : min;
+		max = rhs.max > max ? rhs.max : max;
+	}
+};
+
+/// \brief Append-only series of uniformly spaced samples, with a min/max pyramid for decimation.
+/// Appends cost amortized O(1) per sample, range queries cost O(log N): drawing does not depend on the number of samples.
+/// Not thread-safe: use App::post() to append samples produced on other threads.
+class PlotSeries {
+  public:
+	/// \brief Samples per block in the first level of the pyramid.
+	static constexpr std::size_t block_size_v{32};
+
+	void append(std::span<float const> samples);
+	void append(float const sample) { append(std::span{&sample, 1}); }
+	void clear();
+
+	[[nodiscard]] auto get_samples() const -> std::span<float const> { return m_samples; }
+	[[nodiscard]] auto size() const -> std::size_t { return m_samples.size(); }
+	[[nodiscard]] auto is_empty() const -> bool { return m_samples.empty(); }
+
+	/// \returns Minimum and maximum of samples in [first, last), clamped to the series.
+	[[nodiscard]] auto get_min_max(std::size_t first, std::size_t last) const -> MinMax;
+	/// \brief Split [first, last) (in samples) into out.size() equal columns, and write the minimum and maximum of each to out.
+	/// Each column also includes the first sample of the next one, so that adjacent columns connect.
+	void decimate(double first, double last, std::span<MinMax> out) const;
+
+  private:
+	std::vector<float> m_samples{};
+	// level k holds the min/max of blocks of (block_size_v << k) samples.
+	std::vector<std::vector<MinMax>> m_levels{};
+};
+
+enum class PlotKind : std::int8_t { Line, Scatter };
+
+struct PlotStyle {
+	ImU32 color{IM_COL32(80, 170, 255, 255)};
+	float thickness{1.0f};
+	PlotKind kind{PlotKind::Line};
+};
+
+/// \brief Interactive plot of PlotSeries inside a Dear ImGui child region.
+/// Zoomed out, each series is drawn as one min/max bar per pixel column: geometry is bounded by the width of the region.
+/// Mouse wheel zooms the x axis around the cursor, dragging pans, double click fits all samples.
+/// While the view contains the newest sample it follows appended samples.
+class Plot {
+  public:
+	struct Entry {
+		PlotSeries const* series{};
+		PlotStyle style{};
+	};
+
+	/// \param size Size of the child region, 0 uses the available content region.
+	/// \returns false if the child region is not visible.
+	auto draw(char const* label, std::span<Entry const> entries, ImVec2 size = {}) -> bool;
+
+	/// \brief Fit all samples (of all entries), growing the view as samples are appended.
+	void fit() { m_fit_all = true; }
+
+	/// \brief Fit the y axis to the visible samples every frame.
+	bool auto_fit_y{true};
+	/// \brief Y range when auto_fit_y is false.
+	float y_min{0.0f};
+	float y_max{1.0f};
+
+  private:
+	void update_view(std::size_t sample_count, ImVec2 pos, ImVec2 extent);
+	void update_y_range(std::span<Entry const> entries);
+	void draw_entry(ImDrawList& draw_list, Entry const& entry, ImVec2 pos, ImVec2 extent);
+
+	double m_first{};
+	double m_last{};
+	bool m_fit_all{true};
+	bool m_follow{};
+	std::vector<MinMax> m_columns{};
+	std::vector<ImVec2> m_points{};
+};
+} // namespace gvdi
@@ -0,0 +1,72 @@
+#pragma once
+#include "gvdi/event_listener.hpp"
+#include <imgui.h>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace gvdi {
+class App;
+
+/// \brief Counters for remote UI streaming: an App streaming its UI (Options::remote_address), or a RemoteViewer.
+struct RemoteStats {
+	bool connected{};
+	std::uint64_t connections{};
+	/// \brief Frames sent (App) or drawn (RemoteViewer).
+	std::uint64_t frames{};
+	/// \brief Frames not sent because the previous one was still being sent (App),
+	/// or replaced by a newer one before being drawn (RemoteViewer).
+	std::uint64_t frames_skipped{};
+	/// \brief Draw lists sent in full.
+	std::uint64_t lists{};
+	/// \brief Draw lists identical to one in the previous frame, sent as a hash.
+	std::uint64_t lists_reused{};
+	std::uint64_t textures{};
+	/// \brief Input events received (App) or sent (RemoteViewer).
+	std::uint64_t events{};
+	/// \brief Frame bytes before compression.
+	std::uint64_t raw_bytes{};
+	/// \brief Frame bytes on the wire.
+	std::uint64_t wire_bytes{};
+};
+
+/// \brief Thin client of an App streaming its UI (see Options::remote_address): draws the received frames,
+/// and forwards input (as EventListener callbacks) back to it, where they are fed to Dear ImGui and the App's EventListener.
+/// Frames are received, decompressed and decoded on a worker thread, only the latest one is drawn.
+/// Textures are recreated locally (via App::create_texture()), those the server does not mirror are drawn as grey.
+/// Coordinates are scaled between the App's display and the viewer's window, if their sizes differ.
+/// Forward the viewer App's EventListener callbacks to this instance, starting with on_window_resize().
+class RemoteViewer : public EventListener {
+  public:
+	/// \brief Connect to address ("host:port", an empty host is 127.0.0.1; or "unix:path").
+	/// Throws on failure, or if the server is incompatible (other gvdi version or Dear ImGui vertex / index types).
+	/// app must outlive this instance, and be past stage_create() (textures are created through it).
+	explicit RemoteViewer(App& app, std::string_view address);
+
+	/// \brief Draw the latest received frame into draw_list (eg ImGui::GetBackgroundDrawList()), over the region [origin, origin + size].
+	/// \returns false if disconnected.
+	auto draw(ImDrawList& draw_list, ImVec2 origin, ImVec2 size) -> bool;
+
+	[[nodiscard]] auto is_connected() const -> bool;
+	[[nodiscard]] auto get_stats() const -> RemoteStats;
+
+	void on_window_resize(int x, int y) final;
+	void on_window_focus(bool focused) final;
+	void on_key_press(int key, int scancode, int mods) final;
+	void on_key_release(int key, int scancode, int mods) final;
+	void on_key_repeat(int key, int scancode, int mods) final;
+	void on_character(std::uint32_t codepoint) final;
+	void on_cursor_reposition(double x, double y) final;
+	void on_cursor_enter(bool entered) final;
+	void on_mouse_button_press(int button, int mods) final;
+	void on_mouse_button_release(int button, int mods) final;
+	void on_mouse_scroll(double x, double y) final;
+
+  private:
+	class Impl;
+	struct Deleter {
+		void operator()(Impl* ptr) const noexcept;
+	};
+	std::unique_ptr<Impl, Deleter> m_impl{};
+};
+} // namespace gvdi
@@ -0,0 +1,55 @@
+#pragma once
+#include "gvdi/texture.hpp"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+
+namespace gvdi {
+/// \brief Vulkan handles owned by gvdi, for creating custom pipelines / resources.
+/// vulkan.hpp's default dispatcher is initialized by gvdi and can be used directly.
+/// Invalidated by App::stage_destroy() (and thus reboots).
+struct VulkanHandles {
+	VkInstance instance{};
+	VkPhysicalDevice physical_device{};
+	VkDevice device{};
+	VkQueue queue{};
+	std::uint32_t queue_family{};
+	PFN_vkGetInstanceProcAddr get_instance_proc_addr{};
+};
+
+/// \brief Parameters for App::create_render_target().
+struct RenderTargetCreateInfo {
+	int width{};
+	int height{};
+	/// \brief Attach a depth buffer, cleared to 1 on every render and not preserved.
+	bool depth{};
+};
+
+/// \brief State passed to RenderTarget::Record callbacks.
+/// The render pass has begun (inline contents) and viewport / scissor are set to cover the whole target.
+struct OffscreenPass {
+	VkCommandBuffer command_buffer{};
+	VkRenderPass render_pass{};
+	VkExtent2D extent{};
+};
+
+/// \brief Offscreen R8G8B8A8 color target, usable as an ImTextureID in the same frame it is rendered to.
+/// Renders are recorded into the frame's command buffer before the ImGui pass,
+/// the render pass transitions the target to SHADER_READ_ONLY_OPTIMAL for sampling by ImGui.
+class RenderTarget : public Texture {
+  public:
+	using Record = std::function<void(OffscreenPass const&)>;
+
+	using Texture::Texture;
+
+	/// \brief Enqueue a render for the current frame: clear and then invoke record (if any).
+	/// Renders are recorded in submission order, each one overwrites the previous contents.
+	/// No-op if the target is not valid.
+	void render(ImVec4 const& clear, Record record = {}) const;
+
+	/// \returns Render pass compatible with this target (for pipeline creation), null if not valid.
+	[[nodiscard]] auto get_render_pass() const -> VkRenderPass;
+	/// \returns Depth attachment format, VK_FORMAT_UNDEFINED if the target has no depth buffer.
+	[[nodiscard]] auto get_depth_format() const -> VkFormat;
+};
+} // namespace gvdi
@@ -0,0 +1,58 @@
+#pragma once
+#include <GLFW/glfw3.h>
+#include <imgui.h>
+#include <cstdint>
+#include <memory>
+
+namespace gvdi {
+namespace detail {
+class WindowStore;
+} // namespace detail
+
+/// \brief Parameters for App::create_secondary_window().
+struct SecondaryWindowCreateInfo {
+	char const* title{"gvdi"};
+	int width{800};
+	int height{600};
+};
+
+/// \brief Additional GLFW window presented alongside the App's main window.
+/// It has its own surface and swapchain, and shares the device, queue, pipelines and textures of the main window:
+/// all windows are submitted and presented together, once per frame.
+/// Its contents are the primitives added to get_draw_list() during App::update().
+/// Input is not routed to Dear ImGui or the App's EventListener: use get_glfw_window() instead.
+/// Owned by the App's renderer: invalidated by App::stage_destroy() (and thus reboots).
+class SecondaryWindow {
+  public:
+	SecondaryWindow() = default;
+
+	explicit SecondaryWindow(std::shared_ptr<detail::WindowStore> const& store, std::uint32_t handle);
+
+	SecondaryWindow(SecondaryWindow const&) = delete;
+	auto operator=(SecondaryWindow const&) = delete;
+
+	SecondaryWindow(SecondaryWindow&& rhs) noexcept;
+	auto operator=(SecondaryWindow&& rhs) noexcept -> SecondaryWindow&;
+
+	~SecondaryWindow();
+
+	/// \returns Pointer to GLFW window, null if not valid.
+	[[nodiscard]] auto get_glfw_window() const -> GLFWwindow*;
+	/// \brief Draw list rendered into this window, in window coordinates (pixels at a framebuffer scale of 1).
+	/// Cleared at the start of every frame, usable from App::update(). Throws if not valid.
+	[[nodiscard]] auto get_draw_list() const -> ImDrawList&;
+	/// \returns true if closing the window was requested (it remains open until destroyed).
+	[[nodiscard]] auto should_close() const -> bool;
+
+	/// \returns false if default constructed, moved from, or if the owning renderer has been destroyed.
+	[[nodiscard]] auto is_valid() const -> bool { return !m_store.expired(); }
+	explicit operator bool() const { return is_valid(); }
+
+  private:
+	void swap(SecondaryWindow& rhs) noexcept;
+	void release();
+
+	std::weak_ptr<detail::WindowStore> m_store{};
+	std::uint32_t m_handle{};
+};
+} // namespace gvdi
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gvdi {
+/// \brief Dear ImGui allocation telemetry.
+struct AllocStats {
+	/// \brief Number of histogram buckets: powers of two from 16 to 4096 bytes, and larger.
+	static constexpr std::size_t size_classes_v{10};
+
+	/// \returns Upper bound (inclusive) of the histogram bucket at index, 0 for the last (unbounded) bucket.
+	[[nodiscard]] static constexpr auto get_size_class_limit(std::size_t const index) -> std::size_t {
+		if (index + 1 >= size_classes_v) { return 0; }
+		return std::size_t{16} << index;
+	}
+
+	/// \brief Allocations during the last completed frame.
+	std::uint64_t frame_allocations{};
+	/// \brief Bytes allocated during the last completed frame.
+	std::uint64_t frame_bytes{};
+
+	std::uint64_t total_allocations{};
+	std::uint64_t total_frees{};
+	/// \brief Bytes currently allocated.
+	std::uint64_t live_bytes{};
+	/// \brief Highest value of live_bytes observed.
+	std::uint64_t peak_live_bytes{};
+	/// \brief Bytes reserved from the global heap by pools (Pooled backend only).
+	std::uint64_t pool_reserved_bytes{};
+
+	/// \brief Number of allocations (since App construction) per size class.
+	std::array<std::uint64_t, size_classes_v> histogram{};
+};
+
+/// \brief Renderer telemetry.
+struct FrameStats {
+	/// \brief Number of frames rendered by the current renderer.
+	std::uint64_t frame_index{};
+	/// \brief Vulkan objects created during the last completed frame: create / allocate calls of gvdi, the Dear ImGui backend
+	/// and users of the default vulkan.hpp dispatcher (eg in RenderTarget callbacks), counted at the dispatcher.
+	std::uint32_t vk_objects_created{};
+	std::uint64_t total_vk_objects_created{};
+	std::uint64_t swapchain_recreations{};
+	/// \brief Dear ImGui draw commands in the last completed frame, across all windows.
+	/// Those of the main window are only counted if Options::imgui_ring_buffer is true.
+	std::uint32_t imgui_commands{};
+	/// \brief Draw calls recorded for them, fewer than imgui_commands if Options::imgui_batching merged some.
+	std::uint32_t imgui_draws{};
+	/// \brief Windows presented in the last completed frame: the main window, SecondaryWindows,
+	/// and Dear ImGui platform windows (Options::imgui_viewports).
+	std::uint32_t windows{};
+};
+} // namespace gvdi
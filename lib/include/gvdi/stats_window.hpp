@@ -0,0 +1,9 @@
+#pragma once
+
+namespace gvdi {
+class App;
+
+/// \brief Draw a Dear ImGui window with frame, allocation, post queue, remote streaming and GPU memory telemetry of app.
+/// Must be called between Dear ImGui frame begin and end (ie, in App::update()).
+void show_stats_window(App const& app, bool* open = nullptr);
+} // namespace gvdi
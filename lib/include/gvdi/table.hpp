@@ -0,0 +1,108 @@
+#pragma once
+#include <imgui.h>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace gvdi {
+/// \brief Column of a TableSource.
+struct TableColumn {
+	std::string name{};
+	/// \brief Initial width in pixels, 0 stretches the column to share the remaining width.
+	float width{};
+	bool sortable{true};
+};
+
+/// \brief Columnar source of rows for Table, pulled a column at a time for the visible rows only.
+/// Called from the UI thread (format()) and from Table's worker threads (all functions) concurrently: must be thread-safe.
+class TableSource {
+  public:
+	TableSource() = default;
+	TableSource(TableSource const&) = delete;
+	TableSource(TableSource&&) = delete;
+	auto operator=(TableSource const&) = delete;
+	auto operator=(TableSource&&) = delete;
+
+	virtual ~TableSource() = default;
+
+	/// \brief May grow between frames (eg, appended log lines), existing rows must keep their indices.
+	[[nodiscard]] virtual auto get_row_count() const -> std::size_t = 0;
+	/// \brief Must not change after the source is passed to a Table.
+	[[nodiscard]] virtual auto get_columns() const -> std::span<TableColumn const> = 0;
+
+	/// \brief Write the text of the cells of column in rows to out (out.size() == rows.size(), each initially empty).
+	virtual void format(std::size_t column, std::span<std::size_t const> rows, std::span<std::string> out) const = 0;
+
+	/// \brief Order of the cells of column in rows lhs and rhs, for sorting.
+	/// Defaults to comparing formatted text: override for numeric / typed columns (and speed).
+	[[nodiscard]] virtual auto compare(std::size_t column, std::size_t lhs, std::size_t rhs) const -> std::weak_ordering;
+	/// \brief Whether row passes filter (never empty).
+	/// Defaults to a case insensitive (ASCII) search for filter in the formatted text of each column.
+	[[nodiscard]] virtual auto matches(std::size_t row, std::string_view filter) const -> bool;
+};
+
+/// \brief Parameters for Table.
+struct TableCreateInfo {
+	std::shared_ptr<TableSource const> source{};
+	/// \brief Threads sorting and filtering rows (one of which coordinates), 0 uses the hardware concurrency.
+	std::uint32_t sort_threads{2};
+	/// \brief Rows whose formatted text is kept across frames (visible rows are never evicted).
+	std::uint32_t cached_rows{4096};
+	/// \brief Draw a filter text box above the table, otherwise use Table::set_filter().
+	bool filter_input{true};
+};
+
+/// \brief Counters for a Table.
+struct TableStats {
+	/// \brief Rows in the source.
+	std::size_t rows{};
+	/// \brief Rows in the current (sorted and filtered) view.
+	std::size_t view_rows{};
+	std::uint32_t cached_rows{};
+	std::uint64_t total_formatted{};
+	/// \brief Whether a sorted / filtered view is being computed (the previous one is drawn meanwhile).
+	bool sorting{};
+};
+
+/// \brief Virtualized table of a TableSource, inside a Dear ImGui child region.
+/// Only the visible rows are formatted (and cached across frames): draw() does not depend on the number of rows.
+/// Scrolling is tracked as a row index rather than in pixels, which stays exact for tens of millions of rows.
+/// Sorting (click headers, shift click for multiple columns) and filtering compute a permutation of row indices on worker threads.
+/// While the view is scrolled to the last row it follows appended rows.
+/// At most 2^32 - 1 rows are shown.
+class Table {
+  public:
+	Table() = default;
+
+	/// \brief Throws if source is null or has no columns.
+	explicit Table(TableCreateInfo const& create_info);
+
+	/// \param size Size of the child region, 0 uses the available content region.
+	/// \returns false if the child region is not visible, or if not valid.
+	/// Rethrows the first exception thrown by TableSource on a worker thread.
+	auto draw(char const* label, ImVec2 size = {}) -> bool;
+
+	void set_filter(std::string_view filter);
+	[[nodiscard]] auto get_filter() const -> std::string_view;
+
+	/// \brief Discard cached text and recompute the view: call when existing rows of the source have changed.
+	void refresh();
+
+	[[nodiscard]] auto get_stats() const -> TableStats;
+
+	/// \returns false if default constructed or moved from.
+	[[nodiscard]] auto is_valid() const -> bool { return m_impl != nullptr; }
+	explicit operator bool() const { return is_valid(); }
+
+  private:
+	class Impl;
+	struct Deleter {
+		void operator()(Impl* ptr) const noexcept;
+	};
+	std::unique_ptr<Impl, Deleter> m_impl{};
+};
+} // namespace gvdi
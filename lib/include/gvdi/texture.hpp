@@ -0,0 +1,57 @@
+#pragma once
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace gvdi {
+namespace detail {
+class TextureStore;
+} // namespace detail
+
+/// \brief View into tightly packed RGBA8 pixels, row-major starting from the top-left.
+struct Bitmap {
+	std::span<std::byte const> bytes{};
+	int width{};
+	int height{};
+};
+
+/// \brief GPU texture usable as an ImTextureID.
+/// Owned by the App's renderer: invalidated by App::stage_destroy() (and thus reboots).
+/// Destruction is deferred until the GPU has finished using it.
+class Texture {
+  public:
+	Texture() = default;
+
+	explicit Texture(std::shared_ptr<detail::TextureStore> const& store, std::uint32_t handle);
+
+	Texture(Texture const&) = delete;
+	auto operator=(Texture const&) = delete;
+
+	Texture(Texture&& rhs) noexcept;
+	auto operator=(Texture&& rhs) noexcept -> Texture&;
+
+	~Texture();
+
+	[[nodiscard]] auto get_id() const -> ImTextureID { return m_id; }
+	[[nodiscard]] auto get_size() const -> ImVec2 { return m_size; }
+
+	/// \returns false if default constructed, moved from, or if the owning renderer has been destroyed.
+	[[nodiscard]] auto is_valid() const -> bool { return !m_store.expired(); }
+	explicit operator bool() const { return is_valid(); }
+
+  protected:
+	[[nodiscard]] auto get_store() const -> std::shared_ptr<detail::TextureStore> { return m_store.lock(); }
+	[[nodiscard]] auto get_handle() const -> std::uint32_t { return m_handle; }
+
+  private:
+	void swap(Texture& rhs) noexcept;
+	void release();
+
+	std::weak_ptr<detail::TextureStore> m_store{};
+	std::uint32_t m_handle{};
+	ImTextureID m_id{};
+	ImVec2 m_size{};
+};
+} // namespace gvdi
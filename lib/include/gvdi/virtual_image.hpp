@@ -0,0 +1,121 @@
+#pragma once
+#include "gvdi/texture.hpp"
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace gvdi {
+namespace detail {
+class MappedFile;
+} // namespace detail
+
+/// \brief Rect of pixels in a mip level of an ImageSource.
+/// Level k is the image downsampled by 2^k, ie (width + 2^k - 1) >> k by (height + 2^k - 1) >> k pixels.
+struct ImageRegion {
+	std::uint32_t level{};
+	int x{};
+	int y{};
+	int width{};
+	int height{};
+};
+
+/// \brief Source of pixels for VirtualImage, read from its worker threads.
+class ImageSource {
+  public:
+	ImageSource() = default;
+	ImageSource(ImageSource const&) = delete;
+	ImageSource(ImageSource&&) = delete;
+	auto operator=(ImageSource const&) = delete;
+	auto operator=(ImageSource&&) = delete;
+
+	virtual ~ImageSource() = default;
+
+	[[nodiscard]] virtual auto get_width() const -> int = 0;
+	[[nodiscard]] virtual auto get_height() const -> int = 0;
+
+	/// \brief Write the pixels of region as tightly packed RGBA8 (region.width * region.height * 4 bytes) to out.
+	/// region lies within its level. Called concurrently from worker threads: must be thread-safe.
+	virtual void read(ImageRegion const& region, std::span<std::byte> out) const = 0;
+};
+
+/// \brief Memory mapped file of raw, tightly packed RGBA8 pixels (row-major starting from the top-left).
+/// Only the pages touched by visible tiles are read, downsampled levels sample 2x2 pixels per texel.
+class MappedImage : public ImageSource {
+  public:
+	/// \param offset Bytes to skip at the start of the file (eg, a header).
+	/// Throws if the file cannot be mapped or is too small.
+	explicit MappedImage(char const* path, int width, int height, std::size_t offset = 0);
+	~MappedImage() override;
+
+	[[nodiscard]] auto get_width() const -> int final { return m_bitmap.width; }
+	[[nodiscard]] auto get_height() const -> int final { return m_bitmap.height; }
+
+	void read(ImageRegion const& region, std::span<std::byte> out) const final;
+
+  private:
+	std::unique_ptr<detail::MappedFile> m_file;
+	Bitmap m_bitmap{};
+};
+
+/// \brief Parameters for App::create_virtual_image().
+struct VirtualImageCreateInfo {
+	std::shared_ptr<ImageSource const> source{};
+	/// \brief Tiles resident on the GPU, in atlas pages of up to 15x15 tiles (each 258x258 RGBA8, ~260 KiB).
+	std::uint32_t cache_tiles{512};
+	/// \brief Maximum tiles uploaded per frame, bounds the per-frame upload cost.
+	std::uint32_t uploads_per_frame{8};
+	/// \brief Worker threads reading tiles from the source.
+	std::uint32_t decode_threads{2};
+};
+
+/// \brief Counters for a VirtualImage.
+struct VirtualImageStats {
+	std::uint32_t resident_tiles{};
+	/// \brief Tiles requested by the last draw() and not yet resident.
+	std::uint32_t pending_tiles{};
+	std::uint64_t total_uploads{};
+	/// \brief Mip level drawn by the last draw().
+	std::uint32_t level{};
+	std::uint32_t level_count{};
+};
+
+/// \brief Viewer for images much larger than GPU limits / memory, inside a Dear ImGui child region.
+/// The image is split into 256x256 tiles in a mip pyramid (down to a single tile), and only tiles visible at the current zoom
+/// are read (on worker threads) and uploaded into atlas pages, evicting the least recently drawn tiles.
+/// Tiles not yet resident are drawn from their nearest resident ancestor.
+/// Mouse wheel zooms around the cursor, dragging pans, double click fits the whole image.
+/// Owned by the App's renderer: invalidated by App::stage_destroy() (and thus reboots).
+class VirtualImage {
+  public:
+	/// \brief Tile contents, each tile is stored with a 1 pixel border (for filtering across tiles).
+	static constexpr int tile_size_v{256};
+
+	VirtualImage() = default;
+
+	explicit VirtualImage(std::shared_ptr<detail::TextureStore> const& store, VirtualImageCreateInfo const& create_info);
+
+	/// \param size Size of the child region, 0 uses the available content region.
+	/// \returns false if the child region is not visible, or if not valid.
+	/// Rethrows the first exception thrown by ImageSource::read().
+	auto draw(char const* label, ImVec2 size = {}) -> bool;
+
+	/// \brief Fit the whole image into the region on the next draw().
+	void fit();
+
+	[[nodiscard]] auto get_image_size() const -> ImVec2;
+	[[nodiscard]] auto get_stats() const -> VirtualImageStats;
+
+	/// \returns false if default constructed, moved from, or if the owning renderer has been destroyed.
+	[[nodiscard]] auto is_valid() const -> bool;
+	explicit operator bool() const { return is_valid(); }
+
+  private:
+	class Impl;
+	struct Deleter {
+		void operator()(Impl* ptr) const noexcept;
+	};
+	std::unique_ptr<Impl, Deleter> m_impl{};
+};
+} // namespace gvdi
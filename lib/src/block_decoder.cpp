@@ -0,0 +1,283 @@
+#include "gvdi/compressed_bitmap.hpp"
+#include "gvdi/exception.hpp"
+#include <algorithm>
+#include <array>
+#include <format>
+
+namespace gvdi {
+namespace {
+using Rgba = std::array<std::uint8_t, 4>;
+// decoded block, row-major.
+using Texels = std::array<Rgba, 16>;
+
+constexpr auto clamp_u8(int const value) -> std::uint8_t { return static_cast<std::uint8_t>(std::clamp(value, 0, 255)); }
+
+constexpr auto load_le(std::span<std::byte const> const bytes, std::size_t const count) -> std::uint64_t {
+	auto ret = std::uint64_t{};
+	for (std::size_t i = 0; i < count; ++i) { ret |= std::uint64_t(bytes[i]) << (8 * i); }
+	return ret;
+}
+
+constexpr auto load_be(std::span<std::byte const> const bytes, std::size_t const count) -> std::uint64_t {
+	auto ret = std::uint64_t{};
+	for (std::size_t i = 0; i < count; ++i) { ret = (ret << 8) | std::uint64_t(bytes[i]); }
+	return ret;
+}
+
+constexpr auto bits(std::uint64_t const value, int const high, int const low) -> int {
+	return static_cast<int>((value >> low) & ((std::uint64_t{1} << (high - low + 1)) - 1));
+}
+
+constexpr auto expand_565(int const color) -> Rgba {
+	auto const r = bits(std::uint64_t(color), 15, 11);
+	auto const g = bits(std::uint64_t(color), 10, 5);
+	auto const b = bits(std::uint64_t(color), 4, 0);
+	return Rgba{std::uint8_t((r << 3) | (r >> 2)), std::uint8_t((g << 2) | (g >> 4)), std::uint8_t((b << 3) | (b >> 2)), 255};
+}
+
+constexpr auto mix(Rgba const& a, Rgba const& b, int const wa, int const wb) -> Rgba {
+	auto ret = Rgba{};
+	for (std::size_t c = 0; c < 3; ++c) { ret[c] = std::uint8_t(((a[c] * wa) + (b[c] * wb)) / (wa + wb)); }
+	ret[3] = 255;
+	return ret;
+}
+
+// BC1 color block, four_color forces the 4 color mode (BC2 / BC3).
+void decode_bc1(std::span<std::byte const> const block, bool const four_color, Texels& out) {
+	auto const c0 = static_cast<int>(load_le(block, 2));
+	auto const c1 = static_cast<int>(load_le(block.subspan(2), 2));
+	auto const indices = load_le(block.subspan(4), 4);
+	auto palette = std::array<Rgba, 4>{expand_565(c0), expand_565(c1)};
+	if (four_color || c0 > c1) {
+		palette[2] = mix(palette[0], palette[1], 2, 1);
+		palette[3] = mix(palette[0], palette[1], 1, 2);
+	} else {
+		palette[2] = mix(palette[0], palette[1], 1, 1);
+		palette[3] = Rgba{};
+	}
+	for (int i = 0; i < 16; ++i) { out[std::size_t(i)] = palette[std::size_t(bits(indices, (2 * i) + 1, 2 * i))]; }
+}
+
+// BC3 alpha / BC4 / BC5 channel block.
+auto decode_bc4(std::span<std::byte const> const block) -> std::array<std::uint8_t, 16> {
+	auto const a0 = static_cast<int>(block[0]);
+	auto const a1 = static_cast<int>(block[1]);
+	auto palette = std::array<int, 8>{a0, a1};
+	if (a0 > a1) {
+		for (int i = 1; i < 7; ++i) { palette[std::size_t(i + 1)] = (((7 - i) * a0) + (i * a1)) / 7; }
+	} else {
+		for (int i = 1; i < 5; ++i) { palette[std::size_t(i + 1)] = (((5 - i) * a0) + (i * a1)) / 5; }
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+	auto const indices = load_le(block.subspan(2), 6);
+	auto ret = std::array<std::uint8_t, 16>{};
+	for (int i = 0; i < 16; ++i) { ret[std::size_t(i)] = std::uint8_t(palette[std::size_t(bits(indices, (3 * i) + 2, 3 * i))]); }
+	return ret;
+}
+
+constexpr auto etc_modifiers_v = std::array<std::array<int, 4>, 8>{{
+	{2, 8, -2, -8},
+	{5, 17, -5, -17},
+	{9, 29, -9, -29},
+	{13, 42, -13, -42},
+	{18, 60, -18, -60},
+	{24, 80, -24, -80},
+	{33, 106, -33, -106},
+	{47, 183, -47, -183},
+}};
+
+constexpr auto etc_distances_v = std::array{3, 6, 11, 16, 23, 32, 41, 64};
+
+constexpr auto extend_4(int const value) -> int { return (value << 4) | value; }
+constexpr auto extend_5(int const value) -> int { return (value << 3) | (value >> 2); }
+constexpr auto extend_6(int const value) -> int { return (value << 2) | (value >> 4); }
+constexpr auto extend_7(int const value) -> int { return (value << 1) | (value >> 6); }
+
+constexpr auto offset(std::array<int, 3> const& color, int const delta) -> Rgba {
+	return Rgba{clamp_u8(color[0] + delta), clamp_u8(color[1] + delta), clamp_u8(color[2] + delta), 255};
+}
+
+// ETC2 RGB block: individual, differential, T, H, and planar modes.
+void decode_etc2(std::span<std::byte const> const block, Texels& out) {
+	auto const value = load_be(block, 8);
+	// pixel indices are column-major: index i is at (i / 4, i % 4).
+	auto const get_index = [value](int const x, int const y) {
+		auto const i = (x * 4) + y;
+		return (bits(value, 16 + i, 16 + i) << 1) | bits(value, i, i);
+	};
+	auto const set = [&out](int const x, int const y, Rgba const& color) { out[std::size_t((y * 4) + x)] = color; };
+
+	auto const flip = bits(value, 32, 32) == 1;
+	auto base = std::array<std::array<int, 3>, 2>{};
+	if (bits(value, 33, 33) == 0) {
+		for (int c = 0; c < 3; ++c) {
+			base[0][std::size_t(c)] = extend_4(bits(value, 63 - (8 * c), 60 - (8 * c)));
+			base[1][std::size_t(c)] = extend_4(bits(value, 59 - (8 * c), 56 - (8 * c)));
+		}
+	} else {
+		auto const r = bits(value, 63, 59) + (bits(value, 58, 56) ^ 4) - 4;
+		auto const g = bits(value, 55, 51) + (bits(value, 50, 48) ^ 4) - 4;
+		auto const b = bits(value, 47, 43) + (bits(value, 42, 40) ^ 4) - 4;
+		auto const paint = [&](std::array<Rgba, 4> const& colors) {
+			for (int y = 0; y < 4; ++y) {
+				for (int x = 0; x < 4; ++x) { set(x, y, colors[std::size_t(get_index(x, y))]); }
+			}
+		};
+		if (r < 0 || r > 31) {
+			// T mode.
+			auto const c0 = std::array{extend_4((bits(value, 60, 59) << 2) | bits(value, 57, 56)), extend_4(bits(value, 55, 52)),
+									   extend_4(bits(value, 51, 48))};
+			auto const c1 = std::array{extend_4(bits(value, 47, 44)), extend_4(bits(value, 43, 40)), extend_4(bits(value, 39, 36))};
+			auto const d = etc_distances_v[std::size_t((bits(value, 35, 34) << 1) | bits(value, 32, 32))];
+			paint({offset(c0, 0), offset(c1, d), offset(c1, 0), offset(c1, -d)});
+			return;
+		}
+		if (g < 0 || g > 31) {
+			// H mode.
+			auto const r0 = bits(value, 62, 59);
+			auto const g0 = (bits(value, 58, 56) << 1) | bits(value, 52, 52);
+			auto const b0 = (bits(value, 51, 51) << 3) | bits(value, 49, 47);
+			auto const r1 = bits(value, 46, 43);
+			auto const g1 = bits(value, 42, 39);
+			auto const b1 = bits(value, 38, 35);
+			auto const order = ((r0 << 8) | (g0 << 4) | b0) >= ((r1 << 8) | (g1 << 4) | b1) ? 1 : 0;
+			auto const d = etc_distances_v[std::size_t((bits(value, 34, 34) << 2) | (bits(value, 32, 32) << 1) | order)];
+			auto const c0 = std::array{extend_4(r0), extend_4(g0), extend_4(b0)};
+			auto const c1 = std::array{extend_4(r1), extend_4(g1), extend_4(b1)};
+			paint({offset(c0, d), offset(c0, -d), offset(c1, d), offset(c1, -d)});
+			return;
+		}
+		if (b < 0 || b > 31) {
+			// planar mode: origin, horizontal and vertical colors, interpolated.
+			auto const o = std::array{extend_6(bits(value, 62, 57)), extend_7((bits(value, 56, 56) << 6) | bits(value, 54, 49)),
+									  extend_6((bits(value, 48, 48) << 5) | (bits(value, 44, 43) << 3) | bits(value, 41, 39))};
+			auto const h = std::array{extend_6((bits(value, 38, 34) << 1) | bits(value, 32, 32)), extend_7(bits(value, 31, 25)),
+									  extend_6(bits(value, 24, 19))};
+			auto const v = std::array{extend_6(bits(value, 18, 13)), extend_7(bits(value, 12, 6)), extend_6(bits(value, 5, 0))};
+			for (int y = 0; y < 4; ++y) {
+				for (int x = 0; x < 4; ++x) {
+					auto color = Rgba{0, 0, 0, 255};
+					for (std::size_t c = 0; c < 3; ++c) {
+						color[c] = clamp_u8(((x * (h[c] - o[c])) + (y * (v[c] - o[c])) + (4 * o[c]) + 2) >> 2);
+					}
+					set(x, y, color);
+				}
+			}
+			return;
+		}
+		base[0] = {extend_5(bits(value, 63, 59)), extend_5(bits(value, 55, 51)), extend_5(bits(value, 47, 43))};
+		base[1] = {extend_5(r), extend_5(g), extend_5(b)};
+	}
+
+	// individual / differential: two sub-blocks (side by side, or stacked if flipped) with their own base color and table.
+	auto const tables = std::array{bits(value, 39, 37), bits(value, 36, 34)};
+	for (int y = 0; y < 4; ++y) {
+		for (int x = 0; x < 4; ++x) {
+			auto const sub = std::size_t(flip ? y / 2 : x / 2);
+			auto const modifier = etc_modifiers_v[std::size_t(tables[sub])][std::size_t(get_index(x, y))];
+			set(x, y, offset(base[sub], modifier));
+		}
+	}
+}
+
+constexpr auto eac_modifiers_v = std::array<std::array<int, 8>, 16>{{
+	{-3, -6, -9, -15, 2, 5, 8, 14},
+	{-3, -7, -10, -13, 2, 6, 9, 12},
+	{-2, -5, -8, -13, 1, 4, 7, 12},
+	{-2, -4, -6, -13, 1, 3, 5, 12},
+	{-3, -6, -8, -12, 2, 5, 7, 11},
+	{-3, -7, -9, -11, 2, 6, 8, 10},
+	{-4, -7, -8, -11, 3, 6, 7, 10},
+	{-3, -5, -8, -11, 2, 4, 7, 10},
+	{-2, -6, -8, -10, 1, 5, 7, 9},
+	{-2, -5, -8, -10, 1, 4, 7, 9},
+	{-2, -4, -8, -10, 1, 3, 7, 9},
+	{-2, -5, -7, -10, 1, 4, 6, 9},
+	{-3, -4, -7, -10, 2, 3, 6, 9},
+	{-1, -2, -3, -10, 0, 1, 2, 9},
+	{-4, -6, -8, -9, 3, 5, 7, 8},
+	{-3, -5, -7, -9, 2, 4, 6, 8},
+}};
+
+// EAC alpha block of ETC2 RGBA.
+void decode_eac(std::span<std::byte const> const block, Texels& out) {
+	auto const value = load_be(block, 8);
+	auto const base = bits(value, 63, 56);
+	auto const multiplier = bits(value, 55, 52);
+	auto const& modifiers = eac_modifiers_v[std::size_t(bits(value, 51, 48))];
+	for (int i = 0; i < 16; ++i) {
+		// column-major, most significant first.
+		auto const index = bits(value, 47 - (3 * i), 45 - (3 * i));
+		out[std::size_t(((i % 4) * 4) + (i / 4))][3] = clamp_u8(base + (modifiers[std::size_t(index)] * multiplier));
+	}
+}
+
+void decode_block(BlockFormat const format, std::span<std::byte const> const block, Texels& out) {
+	switch (format) {
+	case BlockFormat::Bc1: decode_bc1(block, false, out); break;
+	case BlockFormat::Bc2: {
+		decode_bc1(block.subspan(8), true, out);
+		auto const alpha = load_le(block, 8);
+		for (int i = 0; i < 16; ++i) { out[std::size_t(i)][3] = std::uint8_t(extend_4(bits(alpha, (4 * i) + 3, 4 * i))); }
+		break;
+	}
+	case BlockFormat::Bc3: {
+		decode_bc1(block.subspan(8), true, out);
+		auto const alpha = decode_bc4(block);
+		for (std::size_t i = 0; i < 16; ++i) { out[i][3] = alpha[i]; }
+		break;
+	}
+	case BlockFormat::Bc4: {
+		auto const red = decode_bc4(block);
+		for (std::size_t i = 0; i < 16; ++i) { out[i] = Rgba{red[i], 0, 0, 255}; }
+		break;
+	}
+	case BlockFormat::Bc5: {
+		auto const red = decode_bc4(block);
+		auto const green = decode_bc4(block.subspan(8));
+		for (std::size_t i = 0; i < 16; ++i) { out[i] = Rgba{red[i], green[i], 0, 255}; }
+		break;
+	}
+	case BlockFormat::Etc2Rgb: decode_etc2(block, out); break;
+	case BlockFormat::Etc2Rgba:
+		decode_etc2(block.subspan(8), out);
+		decode_eac(block, out);
+		break;
+	default: break;
+	}
+}
+} // namespace
+
+void decode_blocks(BlockFormat const format, std::span<std::byte const> const blocks, int const width, int const height,
+				   std::span<std::byte> const out) {
+	if (!can_decode(format)) { throw Exception{std::format("decode_blocks(): Unsupported format: {}", to_string_view(format))}; }
+	if (width <= 0 || height <= 0) { throw Exception{"decode_blocks(): Invalid size"}; }
+
+	auto const info = get_block_info(format);
+	auto const columns = (width + 3) / 4;
+	auto const rows = (height + 3) / 4;
+	auto const block_size = std::size_t(info.bytes);
+	if (blocks.size() != std::size_t(columns) * std::size_t(rows) * block_size) {
+		throw Exception{std::format("decode_blocks(): Size mismatch: expected {} bytes, got {}", std::size_t(columns) * rows * block_size,
+									blocks.size())};
+	}
+	if (out.size() != std::size_t(width) * std::size_t(height) * 4) { throw Exception{"decode_blocks(): Output size mismatch"}; }
+
+	auto texels = Texels{};
+	for (int row = 0; row < rows; ++row) {
+		for (int column = 0; column < columns; ++column) {
+			auto const block_index = (std::size_t(row) * std::size_t(columns)) + std::size_t(column);
+			decode_block(format, blocks.subspan(block_index * block_size, block_size), texels);
+			// edge blocks are cropped.
+			for (int y = 0; y < 4 && (row * 4) + y < height; ++y) {
+				for (int x = 0; x < 4 && (column * 4) + x < width; ++x) {
+					auto const pixel = (std::size_t((row * 4) + y) * std::size_t(width)) + std::size_t((column * 4) + x);
+					auto const& texel = texels[std::size_t((y * 4) + x)];
+					for (std::size_t c = 0; c < 4; ++c) { out[(pixel * 4) + c] = std::byte{texel[c]}; }
+				}
+			}
+		}
+	}
+}
+} // namespace gvdi
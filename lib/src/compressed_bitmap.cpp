@@ -0,0 +1,194 @@
+#include "gvdi/compressed_bitmap.hpp"
+#include "gvdi/exception.hpp"
+#include <vulkan/vulkan.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <optional>
+
+namespace gvdi {
+namespace {
+constexpr auto ktx2_identifier_v = std::array<std::uint8_t, 12>{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr auto dds_magic_v = std::array<std::uint8_t, 4>{'D', 'D', 'S', ' '};
+
+constexpr std::size_t ktx2_header_size_v{80};
+constexpr std::size_t ktx2_level_size_v{24};
+constexpr std::size_t dds_header_size_v{128};
+constexpr std::size_t dds_dx10_header_size_v{20};
+
+template <std::size_t N>
+auto starts_with(std::span<std::byte const> const bytes, std::array<std::uint8_t, N> const& prefix) -> bool {
+	if (bytes.size() < N) { return false; }
+	return std::ranges::equal(bytes.first(N), prefix, [](std::byte const a, std::uint8_t const b) { return a == std::byte{b}; });
+}
+
+template <typename Type>
+auto load(std::span<std::byte const> const bytes, std::size_t const offset) -> Type {
+	auto ret = Type{};
+	if (offset + sizeof(Type) > bytes.size()) { throw Exception{"parse_compressed_bitmap(): Unexpected end of file"}; }
+	std::memcpy(&ret, bytes.data() + offset, sizeof(Type));
+	return ret;
+}
+
+constexpr auto four_cc(char const (&str)[5]) -> std::uint32_t {
+	return std::uint32_t(std::uint8_t(str[0])) | (std::uint32_t(std::uint8_t(str[1])) << 8) | (std::uint32_t(std::uint8_t(str[2])) << 16) |
+		   (std::uint32_t(std::uint8_t(str[3])) << 24);
+}
+
+constexpr auto to_block_format(vk::Format const format) -> std::optional<BlockFormat> {
+	using enum vk::Format;
+	switch (format) {
+	case eBc1RgbUnormBlock:
+	case eBc1RgbSrgbBlock:
+	case eBc1RgbaUnormBlock:
+	case eBc1RgbaSrgbBlock: return BlockFormat::Bc1;
+	case eBc2UnormBlock:
+	case eBc2SrgbBlock: return BlockFormat::Bc2;
+	case eBc3UnormBlock:
+	case eBc3SrgbBlock: return BlockFormat::Bc3;
+	case eBc4UnormBlock: return BlockFormat::Bc4;
+	case eBc5UnormBlock: return BlockFormat::Bc5;
+	case eBc7UnormBlock:
+	case eBc7SrgbBlock: return BlockFormat::Bc7;
+	case eEtc2R8G8B8UnormBlock:
+	case eEtc2R8G8B8SrgbBlock: return BlockFormat::Etc2Rgb;
+	case eEtc2R8G8B8A8UnormBlock:
+	case eEtc2R8G8B8A8SrgbBlock: return BlockFormat::Etc2Rgba;
+	case eAstc4x4UnormBlock:
+	case eAstc4x4SrgbBlock: return BlockFormat::Astc4x4;
+	case eAstc6x6UnormBlock:
+	case eAstc6x6SrgbBlock: return BlockFormat::Astc6x6;
+	case eAstc8x8UnormBlock:
+	case eAstc8x8SrgbBlock: return BlockFormat::Astc8x8;
+	default: return {};
+	}
+}
+
+// DXGI_FORMAT values.
+constexpr auto to_block_format(std::uint32_t const dxgi_format) -> std::optional<BlockFormat> {
+	switch (dxgi_format) {
+	case 71:
+	case 72: return BlockFormat::Bc1;
+	case 74:
+	case 75: return BlockFormat::Bc2;
+	case 77:
+	case 78: return BlockFormat::Bc3;
+	case 80: return BlockFormat::Bc4;
+	case 83: return BlockFormat::Bc5;
+	case 98:
+	case 99: return BlockFormat::Bc7;
+	default: return {};
+	}
+}
+
+auto get_level_size(BlockFormat const format, int const width, int const height, std::uint32_t const level) -> std::size_t {
+	auto const info = get_block_info(format);
+	auto const level_width = std::max(width >> level, 1);
+	auto const level_height = std::max(height >> level, 1);
+	auto const columns = std::size_t((level_width + info.width - 1) / info.width);
+	auto const rows = std::size_t((level_height + info.height - 1) / info.height);
+	return columns * rows * std::size_t(info.bytes);
+}
+
+void validate_size(int const width, int const height) {
+	if (width <= 0 || height <= 0) { throw Exception{"parse_compressed_bitmap(): Invalid size"}; }
+}
+
+// number of levels in a full mip chain.
+auto get_max_levels(int const width, int const height) -> std::uint32_t {
+	auto ret = std::uint32_t{1};
+	for (auto extent = std::max(width, height); extent > 1; extent /= 2) { ++ret; }
+	return ret;
+}
+
+auto parse_ktx2(std::span<std::byte const> const bytes) -> CompressedBitmap {
+	auto const vk_format = load<std::uint32_t>(bytes, 12);
+	auto const width = static_cast<int>(load<std::uint32_t>(bytes, 20));
+	auto const height = static_cast<int>(load<std::uint32_t>(bytes, 24));
+	auto const depth = load<std::uint32_t>(bytes, 28);
+	auto const layers = load<std::uint32_t>(bytes, 32);
+	auto const faces = load<std::uint32_t>(bytes, 36);
+	auto const levels = std::max(load<std::uint32_t>(bytes, 40), 1u);
+	auto const supercompression = load<std::uint32_t>(bytes, 44);
+
+	validate_size(width, height);
+	if (depth > 0 || layers > 1 || faces != 1) { throw Exception{"parse_compressed_bitmap(): Only 2D KTX2 images are supported"}; }
+	if (supercompression != 0) {
+		throw Exception{std::format("parse_compressed_bitmap(): Unsupported KTX2 supercompression scheme: {}", supercompression)};
+	}
+	auto const format = to_block_format(static_cast<vk::Format>(vk_format));
+	if (!format) { throw Exception{std::format("parse_compressed_bitmap(): Unsupported KTX2 format: {}", vk_format)}; }
+	if (levels > get_max_levels(width, height)) { throw Exception{"parse_compressed_bitmap(): Invalid KTX2 level count"}; }
+
+	auto ret = CompressedBitmap{.format = *format, .width = width, .height = height};
+	for (std::uint32_t level = 0; level < levels; ++level) {
+		auto const index = ktx2_header_size_v + (level * ktx2_level_size_v);
+		auto const offset = load<std::uint64_t>(bytes, index);
+		auto const length = load<std::uint64_t>(bytes, index + 8);
+		if (offset > bytes.size() || length > bytes.size() - offset || length != get_level_size(*format, width, height, level)) {
+			throw Exception{std::format("parse_compressed_bitmap(): Invalid KTX2 level: {}", level)};
+		}
+		ret.levels.push_back(bytes.subspan(std::size_t(offset), std::size_t(length)));
+	}
+	return ret;
+}
+
+auto parse_dds(std::span<std::byte const> const bytes) -> CompressedBitmap {
+	static constexpr std::uint32_t caps2_cubemap_v{0x200};
+	static constexpr std::uint32_t caps2_volume_v{0x200000};
+
+	auto const height = static_cast<int>(load<std::uint32_t>(bytes, 12));
+	auto const width = static_cast<int>(load<std::uint32_t>(bytes, 16));
+	auto const levels = std::max(load<std::uint32_t>(bytes, 28), 1u);
+	auto const fourcc = load<std::uint32_t>(bytes, 84);
+	auto const caps2 = load<std::uint32_t>(bytes, 112);
+
+	validate_size(width, height);
+	if ((caps2 & (caps2_cubemap_v | caps2_volume_v)) != 0) {
+		throw Exception{"parse_compressed_bitmap(): Only 2D DDS images are supported"};
+	}
+
+	auto format = std::optional<BlockFormat>{};
+	auto offset = dds_header_size_v;
+	if (fourcc == four_cc("DX10")) {
+		static constexpr std::uint32_t dimension_texture2d_v{3};
+		if (load<std::uint32_t>(bytes, 132) != dimension_texture2d_v || load<std::uint32_t>(bytes, 140) > 1) {
+			throw Exception{"parse_compressed_bitmap(): Only 2D DDS images are supported"};
+		}
+		format = to_block_format(load<std::uint32_t>(bytes, 128));
+		offset += dds_dx10_header_size_v;
+	} else if (fourcc == four_cc("DXT1")) {
+		format = BlockFormat::Bc1;
+	} else if (fourcc == four_cc("DXT3")) {
+		format = BlockFormat::Bc2;
+	} else if (fourcc == four_cc("DXT5")) {
+		format = BlockFormat::Bc3;
+	} else if (fourcc == four_cc("ATI1") || fourcc == four_cc("BC4U")) {
+		format = BlockFormat::Bc4;
+	} else if (fourcc == four_cc("ATI2") || fourcc == four_cc("BC5U")) {
+		format = BlockFormat::Bc5;
+	}
+	if (!format) { throw Exception{"parse_compressed_bitmap(): Unsupported DDS format"}; }
+	if (levels > get_max_levels(width, height)) { throw Exception{"parse_compressed_bitmap(): Invalid DDS level count"}; }
+
+	// levels are stored consecutively, largest first.
+	auto ret = CompressedBitmap{.format = *format, .width = width, .height = height};
+	for (std::uint32_t level = 0; level < levels; ++level) {
+		auto const size = get_level_size(*format, width, height, level);
+		if (offset > bytes.size() || size > bytes.size() - offset) {
+			throw Exception{std::format("parse_compressed_bitmap(): Invalid DDS level: {}", level)};
+		}
+		ret.levels.push_back(bytes.subspan(offset, size));
+		offset += size;
+	}
+	return ret;
+}
+} // namespace
+
+auto parse_compressed_bitmap(std::span<std::byte const> const bytes) -> CompressedBitmap {
+	if (starts_with(bytes, ktx2_identifier_v)) { return parse_ktx2(bytes); }
+	if (starts_with(bytes, dds_magic_v)) { return parse_dds(bytes); }
+	throw Exception{"parse_compressed_bitmap(): Unrecognized file (expected KTX2 or DDS)"};
+}
+} // namespace gvdi
@@ -0,0 +1,53 @@
+#include "detail/descriptor_allocator.hpp"
+#include "gvdi/exception.hpp"
+
+namespace gvdi::detail {
+DescriptorAllocator::DescriptorAllocator(vk::Device const device) : m_device(device) {
+	// must match the backend's layout for sets to be bindable with its pipeline layout.
+	auto binding = vk::DescriptorSetLayoutBinding{};
+	binding.setBinding(0)
+		.setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+		.setDescriptorCount(1)
+		.setStageFlags(vk::ShaderStageFlagBits::eFragment);
+	auto dslci = vk::DescriptorSetLayoutCreateInfo{};
+	dslci.setBindings(binding);
+	m_layout = m_device.createDescriptorSetLayoutUnique(dslci);
+}
+
+auto DescriptorAllocator::allocate() -> vk::DescriptorSet {
+	++m_live;
+	if (!m_free.empty()) {
+		auto const ret = m_free.back();
+		m_free.pop_back();
+		return ret;
+	}
+
+	if (m_pool_remaining == 0) { add_pool(); }
+
+	auto const layout = *m_layout;
+	auto dsai = vk::DescriptorSetAllocateInfo{};
+	dsai.setDescriptorPool(*m_pools.back()).setSetLayouts(layout);
+	auto ret = vk::DescriptorSet{};
+	if (m_device.allocateDescriptorSets(&dsai, &ret) != vk::Result::eSuccess) {
+		--m_live;
+		throw Exception{"DescriptorAllocator::allocate(): Failed to allocate Vulkan Descriptor Set"};
+	}
+	--m_pool_remaining;
+	return ret;
+}
+
+void DescriptorAllocator::free(vk::DescriptorSet const set) {
+	if (!set) { return; }
+	--m_live;
+	m_free.push_back(set);
+}
+
+void DescriptorAllocator::add_pool() {
+	auto const pool_size = vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, sets_per_pool_v};
+	auto dpci = vk::DescriptorPoolCreateInfo{};
+	dpci.setMaxSets(sets_per_pool_v).setPoolSizes(pool_size);
+	m_pools.push_back(m_device.createDescriptorPoolUnique(dpci));
+	m_pool_remaining = sets_per_pool_v;
+	m_free.reserve(m_pools.size() * sets_per_pool_v);
+}
+} // namespace gvdi::detail
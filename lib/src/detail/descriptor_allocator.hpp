@@ -0,0 +1,34 @@
+#pragma once
+#include <vulkan/vulkan.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Growable allocator of combined image sampler descriptor sets, layout compatible with the Dear ImGui Vulkan backend.
+/// Adds a pool whenever existing ones are exhausted, and recycles freed sets.
+class DescriptorAllocator {
+  public:
+	static constexpr std::uint32_t sets_per_pool_v{256};
+
+	explicit DescriptorAllocator(vk::Device device);
+
+	[[nodiscard]] auto get_layout() const -> vk::DescriptorSetLayout { return *m_layout; }
+
+	[[nodiscard]] auto allocate() -> vk::DescriptorSet;
+	/// \brief Recycle a set, which must not be in use by any pending command buffer.
+	void free(vk::DescriptorSet set);
+
+	[[nodiscard]] auto get_pool_count() const -> std::size_t { return m_pools.size(); }
+	[[nodiscard]] auto get_live_count() const -> std::uint32_t { return m_live; }
+
+  private:
+	void add_pool();
+
+	vk::Device m_device;
+	vk::UniqueDescriptorSetLayout m_layout{};
+	std::vector<vk::UniqueDescriptorPool> m_pools{};
+	std::vector<vk::DescriptorSet> m_free{};
+	std::uint32_t m_pool_remaining{};
+	std::uint32_t m_live{};
+};
+} // namespace gvdi::detail
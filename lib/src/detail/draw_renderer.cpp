@@ -0,0 +1,321 @@
+#include "detail/draw_renderer.hpp"
+#include "detail/texture_id.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace gvdi::detail {
+namespace {
+constexpr auto index_type_v = sizeof(ImDrawIdx) == 2 ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
+
+auto get_framebuffer_size(ImDrawData const& draw_data) -> ImVec2 {
+	return {draw_data.DisplaySize.x * draw_data.FramebufferScale.x, draw_data.DisplaySize.y * draw_data.FramebufferScale.y};
+}
+
+auto get_scissor(ImDrawData const& draw_data, ImVec4 const& clip_rect, ImVec2 const fb_size) -> std::optional<vk::Rect2D> {
+	auto const clip_off = draw_data.DisplayPos;
+	auto const clip_scale = draw_data.FramebufferScale;
+	auto const min_x = std::max((clip_rect.x - clip_off.x) * clip_scale.x, 0.0f);
+	auto const min_y = std::max((clip_rect.y - clip_off.y) * clip_scale.y, 0.0f);
+	auto const max_x = std::min((clip_rect.z - clip_off.x) * clip_scale.x, fb_size.x);
+	auto const max_y = std::min((clip_rect.w - clip_off.y) * clip_scale.y, fb_size.y);
+	if (max_x <= min_x || max_y <= min_y) { return {}; }
+	return vk::Rect2D{
+		vk::Offset2D{static_cast<std::int32_t>(min_x), static_cast<std::int32_t>(min_y)},
+		vk::Extent2D{static_cast<std::uint32_t>(max_x - min_x), static_cast<std::uint32_t>(max_y - min_y)},
+	};
+}
+
+// true if no vertex of cmd lies outside its clip rect: the scissor can then be widened without affecting the result.
+auto is_within_clip_rect(ImDrawList const& list, ImDrawCmd const& cmd) -> bool {
+	auto const& clip = cmd.ClipRect;
+	auto const* indices = list.IdxBuffer.Data + cmd.IdxOffset;
+	auto const* vertices = list.VtxBuffer.Data + cmd.VtxOffset;
+	for (unsigned int index = 0; index < cmd.ElemCount; ++index) {
+		auto const& pos = vertices[indices[index]].pos;
+		if (pos.x < clip.x || pos.y < clip.y || pos.x > clip.z || pos.y > clip.w) { return false; }
+	}
+	return true;
+}
+
+// inclusive range of (consecutive) commands across draw lists.
+struct CommandRange {
+	int first_list{};
+	int first_cmd{};
+	int last_list{};
+	int last_cmd{};
+};
+
+auto is_within_clip_rect(ImDrawData const& draw_data, CommandRange const& range) -> bool {
+	for (int index = range.first_list; index <= range.last_list; ++index) {
+		auto const& list = *draw_data.CmdLists[index];
+		auto const first = index == range.first_list ? range.first_cmd : 0;
+		auto const last = index == range.last_list ? range.last_cmd : list.CmdBuffer.Size - 1;
+		for (int cmd = first; cmd <= last; ++cmd) {
+			if (!is_within_clip_rect(list, list.CmdBuffer[cmd])) { return false; }
+		}
+	}
+	return true;
+}
+
+constexpr auto get_union(ImVec4 const& a, ImVec4 const& b) -> ImVec4 {
+	return ImVec4{std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.z, b.z), std::max(a.w, b.w)};
+}
+
+constexpr auto is_equal(ImVec4 const& a, ImVec4 const& b) -> bool { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+
+// pending (possibly merged) draw.
+struct Batch {
+	ImTextureID texture{};
+	ImVec4 clip_rect{};
+	std::uint32_t first_index{};
+	std::uint32_t index_count{};
+	std::int32_t vertex_offset{};
+	CommandRange commands{};
+	// whether all merged commands lie within their own clip rects: scanning vertices is costly,
+	// so it is only evaluated (and cached) when merging commands whose clip rects differ.
+	std::optional<bool> within_clip_rect{};
+
+	[[nodiscard]] auto is_within_clip_rect(ImDrawData const& draw_data) -> bool {
+		if (!within_clip_rect) { within_clip_rect = detail::is_within_clip_rect(draw_data, commands); }
+		return *within_clip_rect;
+	}
+
+	[[nodiscard]] auto try_merge(Batch& next, ImDrawData const& draw_data) -> bool {
+		if (index_count == 0 || next.texture != texture || next.vertex_offset != vertex_offset) { return false; }
+		if (first_index + index_count != next.first_index) { return false; }
+		if (is_equal(next.clip_rect, clip_rect)) {
+			// known only if known for both, or if either is known to be outside.
+			if (within_clip_rect == false || next.within_clip_rect == false) {
+				within_clip_rect = false;
+			} else if (!next.within_clip_rect) {
+				within_clip_rect.reset();
+			}
+		} else if (is_within_clip_rect(draw_data) && next.is_within_clip_rect(draw_data)) {
+			clip_rect = get_union(clip_rect, next.clip_rect);
+		} else {
+			return false;
+		}
+		commands.last_list = next.commands.last_list;
+		commands.last_cmd = next.commands.last_cmd;
+		index_count += next.index_count;
+		return true;
+	}
+};
+} // namespace
+
+DrawRenderer::DrawRenderer(DeviceMemory::CreateInfo const& memory_info, std::uint32_t const partitions, Options const& options)
+	: m_ring(memory_info, partitions), m_parallel_commands(options.parallel_imgui_commands), m_batching(options.imgui_batching) {
+	auto cmd = ImDrawCmd{};
+	cmd.UserCallback = &DrawRenderer::on_draw;
+	cmd.UserCallbackData = this;
+	m_host_list.CmdBuffer.push_back(cmd);
+	m_host_data.Valid = true;
+	m_host_data.CmdLists.push_back(&m_host_list);
+	m_host_data.CmdListsCount = 1;
+}
+
+void DrawRenderer::render(ImDrawData& draw_data, vk::CommandBuffer const command_buffer) {
+	m_counts = {};
+	if (draw_data.TotalVtxCount == 0) {
+		ImGui_ImplVulkan_RenderDrawData(&draw_data, command_buffer);
+		return;
+	}
+
+	submit_host(draw_data, command_buffer);
+	m_source = nullptr;
+}
+
+void DrawRenderer::render(ImDrawData& draw_data, PassContext const& pass) {
+	if (pass.recorder == nullptr) {
+		render(draw_data, pass.primary);
+		return;
+	}
+
+	auto& recorder = *pass.recorder;
+	auto const secondary = recorder.begin_secondary(pass.inheritance);
+	if (!plan_chunks(draw_data, recorder.get_thread_count())) {
+		render(draw_data, secondary);
+		secondary.end();
+		pass.primary.executeCommands(secondary);
+		return;
+	}
+
+	m_capture = true;
+	submit_host(draw_data, secondary);
+	m_capture = false;
+	secondary.end();
+
+	m_inheritances.assign(m_chunks.size(), pass.inheritance);
+	m_secondaries.resize(m_chunks.size() + 1);
+	m_secondaries.front() = secondary;
+	auto const out = std::span{m_secondaries}.subspan(1);
+	recorder.record(m_inheritances, out, [this](std::size_t const index, vk::CommandBuffer const command_buffer) {
+		record(command_buffer, m_captured, m_chunks[index]);
+	});
+	// chunks are executed in draw list order.
+	pass.primary.executeCommands(m_secondaries);
+	m_source = nullptr;
+
+	m_counts = {};
+	for (auto const& chunk : m_chunks) {
+		m_counts.commands += chunk.counts.commands;
+		m_counts.draws += chunk.counts.draws;
+	}
+}
+
+void DrawRenderer::on_draw(ImDrawList const* /*list*/, ImDrawCmd const* cmd) {
+	auto const* state = static_cast<ImGui_ImplVulkan_RenderState const*>(ImGui::GetPlatformIO().Renderer_RenderState);
+	assert(state != nullptr);
+	auto& self = *static_cast<DrawRenderer*>(cmd->UserCallbackData);
+	auto const pipeline = Pipeline{.pipeline = vk::Pipeline{state->Pipeline}, .layout = vk::PipelineLayout{state->PipelineLayout}};
+	if (self.m_capture) {
+		self.m_captured = pipeline;
+		return;
+	}
+	assert(self.m_source != nullptr);
+	auto chunk = Chunk{.last_list = self.m_source->CmdListsCount};
+	self.record(vk::CommandBuffer{state->CommandBuffer}, pipeline, chunk);
+	self.m_counts = chunk.counts;
+}
+
+void DrawRenderer::submit_host(ImDrawData& draw_data, vk::CommandBuffer const command_buffer) {
+	m_slice = m_ring.write(draw_data, m_batching);
+	m_source = &draw_data;
+
+	// the host contains a single callback command and no geometry: the backend only binds its pipeline and invokes on_draw().
+	m_host_data.DisplayPos = draw_data.DisplayPos;
+	m_host_data.DisplaySize = draw_data.DisplaySize;
+	m_host_data.FramebufferScale = draw_data.FramebufferScale;
+	// the backend looks up its per-viewport buffers (left unused, there is no geometry) through the owner:
+	// only the main viewport's are guaranteed to exist, platform windows are presented by gvdi instead.
+	m_host_data.OwnerViewport = ImGui::GetMainViewport();
+	ImGui_ImplVulkan_RenderDrawData(&m_host_data, command_buffer);
+}
+
+auto DrawRenderer::plan_chunks(ImDrawData const& draw_data, std::uint32_t const thread_count) -> bool {
+	if (m_parallel_commands == 0 || draw_data.TotalVtxCount == 0 || draw_data.CmdListsCount < 2) { return false; }
+
+	auto total_commands = std::uint32_t{};
+	for (auto const* list : draw_data.CmdLists) {
+		for (auto const& cmd : list->CmdBuffer) {
+			// user callbacks expect to be invoked on the main thread, with the backend's render state.
+			if (cmd.UserCallback != nullptr && cmd.UserCallback != ImDrawCallback_ResetRenderState) { return false; }
+		}
+		total_commands += static_cast<std::uint32_t>(list->CmdBuffer.Size);
+	}
+	if (total_commands < m_parallel_commands) { return false; }
+
+	// the calling thread also records.
+	auto const target = (total_commands + thread_count) / (thread_count + 1);
+	m_chunks.clear();
+	auto chunk = Chunk{};
+	auto chunk_commands = std::uint32_t{};
+	for (int index = 0; index < draw_data.CmdListsCount; ++index) {
+		auto const* list = draw_data.CmdLists[index];
+		chunk_commands += static_cast<std::uint32_t>(list->CmdBuffer.Size);
+		chunk.last_list = index + 1;
+		if (chunk_commands < target && chunk.last_list < draw_data.CmdListsCount) { continue; }
+		m_chunks.push_back(chunk);
+		chunk = Chunk{.first_list = chunk.last_list, .last_list = chunk.last_list};
+		chunk_commands = 0;
+	}
+	for (std::size_t index = 1; index < m_chunks.size(); ++index) {
+		auto& current = m_chunks[index];
+		auto const& previous = m_chunks[index - 1];
+		current.idx_offset = previous.idx_offset;
+		for (int list = previous.first_list; list < previous.last_list; ++list) {
+			current.idx_offset += static_cast<std::uint32_t>(draw_data.CmdLists[list]->IdxBuffer.Size);
+		}
+	}
+	return m_chunks.size() > 1;
+}
+
+void DrawRenderer::record(vk::CommandBuffer const command_buffer, Pipeline const& pipeline, Chunk& chunk) const {
+	assert(m_source != nullptr);
+	auto const& draw_data = *m_source;
+	auto const fb_size = get_framebuffer_size(draw_data);
+	auto const vertex_bases = m_ring.get_vertex_bases();
+
+	setup_render_state(command_buffer, pipeline);
+
+	auto bound_texture = std::optional<ImTextureID>{};
+	auto bound_scissor = std::optional<vk::Rect2D>{};
+	auto const draw = [&](Batch const& batch) {
+		if (batch.index_count == 0) { return; }
+		auto const scissor = get_scissor(draw_data, batch.clip_rect, fb_size);
+		if (!scissor) { return; }
+
+		if (bound_texture != batch.texture) {
+			auto const descriptor_set = to_descriptor_set(batch.texture);
+			command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline.layout, 0, descriptor_set, {});
+			bound_texture = batch.texture;
+		}
+		if (bound_scissor != scissor) {
+			command_buffer.setScissor(0, *scissor);
+			bound_scissor = scissor;
+		}
+		command_buffer.drawIndexed(batch.index_count, 1, batch.first_index, batch.vertex_offset, 0);
+		++chunk.counts.draws;
+	};
+
+	auto pending = Batch{};
+	auto global_idx_offset = chunk.idx_offset;
+	for (int index = chunk.first_list; index < chunk.last_list; ++index) {
+		auto const* list = draw_data.CmdLists[index];
+		auto const vertex_base = vertex_bases[static_cast<std::size_t>(index)];
+		for (int cmd_index = 0; cmd_index < list->CmdBuffer.Size; ++cmd_index) {
+			auto const& cmd = list->CmdBuffer[cmd_index];
+			++chunk.counts.commands;
+			if (cmd.UserCallback != nullptr) {
+				draw(std::exchange(pending, {}));
+				if (cmd.UserCallback == ImDrawCallback_ResetRenderState) {
+					setup_render_state(command_buffer, pipeline);
+				} else {
+					cmd.UserCallback(list, &cmd);
+				}
+				// user callbacks may have bound other descriptor sets, or set other scissors.
+				bound_texture.reset();
+				bound_scissor.reset();
+				continue;
+			}
+
+			auto batch = Batch{
+				.texture = cmd.GetTexID(),
+				.clip_rect = cmd.ClipRect,
+				.first_index = cmd.IdxOffset + global_idx_offset,
+				.index_count = cmd.ElemCount,
+				.vertex_offset = static_cast<std::int32_t>(cmd.VtxOffset + vertex_base),
+				.commands = CommandRange{.first_list = index, .first_cmd = cmd_index, .last_list = index, .last_cmd = cmd_index},
+			};
+			if (m_batching && pending.try_merge(batch, draw_data)) { continue; }
+			draw(std::exchange(pending, batch));
+		}
+		global_idx_offset += static_cast<std::uint32_t>(list->IdxBuffer.Size);
+	}
+	draw(pending);
+}
+
+void DrawRenderer::setup_render_state(vk::CommandBuffer const command_buffer, Pipeline const& pipeline) const {
+	auto const& draw_data = *m_source;
+	auto const fb_size = get_framebuffer_size(draw_data);
+
+	command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.pipeline);
+	command_buffer.bindVertexBuffers(0, m_slice.buffer, m_slice.vertex_offset);
+	command_buffer.bindIndexBuffer(m_slice.buffer, m_slice.index_offset, index_type_v);
+	command_buffer.setViewport(0, vk::Viewport{0.0f, 0.0f, fb_size.x, fb_size.y, 0.0f, 1.0f});
+
+	// matches the backend's push constant layout: vec2 scale, vec2 translate.
+	auto const scale = ImVec2{2.0f / draw_data.DisplaySize.x, 2.0f / draw_data.DisplaySize.y};
+	auto const push_constants = std::array{
+		scale.x,
+		scale.y,
+		-1.0f - (draw_data.DisplayPos.x * scale.x),
+		-1.0f - (draw_data.DisplayPos.y * scale.y),
+	};
+	command_buffer.pushConstants(pipeline.layout, vk::ShaderStageFlagBits::eVertex, 0, sizeof(push_constants), push_constants.data());
+}
+} // namespace gvdi::detail
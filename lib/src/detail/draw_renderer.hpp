@@ -0,0 +1,80 @@
+#pragma once
+#include "detail/geometry_ring.hpp"
+#include "detail/parallel_recorder.hpp"
+#include "gvdi/options.hpp"
+#include <backends/imgui_impl_vulkan.h>
+#include <imgui.h>
+#include <vulkan/vulkan.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Renders Dear ImGui draw data using geometry uploaded to a GeometryRing.
+/// The Vulkan backend remains responsible for its pipeline, fonts and textures:
+/// draws are recorded inside a draw callback, where its pipeline is bound and exposed via ImGui_ImplVulkan_RenderState.
+/// Large frames can be split by draw list into secondary command buffers recorded in parallel (see ParallelRecorder).
+/// If batching is enabled, adjacent commands (across draw lists) using the same texture are merged into a single draw
+/// when their clip rects are equal, or when none of their vertices lie outside them (the scissor then covers both).
+class DrawRenderer {
+  public:
+	DrawRenderer(DrawRenderer const&) = delete;
+	DrawRenderer(DrawRenderer&&) = delete;
+	auto operator=(DrawRenderer const&) = delete;
+	auto operator=(DrawRenderer&&) = delete;
+
+	~DrawRenderer() = default;
+
+	struct Counts {
+		std::uint32_t commands{};
+		std::uint32_t draws{};
+	};
+
+	/// \brief Uses Options::parallel_imgui_commands and Options::imgui_batching.
+	explicit DrawRenderer(DeviceMemory::CreateInfo const& memory_info, std::uint32_t partitions, Options const& options);
+
+	void render(ImDrawData& draw_data, vk::CommandBuffer command_buffer);
+	void render(ImDrawData& draw_data, PassContext const& pass);
+
+	/// \returns Draw commands and recorded draw calls of the last render.
+	[[nodiscard]] auto get_counts() const -> Counts { return m_counts; }
+
+  private:
+	struct Pipeline {
+		vk::Pipeline pipeline{};
+		vk::PipelineLayout layout{};
+	};
+
+	// contiguous range of draw lists, and the index offset of its first list in the ring buffer slice.
+	struct Chunk {
+		int first_list{};
+		int last_list{};
+		std::uint32_t idx_offset{};
+		Counts counts{};
+	};
+
+	static void on_draw(ImDrawList const* list, ImDrawCmd const* cmd);
+
+	void submit_host(ImDrawData& draw_data, vk::CommandBuffer command_buffer);
+	[[nodiscard]] auto plan_chunks(ImDrawData const& draw_data, std::uint32_t thread_count) -> bool;
+
+	void record(vk::CommandBuffer command_buffer, Pipeline const& pipeline, Chunk& chunk) const;
+	void setup_render_state(vk::CommandBuffer command_buffer, Pipeline const& pipeline) const;
+
+	GeometryRing m_ring;
+	std::uint32_t m_parallel_commands;
+	bool m_batching;
+	ImDrawList m_host_list{nullptr};
+	ImDrawData m_host_data{};
+
+	ImDrawData const* m_source{};
+	GeometryRing::Slice m_slice{};
+	Counts m_counts{};
+
+	// parallel recording: the host pass only captures the backend's pipeline.
+	bool m_capture{};
+	Pipeline m_captured{};
+	std::vector<Chunk> m_chunks{};
+	std::vector<vk::CommandBufferInheritanceInfo> m_inheritances{};
+	std::vector<vk::CommandBuffer> m_secondaries{};
+};
+} // namespace gvdi::detail
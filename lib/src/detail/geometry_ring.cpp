@@ -0,0 +1,84 @@
+#include "detail/geometry_ring.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace gvdi::detail {
+namespace {
+// number of vertices addressable by ImDrawIdx.
+constexpr auto window_size_v = std::uint64_t{std::numeric_limits<ImDrawIdx>::max()} + 1;
+
+constexpr auto align_up(vk::DeviceSize const value, vk::DeviceSize const alignment) -> vk::DeviceSize {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+GeometryRing::GeometryRing(DeviceMemory::CreateInfo const& memory_info, std::uint32_t const partitions)
+	: m_memory_info(memory_info), m_partitions(std::max(partitions, 1u)) {
+	grow(min_partition_size_v);
+}
+
+auto GeometryRing::write(ImDrawData const& draw_data, bool const rebase) -> Slice {
+	++m_frame;
+	std::erase_if(m_retired, [this](Retired const& r) { return m_frame >= r.frame + m_partitions; });
+
+	auto const index_start = get_index_start(draw_data);
+	auto const required = index_start + (vk::DeviceSize(draw_data.TotalIdxCount) * sizeof(ImDrawIdx));
+	m_high_water_mark = std::max(m_high_water_mark, required);
+	if (required > m_partition_size) { grow(required); }
+
+	m_partition = (m_partition + 1) % m_partitions;
+	auto const base = vk::DeviceSize{m_partition} * m_partition_size;
+	auto* vertices = m_buffer.get_mapped() + base;
+	auto* indices = vertices + index_start;
+	m_vertex_bases.clear();
+	auto global_vtx_offset = std::uint32_t{};
+	auto window_start = std::uint32_t{};
+	// one contiguous copy per draw list and buffer, draws address them via global (or window) offsets.
+	for (auto const* list : draw_data.CmdLists) {
+		auto const vertex_count = static_cast<std::uint32_t>(list->VtxBuffer.Size);
+		auto const vertex_bytes = std::size_t(list->VtxBuffer.size_in_bytes());
+		auto const index_bytes = std::size_t(list->IdxBuffer.size_in_bytes());
+		std::memcpy(vertices, list->VtxBuffer.Data, vertex_bytes);
+
+		auto delta = std::uint32_t{};
+		if (rebase) {
+			// lists large enough to need ImDrawCmd::VtxOffset start (and end) a window of their own.
+			if (std::uint64_t{global_vtx_offset - window_start} + vertex_count > window_size_v) { window_start = global_vtx_offset; }
+			delta = global_vtx_offset - window_start;
+		}
+		if (delta == 0) {
+			std::memcpy(indices, list->IdxBuffer.Data, index_bytes);
+		} else {
+			auto const* src = list->IdxBuffer.Data;
+			auto* dst = reinterpret_cast<ImDrawIdx*>(indices); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+			for (int index = 0; index < list->IdxBuffer.Size; ++index) { dst[index] = static_cast<ImDrawIdx>(src[index] + delta); }
+		}
+		m_vertex_bases.push_back(global_vtx_offset - delta);
+
+		global_vtx_offset += vertex_count;
+		vertices += vertex_bytes;
+		indices += index_bytes;
+	}
+	m_buffer.flush(m_memory_info.device);
+
+	return Slice{.buffer = *m_buffer.buffer, .vertex_offset = base, .index_offset = base + index_start};
+}
+
+auto GeometryRing::get_index_start(ImDrawData const& draw_data) -> vk::DeviceSize {
+	// index buffer offsets must be a multiple of the index type size.
+	return align_up(vk::DeviceSize(draw_data.TotalVtxCount) * sizeof(ImDrawVert), 4);
+}
+
+void GeometryRing::grow(vk::DeviceSize const required) {
+	// headroom to avoid repeated growth as the UI expands.
+	auto const partition_size = std::max(std::bit_ceil(required + (required / 2)), min_partition_size_v);
+	if (m_buffer) { m_retired.push_back(Retired{.buffer = std::move(m_buffer), .frame = m_frame}); }
+	static constexpr auto usage_v = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer;
+	m_buffer = Buffer::create(m_memory_info, partition_size * m_partitions, usage_v, vk::MemoryPropertyFlagBits::eHostVisible);
+	assert(m_buffer.get_mapped() != nullptr);
+	m_partition_size = partition_size;
+}
+} // namespace gvdi::detail
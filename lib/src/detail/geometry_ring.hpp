@@ -0,0 +1,57 @@
+#pragma once
+#include "detail/gpu_memory.hpp"
+#include <imgui.h>
+#include <vulkan/vulkan.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Persistently mapped vertex + index buffer for Dear ImGui geometry, partitioned per frame in flight.
+/// Partitions are sized from the high-water mark (with headroom), and only grow when a frame exceeds it.
+class GeometryRing {
+  public:
+	struct Slice {
+		vk::Buffer buffer{};
+		vk::DeviceSize vertex_offset{};
+		vk::DeviceSize index_offset{};
+	};
+
+	static constexpr vk::DeviceSize min_partition_size_v{256 * 1024};
+
+	explicit GeometryRing(DeviceMemory::CreateInfo const& memory_info, std::uint32_t partitions);
+
+	/// \brief Copy all vertices and indices of draw_data into the next partition.
+	/// The partition must not be in use by the GPU: requires at most partitions - 1 frames in flight.
+	/// If rebase is true, indices of consecutive draw lists are offset into shared windows of vertices addressable by ImDrawIdx,
+	/// so that draws of different lists can share a vertex offset (and be merged).
+	[[nodiscard]] auto write(ImDrawData const& draw_data, bool rebase = false) -> Slice;
+
+	/// \returns Vertex offset of each draw list in the last write (to be added to ImDrawCmd::VtxOffset).
+	[[nodiscard]] auto get_vertex_bases() const -> std::span<std::uint32_t const> { return m_vertex_bases; }
+
+	[[nodiscard]] auto get_partition_size() const -> vk::DeviceSize { return m_partition_size; }
+	[[nodiscard]] auto get_high_water_mark() const -> vk::DeviceSize { return m_high_water_mark; }
+
+  private:
+	struct Retired {
+		Buffer buffer{};
+		std::uint64_t frame{};
+	};
+
+	static auto get_index_start(ImDrawData const& draw_data) -> vk::DeviceSize;
+
+	void grow(vk::DeviceSize required);
+
+	DeviceMemory::CreateInfo m_memory_info;
+	std::uint32_t m_partitions;
+
+	Buffer m_buffer{};
+	vk::DeviceSize m_partition_size{};
+	vk::DeviceSize m_high_water_mark{};
+	std::uint32_t m_partition{};
+	std::uint64_t m_frame{};
+	std::vector<Retired> m_retired{};
+	std::vector<std::uint32_t> m_vertex_bases{};
+};
+} // namespace gvdi::detail
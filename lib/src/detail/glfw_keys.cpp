@@ -0,0 +1,91 @@
+#include "detail/glfw_keys.hpp"
+#include <GLFW/glfw3.h>
+
+namespace gvdi::detail {
+namespace {
+// contiguous ranges in both GLFW and Dear ImGui.
+auto to_ranged_key(int const key) -> ImGuiKey {
+	if (key >= GLFW_KEY_0 && key <= GLFW_KEY_9) { return ImGuiKey(ImGuiKey_0 + (key - GLFW_KEY_0)); }
+	if (key >= GLFW_KEY_A && key <= GLFW_KEY_Z) { return ImGuiKey(ImGuiKey_A + (key - GLFW_KEY_A)); }
+	if (key >= GLFW_KEY_F1 && key <= GLFW_KEY_F24) { return ImGuiKey(ImGuiKey_F1 + (key - GLFW_KEY_F1)); }
+	if (key >= GLFW_KEY_KP_0 && key <= GLFW_KEY_KP_9) { return ImGuiKey(ImGuiKey_Keypad0 + (key - GLFW_KEY_KP_0)); }
+	return ImGuiKey_None;
+}
+} // namespace
+
+auto to_imgui_key(int const glfw_key) -> ImGuiKey {
+	switch (glfw_key) {
+	case GLFW_KEY_TAB: return ImGuiKey_Tab;
+	case GLFW_KEY_LEFT: return ImGuiKey_LeftArrow;
+	case GLFW_KEY_RIGHT: return ImGuiKey_RightArrow;
+	case GLFW_KEY_UP: return ImGuiKey_UpArrow;
+	case GLFW_KEY_DOWN: return ImGuiKey_DownArrow;
+	case GLFW_KEY_PAGE_UP: return ImGuiKey_PageUp;
+	case GLFW_KEY_PAGE_DOWN: return ImGuiKey_PageDown;
+	case GLFW_KEY_HOME: return ImGuiKey_Home;
+	case GLFW_KEY_END: return ImGuiKey_End;
+	case GLFW_KEY_INSERT: return ImGuiKey_Insert;
+	case GLFW_KEY_DELETE: return ImGuiKey_Delete;
+	case GLFW_KEY_BACKSPACE: return ImGuiKey_Backspace;
+	case GLFW_KEY_SPACE: return ImGuiKey_Space;
+	case GLFW_KEY_ENTER: return ImGuiKey_Enter;
+	case GLFW_KEY_ESCAPE: return ImGuiKey_Escape;
+	case GLFW_KEY_APOSTROPHE: return ImGuiKey_Apostrophe;
+	case GLFW_KEY_COMMA: return ImGuiKey_Comma;
+	case GLFW_KEY_MINUS: return ImGuiKey_Minus;
+	case GLFW_KEY_PERIOD: return ImGuiKey_Period;
+	case GLFW_KEY_SLASH: return ImGuiKey_Slash;
+	case GLFW_KEY_SEMICOLON: return ImGuiKey_Semicolon;
+	case GLFW_KEY_EQUAL: return ImGuiKey_Equal;
+	case GLFW_KEY_LEFT_BRACKET: return ImGuiKey_LeftBracket;
+	case GLFW_KEY_BACKSLASH: return ImGuiKey_Backslash;
+	case GLFW_KEY_RIGHT_BRACKET: return ImGuiKey_RightBracket;
+	case GLFW_KEY_GRAVE_ACCENT: return ImGuiKey_GraveAccent;
+	case GLFW_KEY_CAPS_LOCK: return ImGuiKey_CapsLock;
+	case GLFW_KEY_SCROLL_LOCK: return ImGuiKey_ScrollLock;
+	case GLFW_KEY_NUM_LOCK: return ImGuiKey_NumLock;
+	case GLFW_KEY_PRINT_SCREEN: return ImGuiKey_PrintScreen;
+	case GLFW_KEY_PAUSE: return ImGuiKey_Pause;
+	case GLFW_KEY_KP_DECIMAL: return ImGuiKey_KeypadDecimal;
+	case GLFW_KEY_KP_DIVIDE: return ImGuiKey_KeypadDivide;
+	case GLFW_KEY_KP_MULTIPLY: return ImGuiKey_KeypadMultiply;
+	case GLFW_KEY_KP_SUBTRACT: return ImGuiKey_KeypadSubtract;
+	case GLFW_KEY_KP_ADD: return ImGuiKey_KeypadAdd;
+	case GLFW_KEY_KP_ENTER: return ImGuiKey_KeypadEnter;
+	case GLFW_KEY_KP_EQUAL: return ImGuiKey_KeypadEqual;
+	case GLFW_KEY_LEFT_SHIFT: return ImGuiKey_LeftShift;
+	case GLFW_KEY_LEFT_CONTROL: return ImGuiKey_LeftCtrl;
+	case GLFW_KEY_LEFT_ALT: return ImGuiKey_LeftAlt;
+	case GLFW_KEY_LEFT_SUPER: return ImGuiKey_LeftSuper;
+	case GLFW_KEY_RIGHT_SHIFT: return ImGuiKey_RightShift;
+	case GLFW_KEY_RIGHT_CONTROL: return ImGuiKey_RightCtrl;
+	case GLFW_KEY_RIGHT_ALT: return ImGuiKey_RightAlt;
+	case GLFW_KEY_RIGHT_SUPER: return ImGuiKey_RightSuper;
+	case GLFW_KEY_MENU: return ImGuiKey_Menu;
+	default: return to_ranged_key(glfw_key);
+	}
+}
+
+auto to_mods_after(int const glfw_key, int const glfw_action, int const glfw_mods) -> int {
+	auto mod = 0;
+	switch (glfw_key) {
+	case GLFW_KEY_LEFT_CONTROL:
+	case GLFW_KEY_RIGHT_CONTROL: mod = GLFW_MOD_CONTROL; break;
+	case GLFW_KEY_LEFT_SHIFT:
+	case GLFW_KEY_RIGHT_SHIFT: mod = GLFW_MOD_SHIFT; break;
+	case GLFW_KEY_LEFT_ALT:
+	case GLFW_KEY_RIGHT_ALT: mod = GLFW_MOD_ALT; break;
+	case GLFW_KEY_LEFT_SUPER:
+	case GLFW_KEY_RIGHT_SUPER: mod = GLFW_MOD_SUPER; break;
+	default: return glfw_mods;
+	}
+	return glfw_action == GLFW_RELEASE ? (glfw_mods & ~mod) : (glfw_mods | mod);
+}
+
+void add_imgui_modifiers(ImGuiIO& io, int const glfw_mods) {
+	io.AddKeyEvent(ImGuiMod_Ctrl, (glfw_mods & GLFW_MOD_CONTROL) != 0);
+	io.AddKeyEvent(ImGuiMod_Shift, (glfw_mods & GLFW_MOD_SHIFT) != 0);
+	io.AddKeyEvent(ImGuiMod_Alt, (glfw_mods & GLFW_MOD_ALT) != 0);
+	io.AddKeyEvent(ImGuiMod_Super, (glfw_mods & GLFW_MOD_SUPER) != 0);
+}
+} // namespace gvdi::detail
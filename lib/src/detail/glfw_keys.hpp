@@ -0,0 +1,13 @@
+#pragma once
+#include <imgui.h>
+
+namespace gvdi::detail {
+/// \brief Dear ImGui key for a GLFW key code (as mapped by the GLFW backend, ignoring keyboard layouts), ImGuiKey_None if unmapped.
+[[nodiscard]] auto to_imgui_key(int glfw_key) -> ImGuiKey;
+
+/// \brief GLFW mods after a key event: on some platforms they do not include a modifier key's own press / release.
+[[nodiscard]] auto to_mods_after(int glfw_key, int glfw_action, int glfw_mods) -> int;
+
+/// \brief Queue the Dear ImGui modifier keys for GLFW mods.
+void add_imgui_modifiers(ImGuiIO& io, int glfw_mods);
+} // namespace gvdi::detail
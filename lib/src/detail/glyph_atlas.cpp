@@ -0,0 +1,356 @@
+#include "detail/glyph_atlas.hpp"
+#include "detail/texture_store.hpp"
+#include "gvdi/exception.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <format>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_STATIC
+#include <imstb_truetype.h>
+
+namespace gvdi::detail {
+namespace {
+constexpr int min_extent_v{256};
+
+// baked AA lines (as built by ImFontAtlas) and a 3x3 white block, above the glyph slots.
+constexpr int lines_width_v{IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 2};
+constexpr int band_height_v{IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1};
+constexpr int white_x_v{lines_width_v + 1};
+constexpr int band_width_v{white_x_v + 4};
+// 1 transparent row between the band and the first slots.
+constexpr int grid_y_v{band_height_v + 1};
+
+// placeholder UVs: clamped to the (never written) bottom-right texel, the integer parts encode the codepoint.
+constexpr float sentinel_origin_v{2.0f};
+constexpr unsigned sentinel_bits_v{8};
+constexpr unsigned sentinel_mask_v{(1u << sentinel_bits_v) - 1};
+
+struct Sentinel {
+	unsigned codepoint{};
+	// position within the glyph quad, for CPU clipped vertices.
+	ImVec2 t{};
+};
+
+constexpr auto is_sentinel(ImVec2 const uv) -> bool { return uv.x >= sentinel_origin_v && uv.y >= sentinel_origin_v; }
+
+auto to_sentinel_rect(unsigned const codepoint) -> ImVec4 {
+	auto const u = sentinel_origin_v + float(2 * (codepoint & sentinel_mask_v));
+	auto const v = sentinel_origin_v + float(2 * (codepoint >> sentinel_bits_v));
+	return ImVec4{u, v, u + 1.0f, v + 1.0f};
+}
+
+auto decode(ImVec2 const uv) -> Sentinel {
+	auto const u = uv.x - sentinel_origin_v;
+	auto const v = uv.y - sentinel_origin_v;
+	auto const low = unsigned(u) / 2;
+	auto const high = unsigned(v) / 2;
+	return Sentinel{
+		.codepoint = (high << sentinel_bits_v) | low,
+		.t = ImVec2{u - float(2 * low), v - float(2 * high)},
+	};
+}
+
+auto find_glyph(ImFont& font, unsigned const codepoint) -> ImFontGlyph* {
+	if (codepoint >= unsigned(font.IndexLookup.Size)) { return nullptr; }
+	auto const index = font.IndexLookup[int(codepoint)];
+	if (index == ImWchar(-1)) { return nullptr; }
+	return &font.Glyphs[int(index)];
+}
+
+void set_uvs(ImFontGlyph& glyph, ImVec4 const& rect) {
+	glyph.U0 = rect.x;
+	glyph.V0 = rect.y;
+	glyph.U1 = rect.z;
+	glyph.V1 = rect.w;
+}
+} // namespace
+
+struct GlyphAtlas::Font {
+	std::vector<unsigned char> data{};
+	stbtt_fontinfo info{};
+	float scale{};
+};
+
+GlyphAtlas::GlyphAtlas(std::shared_ptr<TextureStore> const& store, GlyphCacheCreateInfo const& create_info)
+	: m_ttf(std::make_unique<Font>()), m_store(store), m_extent(create_info.atlas_size) {
+	if (create_info.size <= 0.0f) { throw Exception{"GlyphCache: Invalid size"}; }
+	if (m_extent < min_extent_v) { throw Exception{std::format("GlyphCache: atlas_size must be at least {}", min_extent_v)}; }
+
+	auto const* first = reinterpret_cast<unsigned char const*>(create_info.font.data());
+	m_ttf->data.assign(first, first + create_info.font.size());
+	auto const offset = m_ttf->data.empty() ? -1 : stbtt_GetFontOffsetForIndex(m_ttf->data.data(), create_info.font_index);
+	if (offset < 0 || stbtt_InitFont(&m_ttf->info, m_ttf->data.data(), offset) == 0) {
+		throw Exception{std::format("GlyphCache: Failed to load font (index {})", create_info.font_index)};
+	}
+	m_ttf->scale = stbtt_ScaleForPixelHeight(&m_ttf->info, create_info.size);
+
+	auto ascent = 0;
+	auto descent = 0;
+	auto line_gap = 0;
+	stbtt_GetFontVMetrics(&m_ttf->info, &ascent, &descent, &line_gap);
+
+	m_config.SizePixels = create_info.size;
+	m_config.FontDataOwnedByAtlas = false;
+	m_config.DstFont = &m_font;
+	std::snprintf(m_config.Name, sizeof(m_config.Name), "GlyphCache, %.0fpx", double(create_info.size));
+
+	m_container.TexWidth = m_container.TexHeight = m_extent;
+	m_container.TexUvScale = ImVec2{1.0f / float(m_extent), 1.0f / float(m_extent)};
+
+	m_font.FontSize = create_info.size;
+	m_font.ConfigData = &m_config;
+	m_font.ConfigDataCount = 1;
+	m_font.ContainerAtlas = &m_container;
+	m_font.Ascent = std::ceil(float(ascent) * m_ttf->scale);
+	m_font.Descent = std::floor(float(descent) * m_ttf->scale);
+
+	load_glyphs(create_info.ranges != nullptr ? create_info.ranges : m_container.GetGlyphRangesDefault());
+
+	auto const slot_size = m_cell + 1;
+	m_columns = (m_extent - 1) / slot_size;
+	m_rows = (m_extent - 1 - grid_y_v) / slot_size;
+	if (m_columns <= 0 || m_rows <= 0) {
+		throw Exception{std::format("GlyphCache: atlas_size {} too small for glyphs of size {}", m_extent, m_cell)};
+	}
+	m_slots.resize(std::size_t(m_columns) * std::size_t(m_rows));
+	m_stats.capacity = std::uint32_t(m_slots.size());
+
+	auto const extent = vk::Extent2D{std::uint32_t(m_extent), std::uint32_t(m_extent)};
+	m_page_handle = store->create(extent);
+	m_page = Texture{store, m_page_handle};
+	m_container.TexID = m_page.get_id();
+	write_band();
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+void GlyphAtlas::load_glyphs(ImWchar const* ranges) {
+	struct Metrics {
+		unsigned codepoint{};
+		int x0{};
+		int y0{};
+		int x1{};
+		int y1{};
+		float advance{};
+	};
+
+	auto const& info = m_ttf->info;
+	auto const scale = m_ttf->scale;
+	// glyphs larger than this (rare, eg ligature-like symbols) are cropped instead of inflating every slot.
+	auto const max_cell = int(std::ceil(2.0f * m_config.SizePixels));
+
+	auto seen = std::vector<bool>(IM_UNICODE_CODEPOINT_MAX + 1);
+	auto metrics = std::vector<Metrics>{};
+	for (auto const* range = ranges; range[0] != 0; range += 2) {
+		for (auto codepoint = unsigned(range[0]); codepoint <= unsigned(range[1]) && codepoint <= IM_UNICODE_CODEPOINT_MAX; ++codepoint) {
+			if (seen[codepoint]) { continue; }
+			seen[codepoint] = true;
+			auto const glyph = stbtt_FindGlyphIndex(&info, int(codepoint));
+			if (glyph == 0) { continue; }
+
+			auto advance = 0;
+			auto bearing = 0;
+			stbtt_GetGlyphHMetrics(&info, glyph, &advance, &bearing);
+			auto ret = Metrics{.codepoint = codepoint, .advance = float(advance) * scale};
+			stbtt_GetGlyphBitmapBox(&info, glyph, scale, scale, &ret.x0, &ret.y0, &ret.x1, &ret.y1);
+			ret.x1 = std::min(ret.x1, ret.x0 + max_cell);
+			ret.y1 = std::min(ret.y1, ret.y0 + max_cell);
+			m_cell = std::max({m_cell, ret.x1 - ret.x0, ret.y1 - ret.y0});
+			metrics.push_back(ret);
+		}
+	}
+	// IndexLookup holds (16 bit) glyph indices, -1 is reserved, and a tab glyph is added.
+	if (metrics.empty()) { throw Exception{"GlyphCache: Font has no glyphs in ranges"}; }
+	if (metrics.size() + 1 >= 0xFFFF) { throw Exception{std::format("GlyphCache: Too many glyphs in ranges: {}", metrics.size())}; }
+	m_cell = std::max(m_cell, 1);
+
+	auto const baseline = std::round(m_font.Ascent);
+	auto max_codepoint = 0u;
+	for (auto const& glyph : metrics) {
+		m_font.AddGlyph(&m_config, ImWchar(glyph.codepoint), float(glyph.x0), float(glyph.y0) + baseline, float(glyph.x1),
+						float(glyph.y1) + baseline, 0.0f, 0.0f, 0.0f, 0.0f, glyph.advance);
+		max_codepoint = std::max(max_codepoint, glyph.codepoint);
+	}
+	m_font.BuildLookupTable();
+	// after AddGlyph(): its surface metrics assume UVs within [0, 1].
+	for (auto& glyph : m_font.Glyphs) { set_uvs(glyph, to_sentinel_rect(glyph.Codepoint)); }
+	m_resident.assign(max_codepoint + 1, -1);
+	m_stats.glyphs = std::uint32_t(metrics.size());
+}
+
+void GlyphAtlas::write_band() {
+	// white RGB throughout: only alpha varies, as in the Dear ImGui RGBA32 font atlas.
+	auto pixels = std::vector<std::byte>(std::size_t(band_width_v) * std::size_t(band_height_v) * 4, std::byte{0xff});
+	auto const set_alpha = [&pixels](int const x, int const y, std::byte const alpha) {
+		pixels[(((std::size_t(y) * band_width_v) + std::size_t(x)) * 4) + 3] = alpha;
+	};
+	for (int y = 0; y < band_height_v; ++y) {
+		for (int x = 0; x < band_width_v; ++x) { set_alpha(x, y, std::byte{}); }
+	}
+
+	auto const scale = m_container.TexUvScale;
+	for (int width = 0; width < band_height_v; ++width) {
+		auto const pad_left = (lines_width_v - width) / 2;
+		for (int x = pad_left; x < pad_left + width; ++x) { set_alpha(x, width, std::byte{0xff}); }
+		// constant V in the middle of the row.
+		auto const v = (float(width) + 0.5f) * scale.y;
+		m_container.TexUvLines[width] = ImVec4{float(pad_left - 1) * scale.x, v, float(pad_left + width + 1) * scale.x, v};
+	}
+
+	for (int y = 0; y < 3; ++y) {
+		for (int x = white_x_v; x < white_x_v + 3; ++x) { set_alpha(x, y, std::byte{0xff}); }
+	}
+	m_container.TexUvWhitePixel = ImVec2{(float(white_x_v) + 1.5f) * scale.x, 1.5f * scale.y};
+
+	auto store = m_store.lock();
+	store->update(m_page_handle, Bitmap{.bytes = pixels, .width = band_width_v, .height = band_height_v}, vk::Offset2D{});
+}
+
+void GlyphAtlas::resolve(std::span<ImDrawData* const> const draw_data) {
+	if (!is_valid()) { return; }
+	auto store = m_store.lock();
+	if (!store) { return; }
+
+	++m_frame;
+	m_stats.overflowed = 0;
+	m_misses.clear();
+	auto const texture_id = m_container.TexID;
+	for (auto const* data : draw_data) {
+		for (auto* list : data->CmdLists) {
+			for (auto const& cmd : list->CmdBuffer) {
+				if (cmd.UserCallback != nullptr || cmd.GetTexID() != texture_id) { continue; }
+				for (auto index = cmd.IdxOffset; index < cmd.IdxOffset + cmd.ElemCount; ++index) {
+					auto& vertex = list->VtxBuffer[int(cmd.VtxOffset + list->IdxBuffer[int(index)])];
+					if (is_sentinel(vertex.uv)) {
+						m_misses.push_back(&vertex);
+					} else {
+						mark_used(vertex.uv);
+					}
+				}
+			}
+		}
+	}
+	// all resident glyphs drawn this frame are marked before any slot is evicted.
+	if (m_misses.empty()) { return; }
+
+	m_pixels.clear();
+	m_pending.clear();
+	for (auto const* vertex : m_misses) {
+		auto const codepoint = decode(vertex->uv).codepoint;
+		if (codepoint >= m_resident.size() || m_resident[codepoint] != -1) { continue; }
+		auto* glyph = find_glyph(m_font, codepoint);
+		if (glyph == nullptr) { continue; }
+		if (!rasterize(*glyph)) {
+			// don't retry this frame.
+			m_resident[codepoint] = -2;
+			m_overflowed.push_back(codepoint);
+			++m_stats.overflowed;
+		}
+	}
+	for (auto const codepoint : m_overflowed) { m_resident[codepoint] = -1; }
+	m_overflowed.clear();
+
+	for (auto* vertex : m_misses) {
+		if (is_sentinel(vertex->uv)) { patch(*vertex); }
+	}
+
+	if (m_pending.empty()) { return; }
+	auto writes = std::vector<TextureStore::Write>{};
+	writes.reserve(m_pending.size());
+	auto const size = std::size_t(m_cell) * std::size_t(m_cell) * 4;
+	for (auto const& pending : m_pending) {
+		writes.push_back(TextureStore::Write{
+			.bitmap = Bitmap{.bytes = std::span{m_pixels}.subspan(pending.offset, size), .width = m_cell, .height = m_cell},
+			.offset = vk::Offset2D{pending.x, pending.y},
+		});
+	}
+	store->update(m_page_handle, writes);
+}
+
+void GlyphAtlas::release() {
+	if (m_released) { return; }
+	m_released = true;
+	for (auto& slot : m_slots) { slot.glyph = nullptr; }
+	m_font.ClearOutputData();
+	m_container.Clear();
+}
+
+auto GlyphAtlas::acquire_slot() -> Slot* {
+	if (m_stats.resident < m_slots.size()) { return &m_slots[m_stats.resident++]; }
+
+	auto* ret = static_cast<Slot*>(nullptr);
+	for (auto& slot : m_slots) {
+		if (slot.last_used < m_frame && (ret == nullptr || slot.last_used < ret->last_used)) { ret = &slot; }
+	}
+	if (ret == nullptr) { return nullptr; }
+
+	auto& evicted = *ret->glyph;
+	set_uvs(evicted, to_sentinel_rect(evicted.Codepoint));
+	m_resident[evicted.Codepoint] = -1;
+	ret->glyph = nullptr;
+	++m_stats.total_evicted;
+	return ret;
+}
+
+auto GlyphAtlas::rasterize(ImFontGlyph& glyph) -> bool {
+	auto* slot = acquire_slot();
+	if (slot == nullptr) { return false; }
+
+	auto const index = int(slot - m_slots.data());
+	auto const slot_size = m_cell + 1;
+	auto const x = (index % m_columns) * slot_size;
+	auto const y = grid_y_v + ((index / m_columns) * slot_size);
+	auto const width = int(glyph.X1 - glyph.X0);
+	auto const height = int(glyph.Y1 - glyph.Y0);
+
+	// the whole slot is written: no stale texels from an evicted glyph remain around this one.
+	auto const stride = std::size_t(m_cell) * 4;
+	auto const offset = m_pixels.size();
+	m_pixels.resize(offset + (stride * std::size_t(m_cell)));
+	auto* pixels = reinterpret_cast<unsigned char*>(m_pixels.data() + offset);
+	auto const stb_glyph = stbtt_FindGlyphIndex(&m_ttf->info, int(glyph.Codepoint));
+	stbtt_MakeGlyphBitmap(&m_ttf->info, pixels, width, height, int(stride), m_ttf->scale, m_ttf->scale, stb_glyph);
+	// expand coverage (at the start of each row) to white RGBA in place, right to left.
+	for (int row = 0; row < m_cell; ++row) {
+		auto* line = pixels + (std::size_t(row) * stride);
+		for (int column = m_cell - 1; column >= 0; --column) {
+			auto const alpha = (row < height && column < width) ? line[column] : 0;
+			auto* texel = line + (std::size_t(column) * 4);
+			texel[0] = texel[1] = texel[2] = 0xff;
+			texel[3] = alpha;
+		}
+	}
+	m_pending.push_back(Pending{.offset = offset, .x = x, .y = y});
+
+	auto const scale = m_container.TexUvScale;
+	set_uvs(glyph, ImVec4{float(x) * scale.x, float(y) * scale.y, float(x + width) * scale.x, float(y + height) * scale.y});
+	slot->glyph = &glyph;
+	slot->last_used = m_frame;
+	m_resident[glyph.Codepoint] = index;
+	++m_stats.total_rasterized;
+	return true;
+}
+
+void GlyphAtlas::mark_used(ImVec2 const uv) {
+	// rounded: quad corners lie on texel boundaries, and within [origin, origin + cell] of their slot.
+	auto const x = int(std::lround(uv.x * float(m_extent)));
+	auto const y = int(std::lround(uv.y * float(m_extent))) - grid_y_v;
+	if (y < 0) { return; }
+	auto const slot_size = m_cell + 1;
+	auto const column = x / slot_size;
+	auto const row = y / slot_size;
+	if (column >= m_columns || row >= m_rows) { return; }
+	m_slots[std::size_t((row * m_columns) + column)].last_used = m_frame;
+}
+
+void GlyphAtlas::patch(ImDrawVert& vertex) const {
+	auto const sentinel = decode(vertex.uv);
+	if (sentinel.codepoint >= m_resident.size()) { return; }
+	auto const index = m_resident[sentinel.codepoint];
+	if (index < 0) { return; }
+	auto const& glyph = *m_slots[std::size_t(index)].glyph;
+	vertex.uv = ImVec2{glyph.U0 + (sentinel.t.x * (glyph.U1 - glyph.U0)), glyph.V0 + (sentinel.t.y * (glyph.V1 - glyph.V0))};
+}
+} // namespace gvdi::detail
@@ -0,0 +1,88 @@
+#pragma once
+#include "gvdi/glyph_cache.hpp"
+#include "gvdi/texture.hpp"
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace gvdi::detail {
+class TextureStore;
+
+/// \brief Backing state of a GlyphCache: an ImFont with a placeholder glyph for every codepoint in its ranges,
+/// whose UVs lie outside [0, 1] (sampling a transparent corner texel) and encode the codepoint.
+/// resolve() finds placeholder vertices in a frame's draw data, rasterizes their glyphs into slots, and patches their UVs.
+class GlyphAtlas {
+  public:
+	GlyphAtlas(GlyphAtlas const&) = delete;
+	GlyphAtlas(GlyphAtlas&&) = delete;
+	auto operator=(GlyphAtlas const&) = delete;
+	auto operator=(GlyphAtlas&&) = delete;
+
+	/// \brief Throws if the font cannot be loaded, or if the atlas is too small for its glyphs.
+	explicit GlyphAtlas(std::shared_ptr<TextureStore> const& store, GlyphCacheCreateInfo const& create_info);
+	~GlyphAtlas();
+
+	[[nodiscard]] auto get_font() -> ImFont* { return is_valid() ? &m_font : nullptr; }
+	[[nodiscard]] auto get_stats() const -> GlyphCacheStats { return m_stats; }
+	[[nodiscard]] auto is_valid() const -> bool { return m_page.is_valid() && !m_released; }
+
+	/// \brief Rasterize glyphs referenced by a frame's draw data (of all viewports) that are not resident,
+	/// and patch the vertices referencing them.
+	/// Must be called after ImGui::Render() and before draw_data is rendered.
+	void resolve(std::span<ImDrawData* const> draw_data);
+	/// \brief Free all memory allocated through Dear ImGui, must be called before its context (and allocator) is destroyed.
+	void release();
+
+  private:
+	struct Slot {
+		std::uint64_t last_used{};
+		ImFontGlyph* glyph{};
+	};
+
+	// slot pixels in m_pixels, to be uploaded at (x, y).
+	struct Pending {
+		std::size_t offset{};
+		int x{};
+		int y{};
+	};
+
+	struct Font;
+
+	void load_glyphs(ImWchar const* ranges);
+	void write_band();
+	auto acquire_slot() -> Slot*;
+	auto rasterize(ImFontGlyph& glyph) -> bool;
+	void mark_used(ImVec2 uv);
+	void patch(ImDrawVert& vertex) const;
+
+	std::unique_ptr<Font> m_ttf;
+	std::weak_ptr<TextureStore> m_store;
+	Texture m_page{};
+	std::uint32_t m_page_handle{};
+
+	ImFontConfig m_config{};
+	ImFontAtlas m_container{};
+	ImFont m_font{};
+
+	int m_extent{};
+	int m_cell{};
+	int m_columns{};
+	int m_rows{};
+	std::vector<Slot> m_slots{};
+	// codepoint => index into m_slots, -1 if not resident.
+	std::vector<std::int32_t> m_resident{};
+
+	// per resolve().
+	std::vector<ImDrawVert*> m_misses{};
+	std::vector<std::byte> m_pixels{};
+	std::vector<Pending> m_pending{};
+	std::vector<unsigned> m_overflowed{};
+
+	std::uint64_t m_frame{};
+	GlyphCacheStats m_stats{};
+	bool m_released{};
+};
+} // namespace gvdi::detail
@@ -0,0 +1,115 @@
+#include "detail/gpu_memory.hpp"
+#include "gvdi/exception.hpp"
+#include <cassert>
+#include <utility>
+
+namespace gvdi::detail {
+auto find_memory_type(vk::PhysicalDeviceMemoryProperties const& properties, std::uint32_t const type_bits,
+					  vk::MemoryPropertyFlags const flags) -> std::optional<std::uint32_t> {
+	for (std::uint32_t index = 0; index < properties.memoryTypeCount; ++index) {
+		if ((type_bits & (1u << index)) == 0) { continue; }
+		if ((properties.memoryTypes.at(index).propertyFlags & flags) != flags) { continue; }
+		return index;
+	}
+	return {};
+}
+
+auto DeviceMemory::allocate(CreateInfo const& create_info, vk::MemoryRequirements const& requirements, vk::MemoryPropertyFlags const flags)
+	-> DeviceMemory {
+	assert(create_info.properties != nullptr);
+	auto const type_index = find_memory_type(*create_info.properties, requirements.memoryTypeBits, flags);
+	if (!type_index) { throw Exception{"DeviceMemory::allocate(): Failed to find suitable Vulkan memory type"}; }
+
+	auto mai = vk::MemoryAllocateInfo{};
+	mai.setAllocationSize(requirements.size).setMemoryTypeIndex(*type_index);
+
+	auto ret = DeviceMemory{};
+	ret.m_memory = create_info.device.allocateMemoryUnique(mai);
+	ret.m_size = requirements.size;
+	auto const type_flags = create_info.properties->memoryTypes.at(*type_index).propertyFlags;
+	if (type_flags & vk::MemoryPropertyFlagBits::eHostVisible) {
+		ret.m_mapped = create_info.device.mapMemory(*ret.m_memory, 0, VK_WHOLE_SIZE);
+		ret.m_host_coherent = static_cast<bool>(type_flags & vk::MemoryPropertyFlagBits::eHostCoherent);
+	}
+	ret.m_tracker = create_info.tracker;
+	ret.m_category = create_info.category;
+	if (ret.m_tracker != nullptr) { ret.m_tracker->add(ret.m_category, ret.m_size); }
+	return ret;
+}
+
+void DeviceMemory::swap(DeviceMemory& rhs) noexcept {
+	std::swap(m_memory, rhs.m_memory);
+	std::swap(m_size, rhs.m_size);
+	std::swap(m_mapped, rhs.m_mapped);
+	std::swap(m_host_coherent, rhs.m_host_coherent);
+	std::swap(m_tracker, rhs.m_tracker);
+	std::swap(m_category, rhs.m_category);
+}
+
+void DeviceMemory::release() {
+	if (!m_memory) { return; }
+	if (m_tracker != nullptr) { m_tracker->remove(m_category, m_size); }
+	// freeing implicitly unmaps.
+	m_memory.reset();
+	m_mapped = nullptr;
+}
+
+auto Buffer::create(DeviceMemory::CreateInfo const& create_info, vk::DeviceSize const size, vk::BufferUsageFlags const usage,
+					vk::MemoryPropertyFlags const flags) -> Buffer {
+	auto bci = vk::BufferCreateInfo{};
+	bci.setSize(size).setUsage(usage).setSharingMode(vk::SharingMode::eExclusive);
+	auto ret = Buffer{.buffer = create_info.device.createBufferUnique(bci), .size = size};
+	auto const requirements = create_info.device.getBufferMemoryRequirements(*ret.buffer);
+	auto preferred = flags;
+	if (flags & vk::MemoryPropertyFlagBits::eHostVisible) { preferred |= vk::MemoryPropertyFlagBits::eHostCoherent; }
+	if (find_memory_type(*create_info.properties, requirements.memoryTypeBits, preferred)) {
+		ret.memory = DeviceMemory::allocate(create_info, requirements, preferred);
+	} else {
+		ret.memory = DeviceMemory::allocate(create_info, requirements, flags);
+	}
+	create_info.device.bindBufferMemory(*ret.buffer, ret.memory.get(), 0);
+	return ret;
+}
+
+void Buffer::flush(vk::Device const device) const {
+	if (memory.get_mapped() == nullptr || memory.is_host_coherent()) { return; }
+	// whole size is always a valid range, irrespective of nonCoherentAtomSize.
+	auto const range = vk::MappedMemoryRange{memory.get(), 0, VK_WHOLE_SIZE};
+	auto const result = device.flushMappedMemoryRanges(1, &range);
+	if (result != vk::Result::eSuccess) { throw Exception{"Buffer::flush(): Failed to flush mapped Vulkan memory"}; }
+}
+
+void Buffer::invalidate(vk::Device const device) const {
+	if (memory.get_mapped() == nullptr || memory.is_host_coherent()) { return; }
+	auto const range = vk::MappedMemoryRange{memory.get(), 0, VK_WHOLE_SIZE};
+	auto const result = device.invalidateMappedMemoryRanges(1, &range);
+	if (result != vk::Result::eSuccess) { throw Exception{"Buffer::invalidate(): Failed to invalidate mapped Vulkan memory"}; }
+}
+
+auto Image::create(DeviceMemory::CreateInfo const& create_info, vk::Extent2D const extent, vk::Format const format,
+				   vk::ImageUsageFlags const usage, std::uint32_t const levels, vk::ImageAspectFlags const aspect) -> Image {
+	auto ici = vk::ImageCreateInfo{};
+	ici.setImageType(vk::ImageType::e2D)
+		.setFormat(format)
+		.setExtent(vk::Extent3D{extent.width, extent.height, 1})
+		.setMipLevels(levels)
+		.setArrayLayers(1)
+		.setSamples(vk::SampleCountFlagBits::e1)
+		.setTiling(vk::ImageTiling::eOptimal)
+		.setUsage(usage)
+		.setSharingMode(vk::SharingMode::eExclusive)
+		.setInitialLayout(vk::ImageLayout::eUndefined);
+	auto ret = Image{.image = create_info.device.createImageUnique(ici), .extent = extent, .format = format, .levels = levels};
+	auto const requirements = create_info.device.getImageMemoryRequirements(*ret.image);
+	ret.memory = DeviceMemory::allocate(create_info, requirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+	create_info.device.bindImageMemory(*ret.image, ret.memory.get(), 0);
+
+	auto ivci = vk::ImageViewCreateInfo{};
+	ivci.setImage(*ret.image)
+		.setViewType(vk::ImageViewType::e2D)
+		.setFormat(format)
+		.setSubresourceRange(vk::ImageSubresourceRange{aspect, 0, levels, 0, 1});
+	ret.view = create_info.device.createImageViewUnique(ivci);
+	return ret;
+}
+} // namespace gvdi::detail
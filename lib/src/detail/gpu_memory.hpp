@@ -0,0 +1,112 @@
+#pragma once
+#include "gvdi/gpu.hpp"
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace gvdi::detail {
+[[nodiscard]] auto find_memory_type(vk::PhysicalDeviceMemoryProperties const& properties, std::uint32_t type_bits,
+									vk::MemoryPropertyFlags flags) -> std::optional<std::uint32_t>;
+
+/// \brief Running totals of GPU memory allocated by gvdi, per category.
+class MemoryTracker {
+  public:
+	void add(gpu::MemoryCategory const category, std::uint64_t const bytes) { at(category) += bytes; }
+	void remove(gpu::MemoryCategory const category, std::uint64_t const bytes) { at(category) -= bytes; }
+	void set(gpu::MemoryCategory const category, std::uint64_t const bytes) { at(category) = bytes; }
+
+	[[nodiscard]] auto get_totals() const -> std::array<std::uint64_t, gpu::memory_category_count_v> const& { return m_totals; }
+
+  private:
+	auto at(gpu::MemoryCategory const category) -> std::uint64_t& { return m_totals.at(static_cast<std::size_t>(category)); }
+
+	std::array<std::uint64_t, gpu::memory_category_count_v> m_totals{};
+};
+
+/// \brief Device memory allocation, accounted against a MemoryTracker category for its lifetime.
+/// Host visible allocations are persistently mapped.
+class DeviceMemory {
+  public:
+	struct CreateInfo {
+		vk::Device device{};
+		vk::PhysicalDeviceMemoryProperties const* properties{};
+		MemoryTracker* tracker{};
+		gpu::MemoryCategory category{};
+	};
+
+	[[nodiscard]] static auto allocate(CreateInfo const& create_info, vk::MemoryRequirements const& requirements,
+									   vk::MemoryPropertyFlags flags) -> DeviceMemory;
+
+	DeviceMemory() = default;
+	DeviceMemory(DeviceMemory const&) = delete;
+	auto operator=(DeviceMemory const&) = delete;
+
+	DeviceMemory(DeviceMemory&& rhs) noexcept { swap(rhs); }
+	auto operator=(DeviceMemory&& rhs) noexcept -> DeviceMemory& {
+		if (&rhs != this) {
+			auto temp = std::move(rhs);
+			swap(temp);
+		}
+		return *this;
+	}
+
+	~DeviceMemory() { release(); }
+
+	[[nodiscard]] auto get() const -> vk::DeviceMemory { return *m_memory; }
+	[[nodiscard]] auto get_size() const -> vk::DeviceSize { return m_size; }
+	/// \returns Persistent mapping, null if not host visible.
+	[[nodiscard]] auto get_mapped() const -> void* { return m_mapped; }
+	[[nodiscard]] auto is_host_coherent() const -> bool { return m_host_coherent; }
+
+	explicit operator bool() const { return static_cast<bool>(m_memory); }
+
+  private:
+	void swap(DeviceMemory& rhs) noexcept;
+	void release();
+
+	vk::UniqueDeviceMemory m_memory{};
+	vk::DeviceSize m_size{};
+	void* m_mapped{};
+	bool m_host_coherent{};
+	MemoryTracker* m_tracker{};
+	gpu::MemoryCategory m_category{};
+};
+
+/// \brief Buffer with dedicated memory.
+struct Buffer {
+	/// \brief Prefers host coherent memory if flags contains eHostVisible.
+	[[nodiscard]] static auto create(DeviceMemory::CreateInfo const& create_info, vk::DeviceSize size, vk::BufferUsageFlags usage,
+									 vk::MemoryPropertyFlags flags) -> Buffer;
+
+	/// \brief Flush host writes, no-op for host coherent memory.
+	void flush(vk::Device device) const;
+	/// \brief Make device writes visible to the host, no-op for host coherent memory.
+	void invalidate(vk::Device device) const;
+
+	[[nodiscard]] auto get_mapped() const -> std::byte* { return static_cast<std::byte*>(memory.get_mapped()); }
+
+	explicit operator bool() const { return static_cast<bool>(buffer); }
+
+	vk::UniqueBuffer buffer{};
+	DeviceMemory memory{};
+	vk::DeviceSize size{};
+};
+
+/// \brief 2D image with dedicated device local memory and a view over all its mip levels.
+struct Image {
+	[[nodiscard]] static auto create(DeviceMemory::CreateInfo const& create_info, vk::Extent2D extent, vk::Format format,
+									 vk::ImageUsageFlags usage, std::uint32_t levels = 1,
+									 vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor) -> Image;
+
+	explicit operator bool() const { return static_cast<bool>(image); }
+
+	vk::UniqueImage image{};
+	DeviceMemory memory{};
+	vk::UniqueImageView view{};
+	vk::Extent2D extent{};
+	vk::Format format{};
+	std::uint32_t levels{};
+};
+} // namespace gvdi::detail
@@ -0,0 +1,86 @@
+#include "detail/imgui_heap.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace gvdi::detail {
+namespace {
+constexpr auto to_size_class(std::size_t const size) -> std::size_t {
+	if (size <= 16) { return 0; }
+	return std::min(std::size_t(std::bit_width(size - 1)) - 4, AllocStats::size_classes_v - 1);
+}
+} // namespace
+
+ImGuiHeap::~ImGuiHeap() {
+	for (auto* chunk : m_chunks) { std::free(chunk); } // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+auto ImGuiHeap::allocate(std::size_t const size, void* user_data) -> void* { return static_cast<ImGuiHeap*>(user_data)->do_allocate(size); }
+
+void ImGuiHeap::deallocate(void* ptr, void* user_data) { static_cast<ImGuiHeap*>(user_data)->do_deallocate(ptr); }
+
+void ImGuiHeap::next_frame() {
+	m_stats.frame_allocations = std::exchange(m_frame_allocations, 0);
+	m_stats.frame_bytes = std::exchange(m_frame_bytes, 0);
+}
+
+auto ImGuiHeap::do_allocate(std::size_t const size) -> void* {
+	auto const size_class = to_size_class(size);
+	auto* block = static_cast<std::byte*>(nullptr);
+	auto origin = heap_origin_v;
+	if (m_backend == ImGuiAllocator::Pooled && size_class < pool_count_v) {
+		block = pool_allocate(size_class);
+		origin = static_cast<std::uint32_t>(size_class);
+	} else {
+		block = static_cast<std::byte*>(std::malloc(sizeof(Header) + size)); // NOLINT(cppcoreguidelines-no-malloc)
+	}
+	if (block == nullptr) { return nullptr; }
+
+	new (block) Header{.size = size, .origin = origin};
+
+	++m_frame_allocations;
+	m_frame_bytes += size;
+	++m_stats.total_allocations;
+	++m_stats.histogram.at(size_class);
+	m_stats.live_bytes += size;
+	m_stats.peak_live_bytes = std::max(m_stats.peak_live_bytes, m_stats.live_bytes);
+
+	return block + sizeof(Header);
+}
+
+void ImGuiHeap::do_deallocate(void* ptr) {
+	if (ptr == nullptr) { return; }
+	auto* block = static_cast<std::byte*>(ptr) - sizeof(Header);
+	auto const& header = *std::launder(reinterpret_cast<Header const*>(block));
+
+	++m_stats.total_frees;
+	m_stats.live_bytes -= header.size;
+
+	if (header.origin == heap_origin_v) {
+		std::free(block); // NOLINT(cppcoreguidelines-no-malloc)
+		return;
+	}
+
+	auto& pool = m_pools.at(header.origin);
+	pool.free_list = new (block) FreeBlock{.next = pool.free_list};
+}
+
+auto ImGuiHeap::pool_allocate(std::size_t const index) -> std::byte* {
+	auto& pool = m_pools.at(index);
+	if (pool.free_list != nullptr) { return reinterpret_cast<std::byte*>(std::exchange(pool.free_list, pool.free_list->next)); }
+
+	auto const stride = sizeof(Header) + AllocStats::get_size_class_limit(index);
+	if (pool.cursor == nullptr || pool.cursor + stride > pool.end) {
+		auto* chunk = static_cast<std::byte*>(std::malloc(chunk_size_v)); // NOLINT(cppcoreguidelines-no-malloc)
+		if (chunk == nullptr) { return nullptr; }
+		m_chunks.push_back(chunk);
+		m_stats.pool_reserved_bytes += chunk_size_v;
+		pool.cursor = chunk;
+		pool.end = chunk + chunk_size_v;
+	}
+
+	return std::exchange(pool.cursor, pool.cursor + stride);
+}
+} // namespace gvdi::detail
@@ -0,0 +1,67 @@
+#pragma once
+#include "gvdi/options.hpp"
+#include "gvdi/stats.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Allocator installed into Dear ImGui, records AllocStats and optionally serves requests from size-class pools.
+/// Not thread-safe: Dear ImGui only allocates on the thread that owns its context.
+class ImGuiHeap {
+  public:
+	ImGuiHeap(ImGuiHeap const&) = delete;
+	ImGuiHeap(ImGuiHeap&&) = delete;
+	auto operator=(ImGuiHeap const&) = delete;
+	auto operator=(ImGuiHeap&&) = delete;
+
+	explicit ImGuiHeap() = default;
+	~ImGuiHeap();
+
+	/// \brief Signatures match ImGuiMemAllocFunc / ImGuiMemFreeFunc, user_data must point to an ImGuiHeap.
+	static auto allocate(std::size_t size, void* user_data) -> void*;
+	static void deallocate(void* ptr, void* user_data);
+
+	/// \brief Only affects subsequent allocations, existing blocks are returned to their origin.
+	void set_backend(ImGuiAllocator const backend) { m_backend = backend; }
+
+	/// \brief Close the current frame's counters.
+	void next_frame();
+
+	[[nodiscard]] auto get_stats() const -> AllocStats { return m_stats; }
+
+  private:
+	static constexpr std::size_t pool_count_v{AllocStats::size_classes_v - 1};
+	static constexpr std::uint32_t heap_origin_v{0xff};
+	static constexpr std::size_t chunk_size_v{64 * 1024};
+
+	struct alignas(16) Header {
+		std::size_t size;
+		std::uint32_t origin;
+	};
+
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	struct Pool {
+		FreeBlock* free_list{};
+		std::byte* cursor{};
+		std::byte* end{};
+	};
+
+	auto do_allocate(std::size_t size) -> void*;
+	void do_deallocate(void* ptr);
+
+	auto pool_allocate(std::size_t index) -> std::byte*;
+
+	ImGuiAllocator m_backend{ImGuiAllocator::Heap};
+	std::array<Pool, pool_count_v> m_pools{};
+	std::vector<std::byte*> m_chunks{};
+
+	AllocStats m_stats{};
+	std::uint64_t m_frame_allocations{};
+	std::uint64_t m_frame_bytes{};
+};
+} // namespace gvdi::detail
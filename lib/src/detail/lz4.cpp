@@ -0,0 +1,175 @@
+#include "detail/lz4.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gvdi::detail {
+namespace {
+// block format constraints: matches are at least 4 bytes, the last 5 bytes are literals,
+// and the last match starts at least 12 bytes before the end.
+constexpr std::size_t min_match_v{4};
+constexpr std::size_t last_literals_v{5};
+constexpr std::size_t match_margin_v{12};
+constexpr std::size_t max_offset_v{65535};
+constexpr std::uint32_t hash_bits_v{12};
+
+auto read_u32(std::byte const* ptr) -> std::uint32_t {
+	auto ret = std::uint32_t{};
+	std::memcpy(&ret, ptr, sizeof(ret));
+	return ret;
+}
+
+constexpr auto hash(std::uint32_t const sequence) -> std::uint32_t { return (sequence * 2654435761u) >> (32 - hash_bits_v); }
+
+class Writer {
+  public:
+	explicit Writer(std::byte* out) : m_out(out) {}
+
+	void put(std::size_t const value) { m_out[m_size++] = std::byte(value); }
+
+	// lengths >= 15 continue after the token: runs of 255 and a final byte < 255.
+	void put_length(std::size_t length) {
+		for (; length >= 255; length -= 255) { put(255); }
+		put(length);
+	}
+
+	void put_sequence(std::span<std::byte const> literals, std::size_t const offset, std::size_t const match) {
+		auto const extra_match = match - min_match_v;
+		put((std::min(literals.size(), std::size_t{15}) << 4) | std::min(extra_match, std::size_t{15}));
+		if (literals.size() >= 15) { put_length(literals.size() - 15); }
+		if (!literals.empty()) { std::memcpy(m_out + m_size, literals.data(), literals.size()); }
+		m_size += literals.size();
+		put(offset & 0xff);
+		put(offset >> 8);
+		if (extra_match >= 15) { put_length(extra_match - 15); }
+	}
+
+	void put_last(std::span<std::byte const> literals) {
+		put(std::min(literals.size(), std::size_t{15}) << 4);
+		if (literals.size() >= 15) { put_length(literals.size() - 15); }
+		if (!literals.empty()) { std::memcpy(m_out + m_size, literals.data(), literals.size()); }
+		m_size += literals.size();
+	}
+
+	[[nodiscard]] auto get_size() const -> std::size_t { return m_size; }
+
+  private:
+	std::byte* m_out{};
+	std::size_t m_size{};
+};
+
+class Reader {
+  public:
+	explicit Reader(std::span<std::byte const> in) : m_in(in) {}
+
+	[[nodiscard]] auto is_done() const -> bool { return m_index == m_in.size(); }
+	[[nodiscard]] auto remaining() const -> std::size_t { return m_in.size() - m_index; }
+
+	auto get(std::size_t& out) -> bool {
+		if (is_done()) { return false; }
+		out = std::size_t(m_in[m_index++]);
+		return true;
+	}
+
+	auto get_length(std::size_t& out) -> bool {
+		auto next = std::size_t{255};
+		while (next == 255) {
+			if (!get(next)) { return false; }
+			out += next;
+			// a corrupt run would otherwise overflow: no valid length exceeds the input size times 255.
+			if (out > m_in.size() * 255) { return false; }
+		}
+		return true;
+	}
+
+	auto take(std::size_t const count) -> std::byte const* {
+		auto const* ret = m_in.data() + m_index;
+		m_index += count;
+		return ret;
+	}
+
+  private:
+	std::span<std::byte const> m_in{};
+	std::size_t m_index{};
+};
+} // namespace
+
+void lz4_compress(std::span<std::byte const> const in, std::vector<std::byte>& out) {
+	out.resize(lz4_bound(in.size()));
+	auto writer = Writer{out.data()};
+	auto anchor = std::size_t{};
+
+	if (in.size() > match_margin_v) {
+		auto table = std::array<std::uint32_t, std::size_t{1} << hash_bits_v>{};
+		auto const* data = in.data();
+		auto const search_end = in.size() - match_margin_v;
+		auto const match_end = in.size() - last_literals_v;
+		auto index = std::size_t{};
+		while (index <= search_end) {
+			auto const sequence = read_u32(data + index);
+			auto& slot = table.at(hash(sequence));
+			auto candidate = std::size_t{slot};
+			slot = std::uint32_t(index);
+			if (candidate >= index || index - candidate > max_offset_v || read_u32(data + candidate) != sequence) {
+				// skip faster through incompressible data.
+				index += 1 + ((index - anchor) >> 6);
+				continue;
+			}
+
+			while (index > anchor && candidate > 0 && data[index - 1] == data[candidate - 1]) {
+				--index;
+				--candidate;
+			}
+			auto length = min_match_v;
+			while (index + length < match_end && data[index + length] == data[candidate + length]) { ++length; }
+
+			writer.put_sequence(in.subspan(anchor, index - anchor), index - candidate, length);
+			index += length;
+			anchor = index;
+		}
+	}
+
+	writer.put_last(in.subspan(anchor));
+	out.resize(writer.get_size());
+}
+
+auto lz4_decompress(std::span<std::byte const> const in, std::span<std::byte> const out) -> bool {
+	auto reader = Reader{in};
+	auto written = std::size_t{};
+	while (true) {
+		auto token = std::size_t{};
+		if (!reader.get(token)) { return false; }
+
+		auto literals = token >> 4;
+		if (literals == 15 && !reader.get_length(literals)) { return false; }
+		if (literals > reader.remaining() || literals > out.size() - written) { return false; }
+		if (literals > 0) { std::memcpy(out.data() + written, reader.take(literals), literals); }
+		written += literals;
+
+		// the last sequence has no match.
+		if (reader.is_done()) { return written == out.size(); }
+
+		auto low = std::size_t{};
+		auto high = std::size_t{};
+		if (!reader.get(low) || !reader.get(high)) { return false; }
+		auto const offset = low | (high << 8);
+		if (offset == 0 || offset > written) { return false; }
+
+		auto length = token & 15;
+		if (length == 15 && !reader.get_length(length)) { return false; }
+		length += min_match_v;
+		if (length > out.size() - written) { return false; }
+
+		auto* dst = out.data() + written;
+		auto const* src = dst - offset;
+		if (offset >= length) {
+			std::memcpy(dst, src, length);
+		} else {
+			// overlapping: repeats the last offset bytes.
+			for (std::size_t i = 0; i < length; ++i) { dst[i] = src[i]; }
+		}
+		written += length;
+	}
+}
+} // namespace gvdi::detail
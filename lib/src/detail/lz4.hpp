@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Upper bound of the size of compressing size bytes.
+[[nodiscard]] constexpr auto lz4_bound(std::size_t const size) -> std::size_t { return size + (size / 255) + 16; }
+
+/// \brief Compress in as a single LZ4 block (raw block format, no frame header) into out (replacing its contents).
+/// Greedy matching over a fixed size hash table: fast, with ratios close to the reference's default level.
+void lz4_compress(std::span<std::byte const> in, std::vector<std::byte>& out);
+
+/// \brief Decompress an LZ4 block into out, whose size must be exactly that of the uncompressed data.
+/// \returns false if in is malformed (never reads or writes out of bounds).
+[[nodiscard]] auto lz4_decompress(std::span<std::byte const> in, std::span<std::byte> out) -> bool;
+} // namespace gvdi::detail
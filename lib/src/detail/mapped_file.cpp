@@ -0,0 +1,73 @@
+#include "detail/mapped_file.hpp"
+#include "gvdi/exception.hpp"
+#include <format>
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gvdi::detail {
+#if defined(_WIN32)
+MappedFile::MappedFile(char const* path) {
+	auto* file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { throw Exception{std::format("MappedFile: Failed to open '{}'", path)}; }
+	auto size = LARGE_INTEGER{};
+	if (GetFileSizeEx(file, &size) == FALSE || size.QuadPart <= 0) {
+		CloseHandle(file);
+		throw Exception{std::format("MappedFile: Failed to get size of (or empty) '{}'", path)};
+	}
+	auto* mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	auto const* data = mapping == nullptr ? nullptr : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr) {
+		if (mapping != nullptr) { CloseHandle(mapping); }
+		CloseHandle(file);
+		throw Exception{std::format("MappedFile: Failed to map '{}'", path)};
+	}
+	m_data = static_cast<std::byte const*>(data);
+	m_size = static_cast<std::size_t>(size.QuadPart);
+	m_file = file;
+	m_mapping = mapping;
+}
+
+MappedFile::~MappedFile() {
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mapping);
+	CloseHandle(m_file);
+}
+#else
+MappedFile::MappedFile(char const* path) {
+	auto const fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) { throw Exception{std::format("MappedFile: Failed to open '{}'", path)}; }
+	struct stat info{};
+	if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+		close(fd);
+		throw Exception{std::format("MappedFile: Failed to get size of (or empty) '{}'", path)};
+	}
+	auto const size = static_cast<std::size_t>(info.st_size);
+	auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping keeps its own reference to the file.
+	close(fd);
+	if (data == MAP_FAILED) { throw Exception{std::format("MappedFile: Failed to map '{}'", path)}; }
+	// tiles are read in scattered rows: readahead mostly fetches unused pages.
+	posix_madvise(data, size, POSIX_MADV_RANDOM);
+	m_data = static_cast<std::byte const*>(data);
+	m_size = size;
+}
+
+MappedFile::~MappedFile() {
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+	munmap(const_cast<std::byte*>(m_data), m_size);
+}
+#endif
+} // namespace gvdi::detail
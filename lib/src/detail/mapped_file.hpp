@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <span>
+
+namespace gvdi::detail {
+/// \brief Read-only memory mapping of an entire file.
+/// Pages are faulted in on access: mapping a file larger than RAM is fine, only the bytes read are resident.
+class MappedFile {
+  public:
+	MappedFile(MappedFile const&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	auto operator=(MappedFile const&) = delete;
+	auto operator=(MappedFile&&) = delete;
+
+	/// \brief Throws on failure (or if the file is empty).
+	explicit MappedFile(char const* path);
+	~MappedFile();
+
+	[[nodiscard]] auto get_bytes() const -> std::span<std::byte const> { return {m_data, m_size}; }
+
+  private:
+	std::byte const* m_data{};
+	std::size_t m_size{};
+#if defined(_WIN32)
+	void* m_file{};
+	void* m_mapping{};
+#endif
+};
+} // namespace gvdi::detail
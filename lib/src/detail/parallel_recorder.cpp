@@ -0,0 +1,35 @@
+#include "detail/parallel_recorder.hpp"
+
+namespace gvdi::detail {
+ParallelRecorder::ParallelRecorder(vk::Device const device, std::uint32_t const queue_family, std::uint32_t const thread_count)
+	: m_device(device), m_pools(thread_count + 1), m_threads(thread_count) {
+	auto cpci = vk::CommandPoolCreateInfo{};
+	cpci.setQueueFamilyIndex(queue_family).setFlags(vk::CommandPoolCreateFlagBits::eTransient);
+	for (auto& pool : m_pools) { pool.pool = m_device.createCommandPoolUnique(cpci); }
+}
+
+void ParallelRecorder::next_frame() {
+	for (auto& pool : m_pools) {
+		if (pool.next == 0) { continue; }
+		m_device.resetCommandPool(*pool.pool);
+		pool.next = 0;
+	}
+}
+
+auto ParallelRecorder::begin(std::uint32_t const thread, vk::CommandBufferInheritanceInfo const& inheritance) -> vk::CommandBuffer {
+	// each thread only accesses its own pool: no synchronization required.
+	auto& pool = m_pools.at(thread);
+	if (pool.next == pool.buffers.size()) {
+		auto cbai = vk::CommandBufferAllocateInfo{};
+		cbai.setCommandPool(*pool.pool).setLevel(vk::CommandBufferLevel::eSecondary).setCommandBufferCount(1);
+		pool.buffers.push_back(m_device.allocateCommandBuffers(cbai).front());
+	}
+	auto const ret = pool.buffers[pool.next++];
+
+	auto cbbi = vk::CommandBufferBeginInfo{};
+	cbbi.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+		.setPInheritanceInfo(&inheritance);
+	ret.begin(cbbi);
+	return ret;
+}
+} // namespace gvdi::detail
@@ -0,0 +1,61 @@
+#pragma once
+#include "detail/thread_pool.hpp"
+#include <vulkan/vulkan.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Records secondary command buffers in parallel, using one transient command pool per thread.
+/// Command buffers are recycled every frame: allocations only occur when a thread needs more than ever before.
+class ParallelRecorder {
+  public:
+	explicit ParallelRecorder(vk::Device device, std::uint32_t queue_family, std::uint32_t thread_count);
+
+	[[nodiscard]] auto get_thread_count() const -> std::uint32_t { return m_threads.get_thread_count(); }
+
+	/// \brief Reset all pools, must be called once per frame after waiting for the previous one.
+	void next_frame();
+
+	/// \brief Begin a secondary command buffer on the calling thread, to be ended by the caller.
+	[[nodiscard]] auto begin_secondary(vk::CommandBufferInheritanceInfo const& inheritance) -> vk::CommandBuffer {
+		return begin(get_thread_count(), inheritance);
+	}
+
+	/// \brief Invoke func(index, command_buffer) for each inheritance in parallel, and wait for all invocations to return.
+	/// Recorded (and ended) secondary command buffers are written to out, in the same order as inheritances.
+	template <typename Func>
+	void record(std::span<vk::CommandBufferInheritanceInfo const> const inheritances, std::span<vk::CommandBuffer> const out, Func func) {
+		m_threads.for_each(inheritances.size(), [&](std::size_t const index, std::uint32_t const thread) {
+			auto const command_buffer = begin(thread, inheritances[index]);
+			func(index, command_buffer);
+			command_buffer.end();
+			out[index] = command_buffer;
+		});
+	}
+
+  private:
+	struct Pool {
+		vk::UniqueCommandPool pool{};
+		std::vector<vk::CommandBuffer> buffers{};
+		std::size_t next{};
+	};
+
+	auto begin(std::uint32_t thread, vk::CommandBufferInheritanceInfo const& inheritance) -> vk::CommandBuffer;
+
+	vk::Device m_device;
+	// one per worker thread, followed by one for the calling thread.
+	std::vector<Pool> m_pools{};
+	ThreadPool m_threads;
+};
+
+/// \brief Command buffer(s) for recording into the current render pass.
+struct PassContext {
+	vk::CommandBuffer primary{};
+	/// \brief If not null, the render pass was begun with secondary command buffer contents:
+	/// all commands must be recorded into secondaries (see ParallelRecorder) and executed in primary.
+	ParallelRecorder* recorder{};
+	vk::CommandBufferInheritanceInfo inheritance{};
+};
+} // namespace gvdi::detail
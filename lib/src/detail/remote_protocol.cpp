@@ -0,0 +1,189 @@
+#include "detail/remote_protocol.hpp"
+#include "detail/lz4.hpp"
+#include <algorithm>
+#include <bit>
+#include <format>
+
+namespace gvdi::detail {
+namespace {
+static_assert(sizeof(ImTextureID) <= sizeof(std::uint64_t));
+
+// serialized size of a RemoteDrawCmd (which is padded).
+constexpr std::size_t cmd_size_v{sizeof(ImVec4) + sizeof(std::uint64_t) + (3 * sizeof(std::uint32_t))};
+
+// 8 bytes at a time, with a splitmix64 finalizer: draw lists are hashed every frame.
+auto hash_bytes(std::span<std::byte const> bytes, std::uint64_t hash) -> std::uint64_t {
+	static constexpr std::uint64_t prime_v{0x9e3779b97f4a7c15};
+	hash ^= bytes.size() * prime_v;
+	auto word = std::uint64_t{};
+	for (; bytes.size() >= sizeof(word); bytes = bytes.subspan(sizeof(word))) {
+		std::memcpy(&word, bytes.data(), sizeof(word));
+		hash = std::rotl(hash ^ (word * 0xbf58476d1ce4e5b9), 27) * prime_v;
+	}
+	if (!bytes.empty()) {
+		word = {};
+		std::memcpy(&word, bytes.data(), bytes.size());
+		hash = std::rotl(hash ^ (word * 0xbf58476d1ce4e5b9), 27) * prime_v;
+	}
+	hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+	hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+	return hash ^ (hash >> 31);
+}
+
+auto to_remote_cmd(ImDrawCmd const& cmd) -> RemoteDrawCmd {
+	return RemoteDrawCmd{
+		.clip_rect = cmd.ClipRect,
+		.texture = to_remote_texture(cmd.GetTexID()),
+		.vtx_offset = cmd.VtxOffset,
+		.idx_offset = cmd.IdxOffset,
+		.elem_count = cmd.ElemCount,
+	};
+}
+
+auto to_bytes(RemoteDrawCmd const& cmd) -> std::array<std::byte, cmd_size_v> {
+	auto ret = std::array<std::byte, cmd_size_v>{};
+	auto* out = ret.data();
+	auto const put = [&out](auto const& value) {
+		std::memcpy(out, &value, sizeof(value));
+		out += sizeof(value);
+	};
+	put(cmd.clip_rect);
+	put(cmd.texture);
+	put(cmd.vtx_offset);
+	put(cmd.idx_offset);
+	put(cmd.elem_count);
+	return ret;
+}
+
+auto read_cmd(ByteReader& reader) -> RemoteDrawCmd {
+	auto ret = RemoteDrawCmd{};
+	ret.clip_rect = reader.read<ImVec4>();
+	ret.texture = reader.read<std::uint64_t>();
+	ret.vtx_offset = reader.read<std::uint32_t>();
+	ret.idx_offset = reader.read<std::uint32_t>();
+	ret.elem_count = reader.read<std::uint32_t>();
+	return ret;
+}
+
+template <typename Type>
+void read_array(ByteReader& reader, std::vector<Type>& out, std::uint32_t const count) {
+	auto const bytes = reader.read_bytes(std::size_t(count) * sizeof(Type));
+	out.resize(count);
+	if (count > 0) { std::memcpy(out.data(), bytes.data(), bytes.size()); }
+}
+
+auto is_valid(RemoteDrawList const& list, RemoteDrawCmd const& cmd) -> bool {
+	if (std::size_t(cmd.idx_offset) + cmd.elem_count > list.indices.size()) { return false; }
+	auto const indices = std::span{list.indices}.subspan(cmd.idx_offset, cmd.elem_count);
+	return std::ranges::all_of(indices, [&](ImDrawIdx const index) { return cmd.vtx_offset + std::size_t(index) < list.vertices.size(); });
+}
+
+auto is_valid(RemoteHeader const& header) -> bool {
+	if (header.raw_size > remote_max_message_v) { return false; }
+	if ((header.flags & RemoteHeader::compressed_v) == 0) { return header.size == header.raw_size; }
+	return header.size <= lz4_bound(header.raw_size);
+}
+} // namespace
+
+auto to_remote_texture(ImTextureID const id) -> std::uint64_t {
+	auto ret = std::uint64_t{};
+	std::memcpy(&ret, &id, sizeof(id));
+	return ret;
+}
+
+auto hash_draw_list(ImDrawList const& draw_list) -> std::uint64_t {
+	auto ret = hash_bytes(std::as_bytes(std::span{draw_list.VtxBuffer.Data, std::size_t(draw_list.VtxBuffer.Size)}), 0);
+	ret = hash_bytes(std::as_bytes(std::span{draw_list.IdxBuffer.Data, std::size_t(draw_list.IdxBuffer.Size)}), ret);
+	for (auto const& cmd : draw_list.CmdBuffer) {
+		if (cmd.UserCallback != nullptr) { continue; }
+		ret = hash_bytes(to_bytes(to_remote_cmd(cmd)), ret);
+	}
+	return ret;
+}
+
+void write_draw_list(ByteWriter& writer, ImDrawList const& draw_list) {
+	auto const cmd_count = std::ranges::count_if(draw_list.CmdBuffer, [](ImDrawCmd const& cmd) { return cmd.UserCallback == nullptr; });
+	writer.write(std::uint32_t(cmd_count));
+	writer.write(std::uint32_t(draw_list.VtxBuffer.Size));
+	writer.write(std::uint32_t(draw_list.IdxBuffer.Size));
+	for (auto const& cmd : draw_list.CmdBuffer) {
+		// user callbacks cannot be executed remotely.
+		if (cmd.UserCallback == nullptr) { writer.write_bytes(to_bytes(to_remote_cmd(cmd))); }
+	}
+	writer.write_bytes(std::as_bytes(std::span{draw_list.VtxBuffer.Data, std::size_t(draw_list.VtxBuffer.Size)}));
+	writer.write_bytes(std::as_bytes(std::span{draw_list.IdxBuffer.Data, std::size_t(draw_list.IdxBuffer.Size)}));
+}
+
+auto read_draw_list(ByteReader& reader) -> RemoteDrawList {
+	auto const cmd_count = reader.read<std::uint32_t>();
+	auto const vtx_count = reader.read<std::uint32_t>();
+	auto const idx_count = reader.read<std::uint32_t>();
+	auto ret = RemoteDrawList{};
+	if (cmd_count > reader.get_remaining() / cmd_size_v) { throw Exception{"Remote: Invalid draw list"}; }
+	ret.commands.reserve(cmd_count);
+	for (std::uint32_t i = 0; i < cmd_count; ++i) { ret.commands.push_back(read_cmd(reader)); }
+	read_array(reader, ret.vertices, vtx_count);
+	read_array(reader, ret.indices, idx_count);
+	for (auto const& cmd : ret.commands) {
+		if (!is_valid(ret, cmd)) { throw Exception{"Remote: Draw command out of range"}; }
+	}
+	return ret;
+}
+
+void write_event(ByteWriter& writer, RemoteEvent const& event) {
+	writer.write(event.type);
+	writer.write(event.ints);
+	writer.write(event.reals);
+}
+
+auto read_event(ByteReader& reader) -> RemoteEvent {
+	auto ret = RemoteEvent{};
+	ret.type = reader.read<RemoteEventType>();
+	if (std::uint8_t(ret.type) >= std::uint8_t(RemoteEventType::COUNT_)) {
+		throw Exception{std::format("Remote: Invalid event type {}", int(ret.type))};
+	}
+	ret.ints = reader.read<std::array<std::int32_t, 4>>();
+	ret.reals = reader.read<std::array<double, 2>>();
+	return ret;
+}
+
+auto exchange_remote_hello(Socket const& socket) -> bool {
+	auto const hello = RemoteHello{};
+	if (!socket.send(std::as_bytes(std::span{&hello, 1}))) { return false; }
+	auto peer = RemoteHello{};
+	if (!socket.receive(std::as_writable_bytes(std::span{&peer, 1}))) { return false; }
+	return peer == hello;
+}
+
+auto send_remote_message(Socket const& socket, RemoteMessage const type, std::span<std::byte const> payload, bool const compress,
+						 std::vector<std::byte>& scratch) -> std::size_t {
+	auto header = RemoteHeader{.type = type, .size = std::uint32_t(payload.size()), .raw_size = std::uint32_t(payload.size())};
+	if (compress) {
+		lz4_compress(payload, scratch);
+		if (scratch.size() < payload.size()) {
+			header.flags = RemoteHeader::compressed_v;
+			header.size = std::uint32_t(scratch.size());
+			payload = scratch;
+		}
+	}
+	if (!socket.send(std::as_bytes(std::span{&header, 1})) || !socket.send(payload)) { return 0; }
+	return sizeof(header) + payload.size();
+}
+
+auto receive_remote_message(Socket const& socket, std::vector<std::byte>& out, std::vector<std::byte>& scratch)
+	-> std::optional<RemoteHeader> {
+	auto header = RemoteHeader{};
+	if (!socket.receive(std::as_writable_bytes(std::span{&header, 1}))) { return {}; }
+	if (!is_valid(header)) { throw Exception{"Remote: Invalid message header"}; }
+
+	out.resize(header.raw_size);
+	if ((header.flags & RemoteHeader::compressed_v) == 0) {
+		if (!socket.receive(out)) { return {}; }
+		return header;
+	}
+	scratch.resize(header.size);
+	if (!socket.receive(scratch)) { return {}; }
+	if (!lz4_decompress(scratch, out)) { throw Exception{"Remote: Invalid compressed message"}; }
+	return header;
+}
+} // namespace gvdi::detail
@@ -0,0 +1,160 @@
+#pragma once
+#include "detail/socket.hpp"
+#include "gvdi/exception.hpp"
+#include <imgui.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Remote UI protocol, between an App streaming its UI (Options::remote_address) and a RemoteViewer.
+// Both ends send a RemoteHello on connection, then length prefixed messages (RemoteHeader + payload).
+// Values are written in native byte order: the hello's magic rejects peers of the other endianness.
+//
+// Frame payload (server -> viewer, LZ4 compressed):
+//   u32 texture count, each: u64 id, i32 width, i32 height, RGBA8 pixels.
+//   ImVec2 display position, display size, framebuffer scale.
+//   u32 draw list count, each: u64 hash, u8 reused, if not reused: u32 command / vertex / index counts,
+//   commands (ImVec4 clip rect, u64 texture, u32 vertex offset, u32 index offset, u32 element count), vertices, indices.
+// A reused draw list is identical to the one with the same hash in the previous frame sent.
+//
+// Event payload (viewer -> server, uncompressed): RemoteEvent.
+
+namespace gvdi::detail {
+inline constexpr std::uint32_t remote_magic_v{0x49445647}; // "GVDI"
+inline constexpr std::uint16_t remote_version_v{1};
+/// \brief Largest (uncompressed) message accepted.
+inline constexpr std::uint32_t remote_max_message_v{512u * 1024u * 1024u};
+
+struct RemoteHello {
+	std::uint32_t magic{remote_magic_v};
+	std::uint16_t version{remote_version_v};
+	std::uint8_t vertex_size{sizeof(ImDrawVert)};
+	std::uint8_t index_size{sizeof(ImDrawIdx)};
+
+	auto operator==(RemoteHello const&) const -> bool = default;
+};
+
+enum class RemoteMessage : std::uint16_t { Frame, Event };
+
+struct RemoteHeader {
+	static constexpr std::uint16_t compressed_v{1};
+
+	RemoteMessage type{};
+	std::uint16_t flags{};
+	/// \brief Size of the payload.
+	std::uint32_t size{};
+	/// \brief Size of the payload once decompressed.
+	std::uint32_t raw_size{};
+};
+
+enum class RemoteEventType : std::uint8_t {
+	WindowResize,	// ints: width, height.
+	WindowFocus,	// ints: focused.
+	Key,			// ints: key, scancode, action, mods.
+	Character,		// ints: codepoint.
+	CursorPosition, // reals: x, y.
+	CursorEnter,	// ints: entered.
+	MouseButton,	// ints: button, action, mods.
+	MouseScroll,	// reals: x, y.
+	COUNT_,
+};
+
+/// \brief EventListener callback forwarded by a RemoteViewer, with GLFW's values (actions, mods, etc).
+struct RemoteEvent {
+	RemoteEventType type{};
+	std::array<std::int32_t, 4> ints{};
+	std::array<double, 2> reals{};
+};
+
+struct RemoteDrawCmd {
+	ImVec4 clip_rect{};
+	std::uint64_t texture{};
+	std::uint32_t vtx_offset{};
+	std::uint32_t idx_offset{};
+	std::uint32_t elem_count{};
+};
+
+/// \brief Decoded ImDrawList, without user callbacks.
+struct RemoteDrawList {
+	std::vector<RemoteDrawCmd> commands{};
+	std::vector<ImDrawVert> vertices{};
+	std::vector<ImDrawIdx> indices{};
+};
+
+/// \brief Appends trivially copyable values to a byte buffer.
+class ByteWriter {
+  public:
+	explicit ByteWriter(std::vector<std::byte>& out) : m_out(out) {}
+
+	template <typename Type>
+		requires(std::is_trivially_copyable_v<Type>)
+	void write(Type const& value) {
+		write_bytes(std::as_bytes(std::span{&value, 1}));
+	}
+
+	void write_bytes(std::span<std::byte const> bytes) { m_out.insert(m_out.end(), bytes.begin(), bytes.end()); }
+
+  private:
+	std::vector<std::byte>& m_out;
+};
+
+/// \brief Reads trivially copyable values from a byte buffer, throws if it is too short.
+class ByteReader {
+  public:
+	explicit ByteReader(std::span<std::byte const> in) : m_in(in) {}
+
+	template <typename Type>
+		requires(std::is_trivially_copyable_v<Type>)
+	auto read() -> Type {
+		auto ret = Type{};
+		std::memcpy(&ret, read_bytes(sizeof(Type)).data(), sizeof(Type));
+		return ret;
+	}
+
+	auto read_bytes(std::size_t const count) -> std::span<std::byte const> {
+		if (count > m_in.size()) { throw Exception{"Remote: Truncated message"}; }
+		auto const ret = m_in.first(count);
+		m_in = m_in.subspan(count);
+		return ret;
+	}
+
+	[[nodiscard]] auto is_done() const -> bool { return m_in.empty(); }
+	/// \brief Bounds counts read from the message before allocating for them.
+	[[nodiscard]] auto get_remaining() const -> std::size_t { return m_in.size(); }
+
+  private:
+	std::span<std::byte const> m_in{};
+};
+
+[[nodiscard]] auto to_remote_texture(ImTextureID id) -> std::uint64_t;
+
+/// \brief Hash of the commands (including their textures) and geometry of draw_list.
+[[nodiscard]] auto hash_draw_list(ImDrawList const& draw_list) -> std::uint64_t;
+void write_draw_list(ByteWriter& writer, ImDrawList const& draw_list);
+/// \brief Throws if the list is malformed (eg indices out of range).
+[[nodiscard]] auto read_draw_list(ByteReader& reader) -> RemoteDrawList;
+
+void write_event(ByteWriter& writer, RemoteEvent const& event);
+/// \brief Throws if the event is malformed.
+[[nodiscard]] auto read_event(ByteReader& reader) -> RemoteEvent;
+
+/// \brief Send a hello and check the peer's.
+/// \returns false if the connection is closed, or if the peer is incompatible.
+[[nodiscard]] auto exchange_remote_hello(Socket const& socket) -> bool;
+
+/// \brief Send payload as a message, LZ4 compressed if compress is true (and it shrinks).
+/// scratch holds the compressed payload.
+/// \returns Bytes sent (including the header), 0 if the connection is closed.
+auto send_remote_message(Socket const& socket, RemoteMessage type, std::span<std::byte const> payload, bool compress,
+						 std::vector<std::byte>& scratch) -> std::size_t;
+/// \brief Block until a message has been received, and decompress its payload into out.
+/// scratch holds the compressed payload.
+/// \returns Header of the message, nullopt if the connection is closed. Throws if the message is malformed.
+[[nodiscard]] auto receive_remote_message(Socket const& socket, std::vector<std::byte>& out, std::vector<std::byte>& scratch)
+	-> std::optional<RemoteHeader>;
+} // namespace gvdi::detail
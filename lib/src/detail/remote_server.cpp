@@ -0,0 +1,225 @@
+#include "detail/remote_server.hpp"
+#include <chrono>
+#include <utility>
+
+namespace gvdi::detail {
+namespace {
+using namespace std::chrono_literals;
+
+// bounds how long the worker takes to notice a stop request while no viewer is connected.
+constexpr auto accept_timeout_v = 100ms;
+
+// keeps generations of the font atlas distinct from those of other textures (whose ids may be reused).
+constexpr auto font_generation_bit_v = std::uint64_t{1} << 63;
+} // namespace
+
+RemoteServer::RemoteServer(std::string_view const address, OnEvent on_event, GetTexture get_texture)
+	: m_on_event(std::move(on_event)), m_get_texture(std::move(get_texture)), m_listener(Socket::listen(address)) {
+	m_thread = std::jthread{[this](std::stop_token const& stop) { work(stop); }};
+}
+
+RemoteServer::~RemoteServer() {
+	m_thread.request_stop();
+	// unblock a send in progress, the receive thread is joined by the worker.
+	auto lock = std::scoped_lock{m_mutex};
+	if (m_socket != nullptr) { m_socket->shutdown(); }
+}
+
+auto RemoteServer::is_connected() const -> bool {
+	auto lock = std::scoped_lock{m_mutex};
+	return m_connection != 0;
+}
+
+void RemoteServer::publish(ImDrawData const& draw_data) {
+	auto connection = std::uint64_t{};
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		connection = m_connection;
+		if (connection != 0 && m_pending) {
+			++m_stats.frames_skipped;
+			return;
+		}
+	}
+
+	if (connection == 0) {
+		// nothing is mirrored without a viewer.
+		m_font = {};
+		m_font_texture = 0;
+		return;
+	}
+	if (connection != m_encoded_connection) {
+		// new viewer: has no draw lists or textures yet.
+		m_sent_lists.clear();
+		m_sent_textures.clear();
+		m_encoded_connection = connection;
+	}
+	sync_font_atlas();
+	encode(draw_data);
+
+	auto lock = std::scoped_lock{m_mutex};
+	// if the viewer changed meanwhile, the next frame is encoded afresh (see above).
+	if (connection != m_connection) { return; }
+	std::swap(m_frame, m_packet);
+	m_pending = true;
+	m_work_cv.notify_one();
+}
+
+auto RemoteServer::get_stats() const -> RemoteStats {
+	auto lock = std::scoped_lock{m_mutex};
+	return m_stats;
+}
+
+void RemoteServer::sync_font_atlas() {
+	auto& fonts = *ImGui::GetIO().Fonts;
+	auto const id = to_remote_texture(fonts.TexID);
+	// the backend creates the font texture lazily, and recreates it when fonts are rebuilt.
+	if (id == 0 || id == m_font_texture) { return; }
+	unsigned char* pixels{};
+	auto width = int{};
+	auto height = int{};
+	fonts.GetTexDataAsRGBA32(&pixels, &width, &height);
+	if (pixels == nullptr) { return; }
+	auto const bytes = std::as_bytes(std::span{pixels, std::size_t(width) * std::size_t(height) * 4});
+	m_font.pixels.assign(bytes.begin(), bytes.end());
+	m_font.width = width;
+	m_font.height = height;
+	m_font_texture = id;
+	++m_font_generation;
+}
+
+void RemoteServer::encode(ImDrawData const& draw_data) {
+	m_frame.clear();
+	auto writer = ByteWriter{m_frame};
+	write_textures(writer, draw_data);
+
+	writer.write(draw_data.DisplayPos);
+	writer.write(draw_data.DisplaySize);
+	writer.write(draw_data.FramebufferScale);
+
+	auto lists = std::uint64_t{};
+	auto lists_reused = std::uint64_t{};
+	m_next_lists.clear();
+	writer.write(std::uint32_t(draw_data.CmdListsCount));
+	for (auto const* draw_list : draw_data.CmdLists) {
+		auto const hash = hash_draw_list(*draw_list);
+		auto const reused = m_sent_lists.contains(hash);
+		writer.write(hash);
+		writer.write(std::uint8_t(reused ? 1 : 0));
+		if (reused) {
+			++lists_reused;
+		} else {
+			write_draw_list(writer, *draw_list);
+			++lists;
+		}
+		m_next_lists.insert(hash);
+	}
+	std::swap(m_sent_lists, m_next_lists);
+
+	auto lock = std::scoped_lock{m_mutex};
+	m_stats.lists += lists;
+	m_stats.lists_reused += lists_reused;
+	m_stats.textures += m_new_textures.size();
+}
+
+void RemoteServer::write_textures(ByteWriter& writer, ImDrawData const& draw_data) {
+	m_new_textures.clear();
+	for (auto const* draw_list : draw_data.CmdLists) {
+		for (auto const& cmd : draw_list->CmdBuffer) {
+			if (cmd.UserCallback != nullptr) { continue; }
+			auto const id = to_remote_texture(cmd.GetTexID());
+			auto texture = std::optional<MirroredTexture>{};
+			if (id != 0 && id == m_font_texture) {
+				texture = MirroredTexture{
+					.pixels = m_font.pixels,
+					.width = m_font.width,
+					.height = m_font.height,
+					.generation = font_generation_bit_v | m_font_generation,
+				};
+			} else {
+				texture = m_get_texture(cmd.GetTexID());
+			}
+			if (!texture) { continue; }
+			auto& sent = m_sent_textures[id];
+			if (sent == texture->generation) { continue; }
+			sent = texture->generation;
+			m_new_textures.emplace_back(id, *texture);
+		}
+	}
+
+	writer.write(std::uint32_t(m_new_textures.size()));
+	for (auto const& [id, texture] : m_new_textures) {
+		writer.write(id);
+		writer.write(std::int32_t(texture.width));
+		writer.write(std::int32_t(texture.height));
+		writer.write_bytes(texture.pixels);
+	}
+}
+
+void RemoteServer::work(std::stop_token const& stop) {
+	while (!stop.stop_requested()) {
+		auto const socket = m_listener.accept(accept_timeout_v);
+		if (!socket || !exchange_remote_hello(socket)) { continue; }
+		serve(stop, socket);
+	}
+}
+
+void RemoteServer::serve(std::stop_token const& stop, Socket const& socket) {
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_connection = ++m_stats.connections;
+		m_socket = &socket;
+		m_pending = false;
+		m_stats.connected = true;
+	}
+
+	auto receiver = std::jthread{[this, &socket] { receive(socket); }};
+	auto packet = std::vector<std::byte>{};
+	auto scratch = std::vector<std::byte>{};
+	while (true) {
+		{
+			auto lock = std::unique_lock{m_mutex};
+			m_work_cv.wait(lock, stop, [this] { return m_pending || !m_stats.connected; });
+			if (stop.stop_requested() || !m_stats.connected) { break; }
+			std::swap(packet, m_packet);
+			m_pending = false;
+		}
+		auto const sent = send_remote_message(socket, RemoteMessage::Frame, packet, true, scratch);
+		if (sent == 0) { break; }
+
+		auto lock = std::scoped_lock{m_mutex};
+		++m_stats.frames;
+		m_stats.raw_bytes += packet.size();
+		m_stats.wire_bytes += sent;
+	}
+
+	socket.shutdown();
+	receiver.join();
+
+	auto lock = std::scoped_lock{m_mutex};
+	m_connection = 0;
+	m_socket = nullptr;
+	m_pending = false;
+	m_stats.connected = false;
+}
+
+void RemoteServer::receive(Socket const& socket) {
+	auto message = std::vector<std::byte>{};
+	auto scratch = std::vector<std::byte>{};
+	try {
+		while (auto const header = receive_remote_message(socket, message, scratch)) {
+			if (header->type != RemoteMessage::Event) { continue; }
+			auto reader = ByteReader{message};
+			auto const event = read_event(reader);
+			m_on_event(event);
+			auto lock = std::scoped_lock{m_mutex};
+			++m_stats.events;
+		}
+	} catch (Exception const& /*e*/) {
+		// malformed input from the viewer: drop the connection.
+	}
+
+	auto lock = std::scoped_lock{m_mutex};
+	m_stats.connected = false;
+	m_work_cv.notify_one();
+}
+} // namespace gvdi::detail
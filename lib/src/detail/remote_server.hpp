@@ -0,0 +1,104 @@
+#pragma once
+#include "detail/remote_protocol.hpp"
+#include "detail/socket.hpp"
+#include "gvdi/remote.hpp"
+#include "gvdi/texture.hpp"
+#include <imgui.h>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Streams the UI of an App to one RemoteViewer at a time, see Options::remote_address.
+/// Frames are encoded on the calling (main) thread: draw lists identical to one in the previous frame sent are sent as their hash.
+/// They are compressed and sent on a worker thread, a frame is skipped if the previous one is still being sent.
+/// Textures are sent when first drawn on a connection, and again when they change: the font atlas is copied while a viewer is connected,
+/// other textures are looked up through GetTexture.
+class RemoteServer {
+  public:
+	/// \brief Called on a worker thread for each input event received.
+	using OnEvent = std::function<void(RemoteEvent const&)>;
+
+	/// \brief RGBA8 contents of a mirrored texture, generation changes whenever they do.
+	struct MirroredTexture {
+		std::span<std::byte const> pixels{};
+		int width{};
+		int height{};
+		std::uint64_t generation{};
+	};
+	/// \brief Called on the main thread for each texture drawn while a viewer is connected, returns nullopt if it is not mirrored.
+	using GetTexture = std::function<std::optional<MirroredTexture>(ImTextureID)>;
+
+	RemoteServer(RemoteServer const&) = delete;
+	RemoteServer(RemoteServer&&) = delete;
+	auto operator=(RemoteServer const&) = delete;
+	auto operator=(RemoteServer&&) = delete;
+
+	/// \brief Throws if address cannot be listened on.
+	explicit RemoteServer(std::string_view address, OnEvent on_event, GetTexture get_texture);
+	~RemoteServer();
+
+	/// \returns true if a viewer is connected: textures need to be mirrored only then.
+	[[nodiscard]] auto is_connected() const -> bool;
+	/// \returns Port listened on, if TCP (eg after listening on port 0).
+	[[nodiscard]] auto get_port() const -> std::uint16_t { return m_listener.get_port(); }
+
+	/// \brief Queue draw_data for the connected viewer (if any), must be called after ImGui::Render().
+	void publish(ImDrawData const& draw_data);
+
+	[[nodiscard]] auto get_stats() const -> RemoteStats;
+
+  private:
+	struct TextureCopy {
+		std::vector<std::byte> pixels{};
+		int width{};
+		int height{};
+	};
+
+	void sync_font_atlas();
+	void encode(ImDrawData const& draw_data);
+	void write_textures(ByteWriter& writer, ImDrawData const& draw_data);
+
+	void work(std::stop_token const& stop);
+	void serve(std::stop_token const& stop, Socket const& socket);
+	void receive(Socket const& socket);
+
+	OnEvent m_on_event{};
+	GetTexture m_get_texture{};
+	Socket m_listener{};
+
+	// main thread.
+	TextureCopy m_font{};
+	std::uint64_t m_font_texture{};
+	std::uint64_t m_font_generation{};
+	// state of the connected viewer, as of the last frame encoded.
+	std::uint64_t m_encoded_connection{};
+	std::unordered_map<std::uint64_t, std::uint64_t> m_sent_textures{};
+	std::unordered_set<std::uint64_t> m_sent_lists{};
+	std::unordered_set<std::uint64_t> m_next_lists{};
+	std::vector<std::pair<std::uint64_t, MirroredTexture>> m_new_textures{};
+	std::vector<std::byte> m_frame{};
+
+	mutable std::mutex m_mutex{};
+	std::condition_variable_any m_work_cv{};
+	// identifies the current connection, 0 if none.
+	std::uint64_t m_connection{};
+	Socket const* m_socket{};
+	std::vector<std::byte> m_packet{};
+	bool m_pending{};
+	RemoteStats m_stats{};
+
+	// declared last: joined before any other member is destroyed.
+	std::jthread m_thread{};
+};
+} // namespace gvdi::detail
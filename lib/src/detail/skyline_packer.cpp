@@ -0,0 +1,73 @@
+#include "detail/skyline_packer.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace gvdi::detail {
+SkylinePacker::SkylinePacker(int const width, int const height) : m_width(width), m_height(height) {
+	m_skyline.push_back(Node{.x = 0, .y = 0, .width = width});
+}
+
+auto SkylinePacker::insert(int const width, int const height) -> std::optional<Position> {
+	if (width <= 0 || height <= 0) { return {}; }
+
+	auto best_index = m_skyline.size();
+	auto best_top = std::numeric_limits<int>::max();
+	auto best_width = std::numeric_limits<int>::max();
+	auto best_y = 0;
+	for (std::size_t index = 0; index < m_skyline.size(); ++index) {
+		auto const y = fit(index, width, height);
+		if (!y) { continue; }
+		auto const top = *y + height;
+		if (top < best_top || (top == best_top && m_skyline[index].width < best_width)) {
+			best_index = index;
+			best_top = top;
+			best_width = m_skyline[index].width;
+			best_y = *y;
+		}
+	}
+	if (best_index == m_skyline.size()) { return {}; }
+
+	auto const ret = Position{.x = m_skyline[best_index].x, .y = best_y};
+	m_skyline.insert(m_skyline.begin() + std::ptrdiff_t(best_index), Node{.x = ret.x, .y = best_top, .width = width});
+
+	// shrink (or remove) the nodes now covered by the new one.
+	auto const right = ret.x + width;
+	for (auto index = best_index + 1; index < m_skyline.size();) {
+		auto& node = m_skyline[index];
+		if (node.x >= right) { break; }
+		auto const shrink = right - node.x;
+		if (node.width <= shrink) {
+			m_skyline.erase(m_skyline.begin() + std::ptrdiff_t(index));
+			continue;
+		}
+		node.x += shrink;
+		node.width -= shrink;
+		break;
+	}
+
+	// merge neighbours at the same height.
+	for (std::size_t index = 0; index + 1 < m_skyline.size();) {
+		if (m_skyline[index].y == m_skyline[index + 1].y) {
+			m_skyline[index].width += m_skyline[index + 1].width;
+			m_skyline.erase(m_skyline.begin() + std::ptrdiff_t(index + 1));
+			continue;
+		}
+		++index;
+	}
+
+	m_used_area += std::int64_t(width) * std::int64_t(height);
+	return ret;
+}
+
+auto SkylinePacker::fit(std::size_t index, int const width, int const height) const -> std::optional<int> {
+	if (m_skyline[index].x + width > m_width) { return {}; }
+	auto y = 0;
+	for (auto remain = width; remain > 0; ++index) {
+		// nodes span [0, m_width): the loop ends before index runs past the last.
+		y = std::max(y, m_skyline[index].y);
+		if (y + height > m_height) { return {}; }
+		remain -= m_skyline[index].width;
+	}
+	return y;
+}
+} // namespace gvdi::detail
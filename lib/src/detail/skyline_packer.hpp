@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Skyline rectangle packer (bottom-left): each rect is placed where its top edge is lowest, then where it wastes least.
+/// Space below the skyline is never reused: space freed by removals is only reclaimed by packing again from scratch.
+class SkylinePacker {
+  public:
+	struct Position {
+		int x{};
+		int y{};
+	};
+
+	explicit SkylinePacker(int width, int height);
+
+	[[nodiscard]] auto insert(int width, int height) -> std::optional<Position>;
+
+	[[nodiscard]] auto get_used_area() const -> std::int64_t { return m_used_area; }
+
+  private:
+	// top edge of a span of columns.
+	struct Node {
+		int x{};
+		int y{};
+		int width{};
+	};
+
+	[[nodiscard]] auto fit(std::size_t index, int width, int height) const -> std::optional<int>;
+
+	std::vector<Node> m_skyline{};
+	int m_width{};
+	int m_height{};
+	std::int64_t m_used_area{};
+};
+} // namespace gvdi::detail
@@ -0,0 +1,263 @@
+#include "detail/socket.hpp"
+#include "gvdi/exception.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace gvdi::detail {
+namespace {
+constexpr std::string_view unix_prefix_v{"unix:"};
+// never all interfaces: exposing the UI (and input) to the network must be explicit.
+constexpr std::string_view default_host_v{"127.0.0.1"};
+
+#if defined(_WIN32)
+using Native = SOCKET;
+using Length = int;
+constexpr Native invalid_native_v{INVALID_SOCKET};
+constexpr int shutdown_both_v{SD_BOTH};
+constexpr int send_flags_v{0};
+
+void init_sockets() {
+	// never cleaned up: the process may use sockets until it exits.
+	static auto const result = [] {
+		auto data = WSADATA{};
+		return WSAStartup(MAKEWORD(2, 2), &data);
+	}();
+	if (result != 0) { throw Exception{"Socket: Failed to initialize Winsock"}; }
+}
+
+void close_native(Native const socket) { closesocket(socket); }
+auto poll_native(pollfd& fd, int const timeout) -> int { return WSAPoll(&fd, 1, timeout); }
+auto is_interrupted() -> bool { return false; }
+#else
+using Native = int;
+using Length = socklen_t;
+constexpr Native invalid_native_v{-1};
+constexpr int shutdown_both_v{SHUT_RDWR};
+#if defined(MSG_NOSIGNAL)
+constexpr int send_flags_v{MSG_NOSIGNAL};
+#else
+constexpr int send_flags_v{0};
+#endif
+
+void init_sockets() {}
+void close_native(Native const socket) { ::close(socket); }
+auto poll_native(pollfd& fd, int const timeout) -> int { return ::poll(&fd, 1, timeout); }
+auto is_interrupted() -> bool { return errno == EINTR; }
+#endif
+
+void configure(Native const socket) {
+	auto const enable = 1;
+	auto const* value = reinterpret_cast<char const*>(&enable);
+	// input events and frames are small and latency sensitive. (Fails harmlessly for Unix domain sockets.)
+	setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, value, sizeof(enable));
+#if defined(SO_NOSIGPIPE)
+	setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, value, sizeof(enable));
+#endif
+}
+
+struct Endpoint {
+	std::string host{};
+	std::string port{};
+};
+
+auto to_endpoint(std::string_view const address) -> Endpoint {
+	auto const colon = address.rfind(':');
+	if (colon == std::string_view::npos || colon + 1 == address.size()) {
+		throw Exception{std::format("Socket: Invalid address '{}', expected 'host:port' or 'unix:path'", address)};
+	}
+	auto host = address.substr(0, colon);
+	if (host.size() >= 2 && host.front() == '[' && host.back() == ']') { host = host.substr(1, host.size() - 2); }
+	if (host.empty()) { host = default_host_v; }
+	return Endpoint{.host = std::string{host}, .port = std::string{address.substr(colon + 1)}};
+}
+
+auto open_tcp(std::string_view const address, bool const passive) -> Native {
+	auto const endpoint = to_endpoint(address);
+	auto hints = addrinfo{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* results{};
+	if (getaddrinfo(endpoint.host.c_str(), endpoint.port.c_str(), &hints, &results) != 0 || results == nullptr) {
+		throw Exception{std::format("Socket: Failed to resolve '{}'", address)};
+	}
+
+	auto ret = invalid_native_v;
+	for (auto const* info = results; info != nullptr && ret == invalid_native_v; info = info->ai_next) {
+		auto const socket = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+		if (socket == invalid_native_v) { continue; }
+		auto connected = false;
+		if (passive) {
+#if !defined(_WIN32)
+			auto const enable = 1;
+			setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+#endif
+			connected = ::bind(socket, info->ai_addr, Length(info->ai_addrlen)) == 0 && ::listen(socket, SOMAXCONN) == 0;
+		} else {
+			connected = ::connect(socket, info->ai_addr, Length(info->ai_addrlen)) == 0;
+		}
+		if (!connected) {
+			close_native(socket);
+			continue;
+		}
+		ret = socket;
+	}
+	freeaddrinfo(results);
+
+	if (ret == invalid_native_v) {
+		throw Exception{std::format("Socket: Failed to {} '{}'", passive ? "listen on" : "connect to", address)};
+	}
+	if (!passive) { configure(ret); }
+	return ret;
+}
+
+#if defined(_WIN32)
+auto open_unix(std::string_view const address, bool const /*passive*/) -> Native {
+	throw Exception{std::format("Socket: Unix domain sockets are not supported on Windows: '{}'", address)};
+}
+#else
+auto open_unix(std::string_view const address, bool const passive) -> Native {
+	auto const path = address.substr(unix_prefix_v.size());
+	auto name = sockaddr_un{};
+	name.sun_family = AF_UNIX;
+	if (path.empty() || path.size() >= sizeof(name.sun_path)) { throw Exception{std::format("Socket: Invalid path '{}'", address)}; }
+	std::memcpy(name.sun_path, path.data(), path.size());
+
+	auto const socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (socket == invalid_native_v) { throw Exception{std::format("Socket: Failed to create '{}'", address)}; }
+	auto const* sa = reinterpret_cast<sockaddr const*>(&name);
+	auto connected = false;
+	if (passive) {
+		// a stale socket from a previous run would fail bind() (other files are left alone, and fail it).
+		struct stat info{};
+		if (::lstat(name.sun_path, &info) == 0 && S_ISSOCK(info.st_mode)) { ::unlink(name.sun_path); }
+		connected = ::bind(socket, sa, sizeof(name)) == 0 && ::listen(socket, SOMAXCONN) == 0;
+	} else {
+		connected = ::connect(socket, sa, sizeof(name)) == 0;
+	}
+	if (!connected) {
+		close_native(socket);
+		throw Exception{std::format("Socket: Failed to {} '{}'", passive ? "listen on" : "connect to", address)};
+	}
+	if (!passive) { configure(socket); }
+	return socket;
+}
+#endif
+
+auto is_unix(std::string_view const address) -> bool { return address.starts_with(unix_prefix_v); }
+} // namespace
+
+Socket::Socket(Socket&& rhs) noexcept
+	: m_handle(std::exchange(rhs.m_handle, invalid_v)), m_unix_path(std::exchange(rhs.m_unix_path, {})) {}
+
+auto Socket::operator=(Socket&& rhs) noexcept -> Socket& {
+	if (&rhs != this) {
+		close();
+		m_handle = std::exchange(rhs.m_handle, invalid_v);
+		m_unix_path = std::exchange(rhs.m_unix_path, {});
+	}
+	return *this;
+}
+
+Socket::~Socket() { close(); }
+
+auto Socket::listen(std::string_view const address) -> Socket {
+	init_sockets();
+	if (!is_unix(address)) { return Socket{Handle(open_tcp(address, true))}; }
+	auto ret = Socket{Handle(open_unix(address, true))};
+	ret.m_unix_path = address.substr(unix_prefix_v.size());
+	return ret;
+}
+
+auto Socket::connect(std::string_view const address) -> Socket {
+	init_sockets();
+	if (!is_unix(address)) { return Socket{Handle(open_tcp(address, false))}; }
+	return Socket{Handle(open_unix(address, false))};
+}
+
+auto Socket::accept(std::chrono::milliseconds const timeout) const -> Socket {
+	if (!is_valid()) { return {}; }
+	auto fd = pollfd{};
+	fd.fd = Native(m_handle);
+	fd.events = POLLIN;
+	if (poll_native(fd, int(timeout.count())) <= 0) { return {}; }
+	auto const ret = ::accept(Native(m_handle), nullptr, nullptr);
+	if (ret == invalid_native_v) { return {}; }
+	configure(ret);
+	return Socket{Handle(ret)};
+}
+
+auto Socket::send(std::span<std::byte const> bytes) const -> bool {
+	while (!bytes.empty()) {
+		auto const size = int(std::min(bytes.size(), std::size_t(INT_MAX)));
+		auto const sent = ::send(Native(m_handle), reinterpret_cast<char const*>(bytes.data()), size, send_flags_v);
+		if (sent <= 0) {
+			if (sent < 0 && is_interrupted()) { continue; }
+			return false;
+		}
+		bytes = bytes.subspan(std::size_t(sent));
+	}
+	return true;
+}
+
+auto Socket::receive(std::span<std::byte> out) const -> bool {
+	while (!out.empty()) {
+		auto const size = int(std::min(out.size(), std::size_t(INT_MAX)));
+		auto const received = ::recv(Native(m_handle), reinterpret_cast<char*>(out.data()), size, 0);
+		if (received <= 0) {
+			if (received < 0 && is_interrupted()) { continue; }
+			return false;
+		}
+		out = out.subspan(std::size_t(received));
+	}
+	return true;
+}
+
+void Socket::shutdown() const {
+	if (!is_valid()) { return; }
+	::shutdown(Native(m_handle), shutdown_both_v);
+}
+
+auto Socket::get_port() const -> std::uint16_t {
+	if (!is_valid()) { return 0; }
+	auto name = sockaddr_storage{};
+	auto length = Length(sizeof(name));
+	if (::getsockname(Native(m_handle), reinterpret_cast<sockaddr*>(&name), &length) != 0) { return 0; }
+	switch (name.ss_family) {
+	case AF_INET: return ntohs(reinterpret_cast<sockaddr_in const*>(&name)->sin_port);
+	case AF_INET6: return ntohs(reinterpret_cast<sockaddr_in6 const*>(&name)->sin6_port);
+	default: return 0;
+	}
+}
+
+void Socket::close() {
+	if (!is_valid()) { return; }
+	close_native(Native(std::exchange(m_handle, invalid_v)));
+#if !defined(_WIN32)
+	if (!m_unix_path.empty()) { ::unlink(std::exchange(m_unix_path, {}).c_str()); }
+#endif
+}
+} // namespace gvdi::detail
@@ -0,0 +1,66 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace gvdi::detail {
+/// \brief Blocking stream socket: TCP ("host:port", an empty host is 127.0.0.1: other interfaces must be explicit, eg "0.0.0.0:port"),
+/// or Unix domain ("unix:path", not on Windows). Closed on destruction.
+/// send() and receive() may be called concurrently (from one thread each).
+class Socket {
+  public:
+	Socket() = default;
+
+	Socket(Socket const&) = delete;
+	auto operator=(Socket const&) = delete;
+
+	Socket(Socket&& rhs) noexcept;
+	auto operator=(Socket&& rhs) noexcept -> Socket&;
+
+	~Socket();
+
+	/// \brief Throws on failure.
+	[[nodiscard]] static auto listen(std::string_view address) -> Socket;
+	/// \brief Throws on failure.
+	[[nodiscard]] static auto connect(std::string_view address) -> Socket;
+
+	/// \brief Wait up to timeout for an incoming connection on a listening socket.
+	/// \returns Connected socket, invalid if none arrived in time.
+	[[nodiscard]] auto accept(std::chrono::milliseconds timeout) const -> Socket;
+
+	/// \returns false if the connection is closed (or broken).
+	auto send(std::span<std::byte const> bytes) const -> bool;
+	/// \brief Block until out has been filled.
+	/// \returns false if the connection is closed (or broken).
+	auto receive(std::span<std::byte> out) const -> bool;
+
+	/// \brief Unblock current and future send() / receive() calls, thread-safe.
+	void shutdown() const;
+
+	/// \returns Local port of a TCP socket (eg one listening on port 0), 0 for Unix domain sockets.
+	[[nodiscard]] auto get_port() const -> std::uint16_t;
+
+	[[nodiscard]] auto is_valid() const -> bool { return m_handle != invalid_v; }
+	explicit operator bool() const { return is_valid(); }
+
+  private:
+#if defined(_WIN32)
+	using Handle = std::uintptr_t;
+	static constexpr Handle invalid_v{~Handle{}};
+#else
+	using Handle = int;
+	static constexpr Handle invalid_v{-1};
+#endif
+
+	explicit Socket(Handle handle) : m_handle(handle) {}
+
+	void close();
+
+	Handle m_handle{invalid_v};
+	// unlinked when a listening Unix domain socket is closed.
+	std::string m_unix_path{};
+};
+} // namespace gvdi::detail
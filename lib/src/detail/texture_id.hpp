@@ -0,0 +1,15 @@
+#pragma once
+#include <imgui.h>
+#include <vulkan/vulkan.hpp>
+
+namespace gvdi::detail {
+// the Dear ImGui Vulkan backend interprets ImTextureID as VkDescriptorSet.
+
+[[nodiscard]] inline auto to_texture_id(vk::DescriptorSet const set) -> ImTextureID {
+	return reinterpret_cast<ImTextureID>(static_cast<VkDescriptorSet>(set)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+[[nodiscard]] inline auto to_descriptor_set(ImTextureID const id) -> vk::DescriptorSet {
+	return vk::DescriptorSet{reinterpret_cast<VkDescriptorSet>(id)}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+} // namespace gvdi::detail
@@ -0,0 +1,692 @@
+#include "detail/texture_store.hpp"
+#include "gvdi/exception.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <string_view>
+
+namespace gvdi::detail {
+namespace {
+// staging buffers up to this size are kept for reuse (eg, by frequent tile updates).
+constexpr vk::DeviceSize max_cached_staging_size_v{1024 * 1024};
+constexpr std::size_t max_cached_staging_count_v{32};
+
+void validate(Bitmap const& bitmap, std::string_view const function) {
+	if (bitmap.width <= 0 || bitmap.height <= 0) { throw Exception{std::format("{}: Invalid Bitmap size", function)}; }
+	auto const expected = std::size_t(bitmap.width) * std::size_t(bitmap.height) * 4;
+	if (bitmap.bytes.size() != expected) {
+		auto const actual = bitmap.bytes.size();
+		throw Exception{std::format("{}: Bitmap size mismatch: expected {} bytes, got {}", function, expected, actual)};
+	}
+}
+
+constexpr auto color_range(std::uint32_t const levels) -> vk::ImageSubresourceRange {
+	return vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, levels, 0, 1};
+}
+
+auto to_block_format(vk::Format const format) -> std::optional<BlockFormat> {
+	for (std::size_t index = 0; index < block_format_count_v; ++index) {
+		auto const ret = static_cast<BlockFormat>(index);
+		if (TextureStore::to_vk_format(ret) == format) { return ret; }
+	}
+	return {};
+}
+
+// bytes in the base level of an image of format, 0 if it cannot be mirrored.
+auto get_readback_size(vk::Format const format, vk::Extent2D const extent) -> std::size_t {
+	if (format == TextureStore::color_format_v) { return std::size_t(extent.width) * std::size_t(extent.height) * 4; }
+	auto const block = to_block_format(format);
+	if (!block || !can_decode(*block)) { return 0; }
+	auto const info = get_block_info(*block);
+	auto const columns = std::size_t((extent.width + info.width - 1) / info.width);
+	auto const rows = std::size_t((extent.height + info.height - 1) / info.height);
+	return columns * rows * std::size_t(info.bytes);
+}
+} // namespace
+
+auto TextureStore::to_vk_format(BlockFormat const format) -> vk::Format {
+	using enum vk::Format;
+	switch (format) {
+	case BlockFormat::Bc1: return eBc1RgbaUnormBlock;
+	case BlockFormat::Bc2: return eBc2UnormBlock;
+	case BlockFormat::Bc3: return eBc3UnormBlock;
+	case BlockFormat::Bc4: return eBc4UnormBlock;
+	case BlockFormat::Bc5: return eBc5UnormBlock;
+	case BlockFormat::Bc7: return eBc7UnormBlock;
+	case BlockFormat::Etc2Rgb: return eEtc2R8G8B8UnormBlock;
+	case BlockFormat::Etc2Rgba: return eEtc2R8G8B8A8UnormBlock;
+	case BlockFormat::Astc4x4: return eAstc4x4UnormBlock;
+	case BlockFormat::Astc6x6: return eAstc6x6UnormBlock;
+	case BlockFormat::Astc8x8: return eAstc8x8UnormBlock;
+	default: return eUndefined;
+	}
+}
+
+auto TextureStore::query_block_support(vk::PhysicalDevice const gpu, vk::PhysicalDeviceFeatures const& enabled) -> BlockSupport {
+	static constexpr auto required_v = vk::FormatFeatureFlagBits::eSampledImage | vk::FormatFeatureFlagBits::eSampledImageFilterLinear |
+									   vk::FormatFeatureFlagBits::eTransferDst;
+	auto ret = BlockSupport{};
+	for (std::size_t index = 0; index < ret.size(); ++index) {
+		auto const format = static_cast<BlockFormat>(index);
+		auto feature = enabled.textureCompressionBC;
+		if (format == BlockFormat::Etc2Rgb || format == BlockFormat::Etc2Rgba) { feature = enabled.textureCompressionETC2; }
+		if (format >= BlockFormat::Astc4x4) { feature = enabled.textureCompressionASTC_LDR; }
+		if (feature == vk::False) { continue; }
+		auto const properties = gpu.getFormatProperties(to_vk_format(format));
+		ret.at(index) = (properties.optimalTilingFeatures & required_v) == required_v;
+	}
+	return ret;
+}
+
+TextureStore::TextureStore(DeviceMemory::CreateInfo const& memory_info, std::uint32_t const buffering, vk::Format const depth_format,
+						   BlockSupport const& block_support)
+	: m_memory_info(memory_info), m_buffering(buffering), m_descriptors(memory_info.device), m_depth_format(depth_format),
+	  m_block_support(block_support) {
+	auto sci = vk::SamplerCreateInfo{};
+	sci.setMagFilter(vk::Filter::eLinear)
+		.setMinFilter(vk::Filter::eLinear)
+		.setMipmapMode(vk::SamplerMipmapMode::eLinear)
+		.setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+		.setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+		.setAddressModeW(vk::SamplerAddressMode::eClampToEdge)
+		.setMaxLod(VK_LOD_CLAMP_NONE);
+	m_sampler = m_memory_info.device.createSamplerUnique(sci);
+}
+
+auto TextureStore::create(Bitmap const& bitmap) -> std::uint32_t {
+	validate(bitmap, "TextureStore::create()");
+
+	auto const extent = vk::Extent2D{std::uint32_t(bitmap.width), std::uint32_t(bitmap.height)};
+	auto entry = create_image(extent);
+
+	auto region = vk::BufferImageCopy{};
+	region.setImageSubresource(vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1})
+		.setImageExtent(vk::Extent3D{extent.width, extent.height, 1});
+	m_uploads.push_back(Upload{
+		.image = *entry.image.image,
+		.staging = create_staging(bitmap.bytes),
+		.regions = {region},
+		.layout = vk::ImageLayout::eUndefined,
+		.levels = 1,
+	});
+
+	if (m_mirrored) { set_mirror(to_texture_id(entry.descriptor_set), extent, {bitmap.bytes.begin(), bitmap.bytes.end()}); }
+	return insert(std::move(entry));
+}
+
+auto TextureStore::create(CompressedBitmap const& bitmap) -> std::uint32_t {
+	if (bitmap.width <= 0 || bitmap.height <= 0 || bitmap.levels.empty()) {
+		throw Exception{"TextureStore::create(): Invalid CompressedBitmap size"};
+	}
+	auto const supported = is_supported(bitmap.format);
+	if (!supported && !can_decode(bitmap.format)) {
+		auto const name = to_string_view(bitmap.format);
+		throw Exception{std::format("TextureStore::create(): {} not supported by the GPU, and cannot be decoded", name)};
+	}
+
+	auto const levels = static_cast<std::uint32_t>(bitmap.levels.size());
+	auto const info = get_block_info(bitmap.format);
+	auto regions = std::vector<vk::BufferImageCopy>{};
+	auto size = vk::DeviceSize{};
+	for (std::uint32_t level = 0; level < levels; ++level) {
+		auto const width = std::max(bitmap.width >> level, 1);
+		auto const height = std::max(bitmap.height >> level, 1);
+		auto const blocks = std::size_t((width + info.width - 1) / info.width) * std::size_t((height + info.height - 1) / info.height);
+		if (bitmap.levels[level].size() != blocks * std::size_t(info.bytes)) {
+			throw Exception{std::format("TextureStore::create(): CompressedBitmap level {} size mismatch", level)};
+		}
+
+		auto region = vk::BufferImageCopy{};
+		region.setBufferOffset(size)
+			.setImageSubresource(vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1})
+			.setImageExtent(vk::Extent3D{std::uint32_t(width), std::uint32_t(height), 1});
+		regions.push_back(region);
+		// offsets remain multiples of the block (or texel) size.
+		size += supported ? bitmap.levels[level].size() : std::size_t(width) * std::size_t(height) * 4;
+	}
+
+	// unsupported formats are decoded straight into the staging buffer.
+	auto staging = acquire_staging(size);
+	for (std::uint32_t level = 0; level < levels; ++level) {
+		auto* dst = staging.get_mapped() + regions[level].bufferOffset;
+		auto const src = bitmap.levels[level];
+		if (supported) {
+			std::memcpy(dst, src.data(), src.size());
+		} else {
+			auto const extent = regions[level].imageExtent;
+			auto const out = std::span{dst, std::size_t(extent.width) * extent.height * 4};
+			decode_blocks(bitmap.format, src, int(extent.width), int(extent.height), out);
+		}
+	}
+	staging.flush(m_memory_info.device);
+
+	auto const extent = vk::Extent2D{std::uint32_t(bitmap.width), std::uint32_t(bitmap.height)};
+	auto entry = create_image(extent, supported ? to_vk_format(bitmap.format) : color_format_v, levels);
+	if (m_mirrored && (!supported || can_decode(bitmap.format))) {
+		// the base level is either already decoded at the start of staging, or decodable.
+		auto pixels = std::vector<std::byte>(std::size_t(extent.width) * std::size_t(extent.height) * 4);
+		if (supported) {
+			decode_blocks(bitmap.format, bitmap.levels.front(), bitmap.width, bitmap.height, pixels);
+		} else {
+			std::memcpy(pixels.data(), staging.get_mapped(), pixels.size());
+		}
+		set_mirror(to_texture_id(entry.descriptor_set), extent, std::move(pixels));
+	}
+	m_uploads.push_back(Upload{
+		.image = *entry.image.image,
+		.staging = std::move(staging),
+		.regions = std::move(regions),
+		.layout = vk::ImageLayout::eUndefined,
+		.levels = levels,
+	});
+	return insert(std::move(entry));
+}
+
+auto TextureStore::create(vk::Extent2D const extent) -> std::uint32_t {
+	if (extent.width == 0 || extent.height == 0) { throw Exception{"TextureStore::create(): Invalid extent"}; }
+	auto entry = create_image(extent);
+	m_uploads.push_back(Upload{.image = *entry.image.image, .layout = vk::ImageLayout::eUndefined, .levels = 1});
+	if (m_mirrored) {
+		auto pixels = std::vector<std::byte>(std::size_t(extent.width) * std::size_t(extent.height) * 4);
+		set_mirror(to_texture_id(entry.descriptor_set), extent, std::move(pixels));
+	}
+	return insert(std::move(entry));
+}
+
+auto TextureStore::create_render_target(vk::Extent2D const extent, bool const depth) -> std::uint32_t {
+	if (extent.width == 0 || extent.height == 0) { throw Exception{"TextureStore::create_render_target(): Invalid extent"}; }
+
+	static constexpr auto usage_v = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eColorAttachment;
+	auto entry = Entry{.image = Image::create(m_memory_info, extent, color_format_v, usage_v)};
+	auto attachments = std::array{*entry.image.view, vk::ImageView{}};
+	if (depth) {
+		entry.depth = Image::create(m_memory_info, extent, m_depth_format, vk::ImageUsageFlagBits::eDepthStencilAttachment, 1,
+									vk::ImageAspectFlagBits::eDepth);
+		attachments[1] = *entry.depth.view;
+	}
+
+	auto fci = vk::FramebufferCreateInfo{};
+	fci.setRenderPass(get_render_pass(depth))
+		.setAttachmentCount(depth ? 2 : 1)
+		.setPAttachments(attachments.data())
+		.setWidth(extent.width)
+		.setHeight(extent.height)
+		.setLayers(1);
+	entry.framebuffer = m_memory_info.device.createFramebufferUnique(fci);
+	write_descriptor_set(entry);
+
+	auto const ret = insert(std::move(entry));
+	m_renders.push_back(Render{.handle = ret, .initial = true});
+	return ret;
+}
+
+void TextureStore::destroy(std::uint32_t const handle) {
+	auto& entry = m_entries.at(handle);
+	if (!entry.image) { return; }
+	std::erase_if(m_uploads, [image = *entry.image.image](Upload const& u) { return u.image == image; });
+	std::erase_if(m_renders, [handle](Render const& r) { return r.handle == handle; });
+	release_mirror(to_texture_id(entry.descriptor_set));
+	m_retired.push_back(Retired{
+		.frame = m_frame,
+		.image = std::move(entry.image),
+		.depth = std::move(entry.depth),
+		.framebuffer = std::move(entry.framebuffer),
+		.descriptor_set = entry.descriptor_set,
+	});
+	entry = {};
+	m_free_handles.push_back(handle);
+}
+
+void TextureStore::update(std::uint32_t const handle, Bitmap const& bitmap, vk::Offset2D const offset) {
+	auto const write = Write{.bitmap = bitmap, .offset = offset};
+	update(handle, std::span{&write, 1});
+}
+
+void TextureStore::update(std::uint32_t const handle, std::span<Write const> const writes) {
+	if (writes.empty()) { return; }
+	auto const& entry = get_entry(handle);
+	if (entry.framebuffer) { throw Exception{std::format("TextureStore::update(): Render target: {}", handle)}; }
+	if (entry.image.format != color_format_v) { throw Exception{std::format("TextureStore::update(): Block compressed: {}", handle)}; }
+	// only the base level would be written: lower levels would keep stale contents.
+	if (entry.image.levels > 1) { throw Exception{std::format("TextureStore::update(): Mipmapped: {}", handle)}; }
+	auto const extent = entry.image.extent;
+	auto regions = std::vector<vk::BufferImageCopy>{};
+	regions.reserve(writes.size());
+	auto size = vk::DeviceSize{};
+	for (auto const& [bitmap, offset] : writes) {
+		validate(bitmap, "TextureStore::update()");
+		if (offset.x < 0 || offset.y < 0 || std::uint32_t(offset.x + bitmap.width) > extent.width ||
+			std::uint32_t(offset.y + bitmap.height) > extent.height) {
+			throw Exception{std::format("TextureStore::update(): Region out of bounds: {}", handle)};
+		}
+		auto region = vk::BufferImageCopy{};
+		region.setBufferOffset(size)
+			.setImageSubresource(vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1})
+			.setImageOffset(vk::Offset3D{offset.x, offset.y, 0})
+			.setImageExtent(vk::Extent3D{std::uint32_t(bitmap.width), std::uint32_t(bitmap.height), 1});
+		regions.push_back(region);
+		size += bitmap.bytes.size();
+	}
+
+	auto staging = acquire_staging(size);
+	for (std::size_t index = 0; index < writes.size(); ++index) {
+		auto const bytes = writes[index].bitmap.bytes;
+		std::memcpy(staging.get_mapped() + regions[index].bufferOffset, bytes.data(), bytes.size());
+	}
+	staging.flush(m_memory_info.device);
+
+	// uploads are recorded in order: a pending initial upload will have transitioned the image by then.
+	m_uploads.push_back(Upload{
+		.image = *entry.image.image,
+		.staging = std::move(staging),
+		.regions = std::move(regions),
+		.layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+		.levels = entry.image.levels,
+	});
+	write_mirror(to_texture_id(entry.descriptor_set), writes);
+}
+
+void TextureStore::set_mirrored(bool const mirrored) {
+	if (mirrored == m_mirrored) { return; }
+	m_mirrored = mirrored;
+	if (!mirrored) {
+		m_mirrors.clear();
+		for (auto& readback : m_readbacks) { retire(readback); }
+		m_readbacks.clear();
+		return;
+	}
+	for (auto const& entry : m_entries) {
+		if (!entry.image || entry.framebuffer) { continue; }
+		enqueue_readback(entry);
+	}
+}
+
+auto TextureStore::get_mirror(ImTextureID const id) const -> Mirror const* {
+	auto const it = m_mirrors.find(id);
+	if (it == m_mirrors.end()) { return nullptr; }
+	return &it->second;
+}
+
+auto TextureStore::get_texture_id(std::uint32_t const handle) const -> ImTextureID {
+	return to_texture_id(get_entry(handle).descriptor_set);
+}
+
+auto TextureStore::get_extent(std::uint32_t const handle) const -> vk::Extent2D { return get_entry(handle).image.extent; }
+
+auto TextureStore::get_render_pass(bool const depth) -> vk::RenderPass {
+	auto& ret = m_render_passes.at(depth ? 1 : 0);
+	if (!ret) { ret = create_render_pass(depth); }
+	return *ret;
+}
+
+auto TextureStore::get_render_pass(std::uint32_t const handle) -> vk::RenderPass {
+	auto const& entry = get_entry(handle);
+	if (!entry.framebuffer) { throw Exception{std::format("TextureStore: Not a render target: {}", handle)}; }
+	return get_render_pass(static_cast<bool>(entry.depth));
+}
+
+auto TextureStore::get_depth_format(std::uint32_t const handle) const -> vk::Format { return get_entry(handle).depth.format; }
+
+void TextureStore::enqueue_render(std::uint32_t const handle, ImVec4 const& clear, RenderTarget::Record record) {
+	if (!get_entry(handle).framebuffer) { throw Exception{std::format("TextureStore: Not a render target: {}", handle)}; }
+	m_renders.push_back(Render{.handle = handle, .clear = clear, .record = std::move(record)});
+}
+
+void TextureStore::next_frame() {
+	++m_frame;
+	complete_readbacks();
+	std::erase_if(m_retired, [this](Retired& r) {
+		if (m_frame < r.frame + m_buffering) { return false; }
+		m_descriptors.free(r.descriptor_set);
+		if (r.staging && r.staging.size <= max_cached_staging_size_v && m_staging_cache.size() < max_cached_staging_count_v) {
+			m_staging_cache.push_back(std::move(r.staging));
+		}
+		return true;
+	});
+}
+
+void TextureStore::record_uploads(vk::CommandBuffer const command_buffer) {
+	auto barrier = vk::ImageMemoryBarrier{};
+	barrier.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED).setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+	for (auto& upload : m_uploads) {
+		barrier.setImage(upload.image)
+			.setSubresourceRange(color_range(upload.levels))
+			.setOldLayout(upload.layout)
+			.setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+			.setSrcAccessMask(upload.layout == vk::ImageLayout::eUndefined ? vk::AccessFlags{} : vk::AccessFlagBits::eShaderRead)
+			.setDstAccessMask(vk::AccessFlagBits::eTransferWrite);
+		command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe | vk::PipelineStageFlagBits::eFragmentShader,
+									   vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+
+		if (upload.staging) {
+			command_buffer.copyBufferToImage(*upload.staging.buffer, upload.image, vk::ImageLayout::eTransferDstOptimal, upload.regions);
+		} else {
+			command_buffer.clearColorImage(upload.image, vk::ImageLayout::eTransferDstOptimal, vk::ClearColorValue{},
+										   color_range(upload.levels));
+		}
+
+		barrier.setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+			.setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+			.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+			.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+		command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {},
+									   barrier);
+
+		// staging buffers must outlive the command buffer.
+		if (upload.staging) { m_retired.push_back(Retired{.frame = m_frame, .staging = std::move(upload.staging)}); }
+	}
+	m_uploads.clear();
+
+	// after uploads: readbacks see their results.
+	record_readbacks(command_buffer);
+}
+
+void TextureStore::record_readbacks(vk::CommandBuffer const command_buffer) {
+	auto barrier = vk::ImageMemoryBarrier{};
+	barrier.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+		.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+		.setSubresourceRange(color_range(1));
+	auto recorded = false;
+	for (auto& readback : m_readbacks) {
+		if (readback.recorded) { continue; }
+		barrier.setImage(readback.image)
+			.setOldLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+			.setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+			.setSrcAccessMask(vk::AccessFlagBits::eShaderRead)
+			.setDstAccessMask(vk::AccessFlagBits::eTransferRead);
+		command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eFragmentShader, vk::PipelineStageFlagBits::eTransfer, {}, {}, {},
+									   barrier);
+
+		auto region = vk::BufferImageCopy{};
+		region.setImageSubresource(vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1})
+			.setImageExtent(vk::Extent3D{readback.extent.width, readback.extent.height, 1});
+		command_buffer.copyImageToBuffer(readback.image, vk::ImageLayout::eTransferSrcOptimal, *readback.buffer.buffer, region);
+
+		barrier.setOldLayout(vk::ImageLayout::eTransferSrcOptimal)
+			.setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+			.setSrcAccessMask({})
+			.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+		command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {},
+									   barrier);
+
+		readback.frame = m_frame;
+		readback.recorded = true;
+		readback.stale = false;
+		recorded = true;
+	}
+	if (!recorded) { return; }
+
+	auto const host_read = vk::MemoryBarrier{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead};
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, host_read, {}, {});
+}
+
+void TextureStore::complete_readbacks() {
+	std::erase_if(m_readbacks, [this](Readback& readback) {
+		if (!readback.recorded || m_frame < readback.frame + m_buffering) { return false; }
+		if (readback.stale) {
+			readback.recorded = false;
+			return false;
+		}
+
+		readback.buffer.invalidate(m_memory_info.device);
+		auto const source = std::span{readback.buffer.get_mapped(), get_readback_size(readback.format, readback.extent)};
+		auto pixels = std::vector<std::byte>(std::size_t(readback.extent.width) * std::size_t(readback.extent.height) * 4);
+		if (readback.format == color_format_v) {
+			std::memcpy(pixels.data(), source.data(), pixels.size());
+		} else {
+			auto const width = int(readback.extent.width);
+			auto const height = int(readback.extent.height);
+			decode_blocks(*to_block_format(readback.format), source, width, height, pixels);
+		}
+		set_mirror(readback.id, readback.extent, std::move(pixels));
+		return true;
+	});
+}
+
+void TextureStore::enqueue_readback(Entry const& entry) {
+	auto const size = get_readback_size(entry.image.format, entry.image.extent);
+	if (size == 0) { return; }
+	static constexpr auto usage_v = vk::BufferUsageFlagBits::eTransferDst;
+	m_readbacks.push_back(Readback{
+		.id = to_texture_id(entry.descriptor_set),
+		.image = *entry.image.image,
+		.extent = entry.image.extent,
+		.format = entry.image.format,
+		.buffer = Buffer::create(m_memory_info, size, usage_v, vk::MemoryPropertyFlagBits::eHostVisible),
+	});
+}
+
+void TextureStore::set_mirror(ImTextureID const id, vk::Extent2D const extent, std::vector<std::byte> pixels) {
+	m_mirrors[id] = Mirror{.pixels = std::move(pixels), .extent = extent, .generation = ++m_mirror_generation};
+}
+
+void TextureStore::write_mirror(ImTextureID const id, std::span<Write const> const writes) {
+	for (auto& readback : m_readbacks) {
+		if (readback.id == id && readback.recorded) { readback.stale = true; }
+	}
+	auto const it = m_mirrors.find(id);
+	if (it == m_mirrors.end()) { return; }
+
+	auto& mirror = it->second;
+	auto const stride = std::size_t(mirror.extent.width) * 4;
+	for (auto const& [bitmap, offset] : writes) {
+		auto const row = std::size_t(bitmap.width) * 4;
+		auto* dst = mirror.pixels.data() + (std::size_t(offset.y) * stride) + (std::size_t(offset.x) * 4);
+		for (int y = 0; y < bitmap.height; ++y) {
+			std::memcpy(dst + (std::size_t(y) * stride), bitmap.bytes.data() + (std::size_t(y) * row), row);
+		}
+	}
+	mirror.generation = ++m_mirror_generation;
+}
+
+void TextureStore::release_mirror(ImTextureID const id) {
+	m_mirrors.erase(id);
+	std::erase_if(m_readbacks, [this, id](Readback& readback) {
+		if (readback.id != id) { return false; }
+		retire(readback);
+		return true;
+	});
+}
+
+void TextureStore::retire(Readback& readback) {
+	// the GPU may still be writing into a recorded readback's buffer.
+	if (readback.recorded) { m_retired.push_back(Retired{.frame = m_frame, .readback = std::move(readback.buffer)}); }
+}
+
+void TextureStore::record_renders(vk::CommandBuffer const command_buffer, ParallelRecorder* recorder) {
+	if (recorder != nullptr && m_renders.size() > 1) {
+		record_renders(command_buffer, *recorder);
+		return;
+	}
+
+	// indexed: record callbacks may enqueue further renders.
+	for (std::size_t index = 0; index < m_renders.size(); ++index) {
+		auto const render = std::move(m_renders[index]);
+		auto const target = get_target(render.handle);
+		begin_render_pass(command_buffer, render, target, vk::SubpassContents::eInline);
+		if (render.record) { record_render(command_buffer, render, target); }
+		command_buffer.endRenderPass();
+	}
+	m_renders.clear();
+}
+
+void TextureStore::record_renders(vk::CommandBuffer const command_buffer, ParallelRecorder& recorder) {
+	m_inheritances.clear();
+	for (auto const& render : m_renders) {
+		auto const target = get_target(render.handle);
+		m_inheritances.emplace_back(target.render_pass, 0, target.framebuffer);
+	}
+	m_secondaries.resize(m_renders.size());
+
+	// record callbacks are invoked concurrently, and are not permitted to enqueue further renders.
+	recorder.record(m_inheritances, m_secondaries, [this](std::size_t const index, vk::CommandBuffer const secondary) {
+		auto const& render = m_renders[index];
+		if (render.record) { record_render(secondary, render, get_target(render.handle)); }
+	});
+
+	// executed in order of submission.
+	for (std::size_t index = 0; index < m_renders.size(); ++index) {
+		auto const& render = m_renders[index];
+		begin_render_pass(command_buffer, render, get_target(render.handle), vk::SubpassContents::eSecondaryCommandBuffers);
+		command_buffer.executeCommands(m_secondaries[index]);
+		command_buffer.endRenderPass();
+	}
+	m_renders.clear();
+}
+
+void TextureStore::discard_renders() {
+	std::erase_if(m_renders, [](Render const& r) { return !r.initial; });
+}
+
+auto TextureStore::get_target(std::uint32_t const handle) const -> Target {
+	auto const& entry = get_entry(handle);
+	auto const depth = static_cast<bool>(entry.depth);
+	return Target{
+		.render_pass = *m_render_passes.at(depth ? 1 : 0),
+		.framebuffer = *entry.framebuffer,
+		.extent = entry.image.extent,
+		.depth = depth,
+	};
+}
+
+void TextureStore::begin_render_pass(vk::CommandBuffer const command_buffer, Render const& render, Target const& target,
+									 vk::SubpassContents const contents) {
+	auto const clear_values = std::array<vk::ClearValue, 2>{
+		vk::ClearColorValue{render.clear.x, render.clear.y, render.clear.z, render.clear.w},
+		vk::ClearDepthStencilValue{1.0f, 0},
+	};
+	auto rpbi = vk::RenderPassBeginInfo{};
+	rpbi.setRenderPass(target.render_pass)
+		.setFramebuffer(target.framebuffer)
+		.setRenderArea(vk::Rect2D{{}, target.extent})
+		.setClearValueCount(target.depth ? 2 : 1)
+		.setPClearValues(clear_values.data());
+	command_buffer.beginRenderPass(rpbi, contents);
+}
+
+void TextureStore::record_render(vk::CommandBuffer const command_buffer, Render const& render, Target const& target) {
+	auto const viewport = vk::Viewport{0.0f, 0.0f, float(target.extent.width), float(target.extent.height), 0.0f, 1.0f};
+	command_buffer.setViewport(0, viewport);
+	command_buffer.setScissor(0, vk::Rect2D{{}, target.extent});
+	render.record(OffscreenPass{
+		.command_buffer = static_cast<VkCommandBuffer>(command_buffer),
+		.render_pass = static_cast<VkRenderPass>(target.render_pass),
+		.extent = static_cast<VkExtent2D>(target.extent),
+	});
+}
+
+auto TextureStore::get_entry(std::uint32_t const handle) const -> Entry const& {
+	auto const& ret = m_entries.at(handle);
+	if (!ret.image) { throw Exception{std::format("TextureStore: Invalid handle: {}", handle)}; }
+	return ret;
+}
+
+auto TextureStore::create_image(vk::Extent2D const extent, vk::Format const format, std::uint32_t const levels) -> Entry {
+	// transfer source: for readbacks of mirrors.
+	static constexpr auto usage_v =
+		vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc;
+	auto ret = Entry{.image = Image::create(m_memory_info, extent, format, usage_v, levels)};
+	write_descriptor_set(ret);
+	return ret;
+}
+
+auto TextureStore::acquire_staging(vk::DeviceSize const size) -> Buffer {
+	// smallest cached buffer that fits.
+	auto best = m_staging_cache.end();
+	for (auto it = m_staging_cache.begin(); it != m_staging_cache.end(); ++it) {
+		if (it->size >= size && (best == m_staging_cache.end() || it->size < best->size)) { best = it; }
+	}
+	if (best == m_staging_cache.end()) {
+		static constexpr auto usage_v = vk::BufferUsageFlagBits::eTransferSrc;
+		return Buffer::create(m_memory_info, size, usage_v, vk::MemoryPropertyFlagBits::eHostVisible);
+	}
+	auto ret = std::move(*best);
+	m_staging_cache.erase(best);
+	return ret;
+}
+
+auto TextureStore::create_staging(std::span<std::byte const> const bytes) -> Buffer {
+	auto ret = acquire_staging(bytes.size());
+	std::memcpy(ret.get_mapped(), bytes.data(), bytes.size());
+	ret.flush(m_memory_info.device);
+	return ret;
+}
+
+auto TextureStore::create_render_pass(bool const depth) const -> vk::UniqueRenderPass {
+	auto attachments = std::array<vk::AttachmentDescription, 2>{};
+	// contents are cleared on every render: previous layout is irrelevant.
+	attachments[0]
+		.setFormat(color_format_v)
+		.setSamples(vk::SampleCountFlagBits::e1)
+		.setLoadOp(vk::AttachmentLoadOp::eClear)
+		.setStoreOp(vk::AttachmentStoreOp::eStore)
+		.setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
+		.setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
+		.setInitialLayout(vk::ImageLayout::eUndefined)
+		.setFinalLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+	attachments[1]
+		.setFormat(m_depth_format)
+		.setSamples(vk::SampleCountFlagBits::e1)
+		.setLoadOp(vk::AttachmentLoadOp::eClear)
+		.setStoreOp(vk::AttachmentStoreOp::eDontCare)
+		.setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
+		.setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
+		.setInitialLayout(vk::ImageLayout::eUndefined)
+		.setFinalLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
+
+	auto const color_ref = vk::AttachmentReference{0, vk::ImageLayout::eColorAttachmentOptimal};
+	auto const depth_ref = vk::AttachmentReference{1, vk::ImageLayout::eDepthStencilAttachmentOptimal};
+	auto subpass = vk::SubpassDescription{};
+	subpass.setPipelineBindPoint(vk::PipelineBindPoint::eGraphics).setColorAttachments(color_ref);
+	if (depth) { subpass.setPDepthStencilAttachment(&depth_ref); }
+
+	static constexpr auto attachment_stages_v = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+												vk::PipelineStageFlagBits::eEarlyFragmentTests |
+												vk::PipelineStageFlagBits::eLateFragmentTests;
+	auto dependencies = std::array<vk::SubpassDependency, 2>{};
+	// previous sampling (WAR) and attachment writes (WAW) must complete before this render writes.
+	dependencies[0]
+		.setSrcSubpass(VK_SUBPASS_EXTERNAL)
+		.setDstSubpass(0)
+		.setSrcStageMask(vk::PipelineStageFlagBits::eFragmentShader | attachment_stages_v)
+		.setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite)
+		.setDstStageMask(attachment_stages_v)
+		.setDstAccessMask(vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentRead |
+						  vk::AccessFlagBits::eDepthStencilAttachmentWrite);
+	// color writes must be visible to fragment shaders sampling the target (ImGui pass).
+	dependencies[1]
+		.setSrcSubpass(0)
+		.setDstSubpass(VK_SUBPASS_EXTERNAL)
+		.setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput)
+		.setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite)
+		.setDstStageMask(vk::PipelineStageFlagBits::eFragmentShader)
+		.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+
+	auto rpci = vk::RenderPassCreateInfo{};
+	rpci.setAttachmentCount(depth ? 2 : 1).setPAttachments(attachments.data()).setSubpasses(subpass).setDependencies(dependencies);
+	return m_memory_info.device.createRenderPassUnique(rpci);
+}
+
+void TextureStore::write_descriptor_set(Entry& out) {
+	out.descriptor_set = m_descriptors.allocate();
+	auto const dii = vk::DescriptorImageInfo{*m_sampler, *out.image.view, vk::ImageLayout::eShaderReadOnlyOptimal};
+	auto wds = vk::WriteDescriptorSet{};
+	wds.setDstSet(out.descriptor_set).setDstBinding(0).setDescriptorType(vk::DescriptorType::eCombinedImageSampler).setImageInfo(dii);
+	m_memory_info.device.updateDescriptorSets(wds, {});
+}
+
+auto TextureStore::insert(Entry entry) -> std::uint32_t {
+	auto ret = std::uint32_t{};
+	if (!m_free_handles.empty()) {
+		ret = m_free_handles.back();
+		m_free_handles.pop_back();
+		m_entries.at(ret) = std::move(entry);
+	} else {
+		ret = static_cast<std::uint32_t>(m_entries.size());
+		m_entries.push_back(std::move(entry));
+	}
+	return ret;
+}
+} // namespace gvdi::detail
@@ -0,0 +1,199 @@
+#pragma once
+#include "detail/descriptor_allocator.hpp"
+#include "detail/gpu_memory.hpp"
+#include "detail/parallel_recorder.hpp"
+#include "detail/texture_id.hpp"
+#include "gvdi/compressed_bitmap.hpp"
+#include "gvdi/render_target.hpp"
+#include "gvdi/texture.hpp"
+#include <imgui.h>
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Owner of user textures and render targets: images, descriptor sets (via DescriptorAllocator), uploads, and offscreen renders.
+/// Uploads and renders are recorded into the next frame's command buffer, destruction is deferred by buffering frames.
+/// While mirrored (see set_mirrored()), an RGBA8 copy of every texture is kept on the CPU, for a RemoteViewer.
+class TextureStore {
+  public:
+	static constexpr auto color_format_v = vk::Format::eR8G8B8A8Unorm;
+
+	/// \brief RGBA8 pixels to be uploaded into a region of a texture starting at offset.
+	struct Write {
+		Bitmap bitmap{};
+		vk::Offset2D offset{};
+	};
+
+	/// \brief RGBA8 copy of the base level of a texture.
+	struct Mirror {
+		std::vector<std::byte> pixels{};
+		vk::Extent2D extent{};
+		// unique across all mirrors, changes whenever pixels do.
+		std::uint64_t generation{};
+	};
+
+	/// \brief Whether each BlockFormat can be sampled (and filtered) by the GPU.
+	using BlockSupport = std::array<bool, block_format_count_v>;
+
+	[[nodiscard]] static auto to_vk_format(BlockFormat format) -> vk::Format;
+	/// \param enabled Features enabled on the device (textureCompressionBC / ETC2 / ASTC_LDR).
+	[[nodiscard]] static auto query_block_support(vk::PhysicalDevice gpu, vk::PhysicalDeviceFeatures const& enabled) -> BlockSupport;
+
+	explicit TextureStore(DeviceMemory::CreateInfo const& memory_info, std::uint32_t buffering, vk::Format depth_format,
+						  BlockSupport const& block_support);
+
+	[[nodiscard]] auto create(Bitmap const& bitmap) -> std::uint32_t;
+	/// \brief Create a texture with all levels of bitmap, decoded to RGBA8 if the GPU does not support its format.
+	/// Throws if the format is neither supported nor decodable.
+	[[nodiscard]] auto create(CompressedBitmap const& bitmap) -> std::uint32_t;
+	/// \brief Create a texture cleared to transparent black, for subsequent update()s.
+	[[nodiscard]] auto create(vk::Extent2D extent) -> std::uint32_t;
+	/// \brief Create a color attachment (and optional depth buffer) with a framebuffer.
+	/// A clear is enqueued so that the target is in a sampleable layout before its first use.
+	[[nodiscard]] auto create_render_target(vk::Extent2D extent, bool depth) -> std::uint32_t;
+	void destroy(std::uint32_t handle);
+	/// \brief Enqueue an upload of bitmap into a region of a texture (neither a render target nor mipmapped) starting at offset.
+	/// The texture keeps its previous contents until the next frame is rendered.
+	void update(std::uint32_t handle, Bitmap const& bitmap, vk::Offset2D offset);
+	/// \brief Enqueue uploads of multiple regions of a texture, through a single staging buffer.
+	void update(std::uint32_t handle, std::span<Write const> writes);
+
+	/// \brief Start or stop mirroring all textures except render targets (and block formats that cannot be decoded).
+	/// Textures that exist when mirroring starts are read back from the GPU, and are mirrored once that completes.
+	/// Mirrors are dropped when mirroring stops, or their textures are destroyed.
+	void set_mirrored(bool mirrored);
+	/// \returns Mirror of the texture with id, null if not (yet) mirrored.
+	[[nodiscard]] auto get_mirror(ImTextureID id) const -> Mirror const*;
+
+	[[nodiscard]] auto get_texture_id(std::uint32_t handle) const -> ImTextureID;
+	[[nodiscard]] auto get_extent(std::uint32_t handle) const -> vk::Extent2D;
+
+	/// \returns Render pass compatible with a render target, created on first use.
+	[[nodiscard]] auto get_render_pass(bool depth) -> vk::RenderPass;
+	[[nodiscard]] auto get_render_pass(std::uint32_t handle) -> vk::RenderPass;
+	[[nodiscard]] auto get_depth_format(std::uint32_t handle) const -> vk::Format;
+	/// \brief Enqueue a render into a render target, recorded in the next call to record_renders().
+	void enqueue_render(std::uint32_t handle, ImVec4 const& clear, RenderTarget::Record record);
+
+	/// \brief Release resources no longer in use, must be called once per frame after waiting for the previous one.
+	void next_frame();
+	/// \brief Record pending uploads (and readbacks of mirrors), must be called outside a render pass.
+	void record_uploads(vk::CommandBuffer command_buffer);
+	/// \brief Record pending renders (executed in order of submission), must be called outside a render pass.
+	/// If recorder is not null, renders are recorded into secondary command buffers in parallel.
+	/// Otherwise they are recorded inline, and renders enqueued by record callbacks are recorded in the same call.
+	void record_renders(vk::CommandBuffer command_buffer, ParallelRecorder* recorder);
+	/// \brief Drop pending renders of a skipped frame, except initial clears.
+	void discard_renders();
+
+	[[nodiscard]] auto is_supported(BlockFormat const format) const -> bool {
+		return m_block_support.at(static_cast<std::size_t>(format));
+	}
+
+	[[nodiscard]] auto get_descriptor_allocator() const -> DescriptorAllocator const& { return m_descriptors; }
+
+  private:
+	struct Entry {
+		Image image{};
+		vk::DescriptorSet descriptor_set{};
+		// render targets only.
+		Image depth{};
+		vk::UniqueFramebuffer framebuffer{};
+	};
+
+	struct Upload {
+		vk::Image image{};
+		// null: clear the whole image.
+		Buffer staging{};
+		std::vector<vk::BufferImageCopy> regions{};
+		vk::ImageLayout layout{};
+		std::uint32_t levels{};
+	};
+
+	struct Readback {
+		ImTextureID id{};
+		vk::Image image{};
+		vk::Extent2D extent{};
+		vk::Format format{};
+		Buffer buffer{};
+		// frame recorded in, if recorded.
+		std::uint64_t frame{};
+		bool recorded{};
+		// the texture was updated after recording: the readback is recorded again.
+		bool stale{};
+	};
+
+	struct Render {
+		std::uint32_t handle{};
+		ImVec4 clear{};
+		RenderTarget::Record record{};
+		bool initial{};
+	};
+
+	struct Target {
+		vk::RenderPass render_pass{};
+		vk::Framebuffer framebuffer{};
+		vk::Extent2D extent{};
+		bool depth{};
+	};
+
+	struct Retired {
+		std::uint64_t frame{};
+		Image image{};
+		Image depth{};
+		vk::UniqueFramebuffer framebuffer{};
+		Buffer staging{};
+		Buffer readback{};
+		vk::DescriptorSet descriptor_set{};
+	};
+
+	void record_readbacks(vk::CommandBuffer command_buffer);
+	void complete_readbacks();
+	void enqueue_readback(Entry const& entry);
+	void set_mirror(ImTextureID id, vk::Extent2D extent, std::vector<std::byte> pixels);
+	void write_mirror(ImTextureID id, std::span<Write const> writes);
+	void release_mirror(ImTextureID id);
+	void retire(Readback& readback);
+
+	void record_renders(vk::CommandBuffer command_buffer, ParallelRecorder& recorder);
+	static void begin_render_pass(vk::CommandBuffer command_buffer, Render const& render, Target const& target,
+								  vk::SubpassContents contents);
+	static void record_render(vk::CommandBuffer command_buffer, Render const& render, Target const& target);
+
+	auto get_entry(std::uint32_t handle) const -> Entry const&;
+	auto get_target(std::uint32_t handle) const -> Target;
+	auto create_image(vk::Extent2D extent, vk::Format format = color_format_v, std::uint32_t levels = 1) -> Entry;
+	auto acquire_staging(vk::DeviceSize size) -> Buffer;
+	auto create_staging(std::span<std::byte const> bytes) -> Buffer;
+	auto create_render_pass(bool depth) const -> vk::UniqueRenderPass;
+	void write_descriptor_set(Entry& out);
+	auto insert(Entry entry) -> std::uint32_t;
+
+	DeviceMemory::CreateInfo m_memory_info;
+	std::uint32_t m_buffering;
+	DescriptorAllocator m_descriptors;
+	vk::Format m_depth_format;
+	BlockSupport m_block_support;
+	vk::UniqueSampler m_sampler{};
+	// indexed by depth.
+	std::array<vk::UniqueRenderPass, 2> m_render_passes{};
+
+	std::vector<Entry> m_entries{};
+	std::vector<std::uint32_t> m_free_handles{};
+	std::vector<Upload> m_uploads{};
+	std::vector<Render> m_renders{};
+	std::vector<vk::CommandBufferInheritanceInfo> m_inheritances{};
+	std::vector<vk::CommandBuffer> m_secondaries{};
+	std::vector<Retired> m_retired{};
+	// small staging buffers of completed uploads, reused by create_staging().
+	std::vector<Buffer> m_staging_cache{};
+	std::unordered_map<ImTextureID, Mirror> m_mirrors{};
+	std::vector<Readback> m_readbacks{};
+	std::uint64_t m_mirror_generation{};
+	bool m_mirrored{};
+	std::uint64_t m_frame{};
+};
+} // namespace gvdi::detail
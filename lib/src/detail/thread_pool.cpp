@@ -0,0 +1,64 @@
+#include "detail/thread_pool.hpp"
+#include <utility>
+
+namespace gvdi::detail {
+ThreadPool::ThreadPool(std::uint32_t const thread_count) {
+	m_threads.reserve(thread_count);
+	for (std::uint32_t thread = 0; thread < thread_count; ++thread) {
+		m_threads.emplace_back([this, thread](std::stop_token const& stop) { work(stop, thread); });
+	}
+}
+
+void ThreadPool::dispatch(Batch const& batch) {
+	if (batch.count == 0) { return; }
+
+	auto lock = std::unique_lock{m_mutex};
+	m_batch = batch;
+	m_next = 0;
+	m_error = {};
+	m_active = get_thread_count();
+	++m_generation;
+	lock.unlock();
+	m_work_cv.notify_all();
+
+	run_jobs(get_thread_count());
+
+	// workers may still be inside run_jobs() even if all jobs have been claimed: m_batch must outlive them.
+	lock.lock();
+	m_done_cv.wait(lock, [this] { return m_active == 0; });
+	m_batch = {};
+	if (auto error = std::exchange(m_error, {})) { std::rethrow_exception(error); }
+}
+
+void ThreadPool::work(std::stop_token const& stop, std::uint32_t const thread) {
+	auto generation = std::uint64_t{};
+	while (true) {
+		auto lock = std::unique_lock{m_mutex};
+		if (!m_work_cv.wait(lock, stop, [this, generation] { return m_generation != generation; })) { return; }
+		generation = m_generation;
+		lock.unlock();
+
+		run_jobs(thread);
+
+		lock.lock();
+		if (--m_active == 0) { m_done_cv.notify_one(); }
+	}
+}
+
+void ThreadPool::run_jobs(std::uint32_t const thread) {
+	while (true) {
+		auto lock = std::unique_lock{m_mutex};
+		if (m_next >= m_batch.count) { return; }
+		auto const index = m_next++;
+		auto const batch = m_batch;
+		lock.unlock();
+
+		try {
+			batch.invoke(batch.context, index, thread);
+		} catch (...) {
+			lock.lock();
+			if (!m_error) { m_error = std::current_exception(); }
+		}
+	}
+}
+} // namespace gvdi::detail
@@ -0,0 +1,62 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Fixed set of worker threads executing batches of indexed jobs (fork-join).
+/// The calling thread participates in each batch, dispatching does not allocate.
+class ThreadPool {
+  public:
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	auto operator=(ThreadPool const&) = delete;
+	auto operator=(ThreadPool&&) = delete;
+
+	explicit ThreadPool(std::uint32_t thread_count);
+	~ThreadPool() = default;
+
+	[[nodiscard]] auto get_thread_count() const -> std::uint32_t { return static_cast<std::uint32_t>(m_threads.size()); }
+
+	/// \brief Invoke func(index, thread) for each index in [0, count), and wait for all invocations to return.
+	/// thread is in [0, get_thread_count()]: the calling thread is identified as get_thread_count().
+	/// Not reentrant, the first exception thrown by func is rethrown once the batch is complete.
+	template <typename Func>
+	void for_each(std::size_t const count, Func&& func) {
+		using Type = std::remove_reference_t<Func>;
+		auto const invoke = +[](void* context, std::size_t const index, std::uint32_t const thread) {
+			(*static_cast<Type*>(context))(index, thread);
+		};
+		dispatch(Batch{.invoke = invoke, .context = &func, .count = count});
+	}
+
+  private:
+	struct Batch {
+		void (*invoke)(void*, std::size_t, std::uint32_t){};
+		void* context{};
+		std::size_t count{};
+	};
+
+	void dispatch(Batch const& batch);
+	void work(std::stop_token const& stop, std::uint32_t thread);
+	void run_jobs(std::uint32_t thread);
+
+	std::mutex m_mutex{};
+	std::condition_variable_any m_work_cv{};
+	std::condition_variable m_done_cv{};
+	Batch m_batch{};
+	std::uint64_t m_generation{};
+	std::uint32_t m_active{};
+	std::size_t m_next{};
+	std::exception_ptr m_error{};
+
+	// declared last: joined before any other member is destroyed.
+	std::vector<std::jthread> m_threads{};
+};
+} // namespace gvdi::detail
@@ -0,0 +1,89 @@
+#include "detail/vk_object_counter.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string_view>
+#include <type_traits>
+
+namespace gvdi::detail {
+namespace {
+using Dispatcher = std::remove_cvref_t<decltype(VULKAN_HPP_DEFAULT_DISPATCHER)>;
+
+std::atomic<std::uint64_t> g_created{};
+
+template <auto Member, typename Func>
+struct Counted;
+
+template <auto Member, typename Ret, typename... Args>
+struct Counted<Member, Ret(VKAPI_PTR*)(Args...)> {
+	static inline Ret(VKAPI_PTR* original)(Args...){};
+
+	static auto VKAPI_CALL call(Args... args) -> Ret {
+		g_created.fetch_add(1, std::memory_order_relaxed);
+		return original(args...);
+	}
+};
+
+struct Entry {
+	std::string_view name{};
+	void (*install)(Dispatcher& dispatcher){};
+	PFN_vkVoidFunction (*get)(){};
+};
+
+template <auto Member>
+auto make_entry(std::string_view const name) -> Entry {
+	using Wrapper = Counted<Member, std::remove_cvref_t<decltype(std::declval<Dispatcher&>().*Member)>>;
+	static constexpr auto install = [](Dispatcher& dispatcher) {
+		auto& function = dispatcher.*Member;
+		// re-installing after another init(device) must not wrap the wrapper.
+		if (function == nullptr || function == &Wrapper::call) { return; }
+		Wrapper::original = function;
+		function = &Wrapper::call;
+	};
+	static constexpr auto get = []() -> PFN_vkVoidFunction {
+		if (Wrapper::original == nullptr) { return nullptr; }
+		return reinterpret_cast<PFN_vkVoidFunction>(&Wrapper::call);
+	};
+	return Entry{.name = name, .install = install, .get = get};
+}
+
+// every device level function that creates a Vulkan object (used by gvdi or the Dear ImGui Vulkan backend).
+auto const entries_v = std::array{
+	make_entry<&Dispatcher::vkAllocateCommandBuffers>("vkAllocateCommandBuffers"),
+	make_entry<&Dispatcher::vkAllocateDescriptorSets>("vkAllocateDescriptorSets"),
+	make_entry<&Dispatcher::vkAllocateMemory>("vkAllocateMemory"),
+	make_entry<&Dispatcher::vkCreateBuffer>("vkCreateBuffer"),
+	make_entry<&Dispatcher::vkCreateBufferView>("vkCreateBufferView"),
+	make_entry<&Dispatcher::vkCreateCommandPool>("vkCreateCommandPool"),
+	make_entry<&Dispatcher::vkCreateComputePipelines>("vkCreateComputePipelines"),
+	make_entry<&Dispatcher::vkCreateDescriptorPool>("vkCreateDescriptorPool"),
+	make_entry<&Dispatcher::vkCreateDescriptorSetLayout>("vkCreateDescriptorSetLayout"),
+	make_entry<&Dispatcher::vkCreateEvent>("vkCreateEvent"),
+	make_entry<&Dispatcher::vkCreateFence>("vkCreateFence"),
+	make_entry<&Dispatcher::vkCreateFramebuffer>("vkCreateFramebuffer"),
+	make_entry<&Dispatcher::vkCreateGraphicsPipelines>("vkCreateGraphicsPipelines"),
+	make_entry<&Dispatcher::vkCreateImage>("vkCreateImage"),
+	make_entry<&Dispatcher::vkCreateImageView>("vkCreateImageView"),
+	make_entry<&Dispatcher::vkCreatePipelineCache>("vkCreatePipelineCache"),
+	make_entry<&Dispatcher::vkCreatePipelineLayout>("vkCreatePipelineLayout"),
+	make_entry<&Dispatcher::vkCreateQueryPool>("vkCreateQueryPool"),
+	make_entry<&Dispatcher::vkCreateRenderPass>("vkCreateRenderPass"),
+	make_entry<&Dispatcher::vkCreateSampler>("vkCreateSampler"),
+	make_entry<&Dispatcher::vkCreateSemaphore>("vkCreateSemaphore"),
+	make_entry<&Dispatcher::vkCreateShaderModule>("vkCreateShaderModule"),
+	make_entry<&Dispatcher::vkCreateSwapchainKHR>("vkCreateSwapchainKHR"),
+};
+} // namespace
+
+void install_vk_object_counter() {
+	for (auto const& entry : entries_v) { entry.install(VULKAN_HPP_DEFAULT_DISPATCHER); }
+}
+
+auto get_counted_vk_function(char const* name) -> PFN_vkVoidFunction {
+	auto const it = std::ranges::find(entries_v, std::string_view{name}, &Entry::name);
+	if (it == entries_v.end()) { return nullptr; }
+	return it->get();
+}
+
+auto get_vk_objects_created() -> std::uint64_t { return g_created.load(std::memory_order_relaxed); }
+} // namespace gvdi::detail
@@ -0,0 +1,16 @@
+#pragma once
+#include <vulkan/vulkan.hpp>
+#include <cstdint>
+
+namespace gvdi::detail {
+/// \brief Count Vulkan object creation at a single point: replaces the create / allocate functions of the default dispatcher
+/// with wrappers that count each call. Must be called after each VULKAN_HPP_DEFAULT_DISPATCHER.init(device).
+void install_vk_object_counter();
+
+/// \returns Counting wrapper of the Vulkan function named name (for loaders other than vulkan.hpp's, eg Dear ImGui's),
+/// nullptr if name is not counted or install_vk_object_counter() has not been called.
+[[nodiscard]] auto get_counted_vk_function(char const* name) -> PFN_vkVoidFunction;
+
+/// \returns Number of Vulkan objects created (create / allocate calls) through counting wrappers, since process start.
+[[nodiscard]] auto get_vk_objects_created() -> std::uint64_t;
+} // namespace gvdi::detail
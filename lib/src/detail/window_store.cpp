@@ -0,0 +1,107 @@
+#include "detail/window_store.hpp"
+#include "gvdi/exception.hpp"
+#include <algorithm>
+#include <format>
+#include <utility>
+
+namespace gvdi::detail {
+WindowStore::WindowStore(OnWindow on_create, OnWindow on_destroy)
+	: m_on_create(std::move(on_create)), m_on_destroy(std::move(on_destroy)) {}
+
+WindowStore::~WindowStore() {
+	for (auto const& entry : m_entries) {
+		if (entry) { m_on_destroy(entry->window.get()); }
+	}
+}
+
+auto WindowStore::create(SecondaryWindowCreateInfo const& create_info) -> std::uint32_t {
+	if (create_info.width <= 0 || create_info.height <= 0) { throw Exception{"App::create_secondary_window(): Invalid size"}; }
+	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+	auto entry = std::make_unique<Entry>();
+	entry->window.reset(glfwCreateWindow(create_info.width, create_info.height, create_info.title, nullptr, nullptr));
+	if (!entry->window) { throw Exception{"App::create_secondary_window(): Failed to create GLFW Window"}; }
+	m_on_create(entry->window.get());
+	// usable in the current frame (if any).
+	reset_draw_list(*entry);
+
+	auto ret = std::uint32_t{};
+	if (!m_free_handles.empty()) {
+		ret = m_free_handles.back();
+		m_free_handles.pop_back();
+		m_entries.at(ret) = std::move(entry);
+	} else {
+		ret = static_cast<std::uint32_t>(m_entries.size());
+		m_entries.push_back(std::move(entry));
+	}
+	return ret;
+}
+
+void WindowStore::destroy(std::uint32_t const handle) {
+	auto& entry = m_entries.at(handle);
+	if (!entry) { return; }
+	m_on_destroy(entry->window.get());
+	entry.reset();
+	m_free_handles.push_back(handle);
+}
+
+auto WindowStore::get_glfw_window(std::uint32_t const handle) const -> GLFWwindow* { return get_entry(handle).window.get(); }
+
+auto WindowStore::get_draw_list(std::uint32_t const handle) const -> ImDrawList& { return get_entry(handle).draw_list; }
+
+void WindowStore::begin_frame() {
+	for (auto const& entry : m_entries) {
+		if (entry) { reset_draw_list(*entry); }
+	}
+}
+
+void WindowStore::end_frame() {
+	for (auto const& entry : m_entries) {
+		if (!entry) { continue; }
+		auto* window = entry->window.get();
+		auto width = int{};
+		auto height = int{};
+		glfwGetWindowSize(window, &width, &height);
+		auto fb_width = int{};
+		auto fb_height = int{};
+		glfwGetFramebufferSize(window, &fb_width, &fb_height);
+
+		auto& draw_data = entry->draw_data;
+		draw_data.Clear();
+		draw_data.Valid = true;
+		draw_data.DisplaySize = ImVec2{float(width), float(height)};
+		draw_data.FramebufferScale = ImVec2{1.0f, 1.0f};
+		if (width > 0 && height > 0) {
+			draw_data.FramebufferScale = ImVec2{float(fb_width) / float(width), float(fb_height) / float(height)};
+		}
+		draw_data.AddDrawList(&entry->draw_list);
+	}
+}
+
+auto WindowStore::get_draw_data(GLFWwindow const* window) const -> ImDrawData* {
+	auto const it = std::ranges::find_if(m_entries, [window](auto const& entry) { return entry && entry->window.get() == window; });
+	if (it == m_entries.end()) { return nullptr; }
+	return &(*it)->draw_data;
+}
+
+void WindowStore::append_draw_datas(std::vector<ImDrawData*>& out) const {
+	for (auto const& entry : m_entries) {
+		if (entry) { out.push_back(&entry->draw_data); }
+	}
+}
+
+auto WindowStore::get_entry(std::uint32_t const handle) const -> Entry& {
+	auto const& ret = m_entries.at(handle);
+	if (!ret) { throw Exception{std::format("WindowStore: Invalid handle: {}", handle)}; }
+	return *ret;
+}
+
+void WindowStore::reset_draw_list(Entry& entry) {
+	auto width = int{};
+	auto height = int{};
+	glfwGetWindowSize(entry.window.get(), &width, &height);
+	auto& draw_list = entry.draw_list;
+	draw_list._ResetForNewFrame();
+	draw_list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+	draw_list.PushClipRect(ImVec2{}, ImVec2{float(width), float(height)});
+}
+} // namespace gvdi::detail
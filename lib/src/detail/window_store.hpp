@@ -0,0 +1,65 @@
+#pragma once
+#include "gvdi/secondary_window.hpp"
+#include <GLFW/glfw3.h>
+#include <imgui.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace gvdi::detail {
+/// \brief Owner of SecondaryWindows: GLFW windows, their draw lists, and the draw data built from them every frame.
+/// Swapchains are created and destroyed by the renderer, through the callbacks passed to the constructor.
+class WindowStore {
+  public:
+	/// \brief Called after a window is created, and before it is destroyed.
+	using OnWindow = std::function<void(GLFWwindow*)>;
+
+	WindowStore(WindowStore const&) = delete;
+	WindowStore(WindowStore&&) = delete;
+	auto operator=(WindowStore const&) = delete;
+	auto operator=(WindowStore&&) = delete;
+
+	/// \brief Requires a current Dear ImGui context, which must outlive this instance.
+	explicit WindowStore(OnWindow on_create, OnWindow on_destroy);
+	~WindowStore();
+
+	/// \brief Throws if the window cannot be created, or if on_create throws.
+	[[nodiscard]] auto create(SecondaryWindowCreateInfo const& create_info) -> std::uint32_t;
+	void destroy(std::uint32_t handle);
+
+	[[nodiscard]] auto get_glfw_window(std::uint32_t handle) const -> GLFWwindow*;
+	[[nodiscard]] auto get_draw_list(std::uint32_t handle) const -> ImDrawList&;
+
+	/// \brief Clear all draw lists, must be called after ImGui::NewFrame() (they use its font).
+	void begin_frame();
+	/// \brief Build the draw data of all windows from their draw lists.
+	void end_frame();
+
+	/// \returns Draw data built by the last end_frame(), null if window is not owned by this store.
+	[[nodiscard]] auto get_draw_data(GLFWwindow const* window) const -> ImDrawData*;
+	/// \brief Append the draw data of all windows to out.
+	void append_draw_datas(std::vector<ImDrawData*>& out) const;
+
+  private:
+	struct Deleter {
+		void operator()(GLFWwindow* ptr) const noexcept { glfwDestroyWindow(ptr); }
+	};
+
+	struct Entry {
+		std::unique_ptr<GLFWwindow, Deleter> window{};
+		ImDrawList draw_list{ImGui::GetDrawListSharedData()};
+		ImDrawData draw_data{};
+	};
+
+	[[nodiscard]] auto get_entry(std::uint32_t handle) const -> Entry&;
+	static void reset_draw_list(Entry& entry);
+
+	OnWindow m_on_create;
+	OnWindow m_on_destroy;
+
+	// null entries are free handles.
+	std::vector<std::unique_ptr<Entry>> m_entries{};
+	std::vector<std::uint32_t> m_free_handles{};
+};
+} // namespace gvdi::detail
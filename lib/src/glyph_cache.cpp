@@ -0,0 +1,19 @@
+#include "detail/glyph_atlas.hpp"
+#include "gvdi/glyph_cache.hpp"
+#include <utility>
+
+namespace gvdi {
+GlyphCache::GlyphCache(std::shared_ptr<detail::GlyphAtlas> atlas) : m_atlas(std::move(atlas)) {}
+
+auto GlyphCache::get_font() const -> ImFont* {
+	if (!m_atlas) { return nullptr; }
+	return m_atlas->get_font();
+}
+
+auto GlyphCache::get_stats() const -> GlyphCacheStats {
+	if (!m_atlas) { return {}; }
+	return m_atlas->get_stats();
+}
+
+auto GlyphCache::is_valid() const -> bool { return m_atlas && m_atlas->is_valid(); }
+} // namespace gvdi
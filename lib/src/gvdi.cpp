@@ -1,3 +1,13 @@
+#include "detail/draw_renderer.hpp"
+#include "detail/glfw_keys.hpp"
+#include "detail/glyph_atlas.hpp"
+#include "detail/gpu_memory.hpp"
+#include "detail/imgui_heap.hpp"
+#include "detail/parallel_recorder.hpp"
+#include "detail/remote_server.hpp"
+#include "detail/texture_store.hpp"
+#include "detail/vk_object_counter.hpp"
+#include "detail/window_store.hpp"
 #include "gvdi/app.hpp"
 #include "gvdi/build_version.hpp"
 #include "gvdi/exception.hpp"
@@ -7,12 +17,16 @@
 #include <backends/imgui_impl_vulkan.h>
 #include <vulkan/vulkan.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
+#include <cstdlib>
 #include <format>
+#include <mutex>
 #include <optional>
 #include <sstream>
+#include <unordered_map>
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
@@ -23,6 +37,18 @@ using namespace std::chrono_literals;
 
 constexpr auto vk_api_v = VK_API_VERSION_1_2;
 
+// frames whose resources (eg, geometry) are kept apart, must exceed the number of frames in flight (1).
+constexpr std::uint32_t buffering_v{2};
+
+constexpr auto max_timeout_v = static_cast<std::uint64_t>(std::chrono::nanoseconds(2s).count());
+
+static_assert(gpu::max_memory_heaps_v == VK_MAX_MEMORY_HEAPS);
+
+#if defined(IMGUI_HAS_VIEWPORT)
+// platform windows are only rendered through DrawRenderer: the Vulkan backend's RenderDrawData() expects its own per-viewport data.
+constexpr auto has_viewports(Options const& options) -> bool { return options.imgui_viewports && options.imgui_ring_buffer; }
+#endif
+
 [[nodiscard]] auto to_vk_version(std::string_view const ver_str) -> std::uint32_t {
 	struct {
 		int major{};
@@ -85,6 +111,17 @@ constexpr auto select_format(std::span<vk::SurfaceFormatKHR const> available) ->
 	return available.front();
 }
 
+// depth-only formats: views of combined depth-stencil formats would need both aspects.
+auto select_depth_format(vk::PhysicalDevice const& device) -> vk::Format {
+	using enum vk::Format;
+	for (auto const format : {eD32Sfloat, eX8D24UnormPack32}) {
+		auto const properties = device.getFormatProperties(format);
+		if (properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eDepthStencilAttachment) { return format; }
+	}
+	// required to be supported.
+	return eD16Unorm;
+}
+
 auto get_framebuffer_extent(GLFWwindow* window) -> vk::Extent2D {
 	auto width = int{};
 	auto height = int{};
@@ -120,40 +157,68 @@ class DearImGui {
 	auto operator=(DearImGui const&) = delete;
 	auto operator=(DearImGui&&) = delete;
 
-	explicit DearImGui(GLFWwindow* window, vk::Instance instance, vk::PhysicalDevice physical_device, vk::Device device,
-					   std::uint32_t queue_family, vk::Queue queue, vk::RenderPass render_pass)
-		: m_device(device) {
+	struct CreateInfo {
+		detail::ImGuiHeap* heap{};
+		GLFWwindow* window{};
+		vk::Instance instance{};
+		vk::PhysicalDevice physical_device{};
+		vk::Device device{};
+		std::uint32_t queue_family{};
+		vk::Queue queue{};
+		vk::RenderPass render_pass{};
+		detail::DeviceMemory::CreateInfo memory{};
+	};
+
+	explicit DearImGui(CreateInfo const& create_info, Options const& options)
+		: m_device(create_info.device), m_memory_info(create_info.memory), m_options(options) {
 		IMGUI_CHECKVERSION();
+		ImGui::SetAllocatorFunctions(&detail::ImGuiHeap::allocate, &detail::ImGuiHeap::deallocate, create_info.heap);
 		ImGui::CreateContext();
 
 		ImGui::StyleColorsDark();
 
 		static auto const load_vk_func = +[](char const* name, void* user_data) {
+			// the backend's objects are counted in FrameStats too.
+			if (auto const counted = detail::get_counted_vk_function(name)) { return counted; }
 			return VULKAN_HPP_DEFAULT_DISPATCHER.vkGetInstanceProcAddr(*static_cast<vk::Instance*>(user_data), name);
 		};
+		auto instance = create_info.instance;
 		ImGui_ImplVulkan_LoadFunctions(vk_api_v, load_vk_func, &instance);
 
-		ImGui_ImplGlfw_InitForVulkan(window, true);
+#if defined(IMGUI_HAS_VIEWPORT)
+		// must be set before the platform backend is initialized, which creates the main viewport's platform data.
+		if (has_viewports(options)) { ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_ViewportsEnable; }
+#endif
+
+		ImGui_ImplGlfw_InitForVulkan(create_info.window, true);
 		ImGui_ImplVulkan_InitInfo init_info = {};
 		init_info.Instance = instance;
-		init_info.PhysicalDevice = physical_device;
-		init_info.Device = device;
-		init_info.QueueFamily = queue_family;
-		init_info.Queue = queue;
+		init_info.PhysicalDevice = create_info.physical_device;
+		init_info.Device = create_info.device;
+		init_info.QueueFamily = create_info.queue_family;
+		init_info.Queue = create_info.queue;
 		init_info.DescriptorPoolSize = IMGUI_IMPL_VULKAN_MINIMUM_IMAGE_SAMPLER_POOL_SIZE;
 		init_info.Subpass = 0;
 		init_info.MinImageCount = 2;
 		init_info.ImageCount = 2;
 		init_info.MSAASamples = static_cast<VkSampleCountFlagBits>(1);
-		init_info.RenderPass = render_pass;
+		init_info.RenderPass = create_info.render_pass;
 
 		ImGui_ImplVulkan_Init(&init_info);
+
+		if (options.imgui_ring_buffer) { m_draw_renderer.emplace(create_info.memory, buffering_v, options); }
 	}
 
 	~DearImGui() {
+		// owns ImGui allocations.
+		m_window_renderers.clear();
+		m_draw_renderer.reset();
 		ImGui_ImplVulkan_Shutdown();
 		ImGui_ImplGlfw_Shutdown();
 		ImGui::DestroyContext();
+		// the heap may not outlive this instance.
+		ImGui::SetAllocatorFunctions([](std::size_t const size, void* /*user_data*/) { return std::malloc(size); },
+									 [](void* ptr, void* /*user_data*/) { std::free(ptr); });
 	}
 
 	void begin_frame() {
@@ -168,13 +233,72 @@ class DearImGui {
 		if (m_state == State::Ended) { return; }
 		// ImGui::Render calls ImGui::EndFrame
 		ImGui::Render();
+#if defined(IMGUI_HAS_VIEWPORT)
+		if ((ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable) != 0) {
+			// creates / destroys platform windows (and their swapchains, via the Renderer_* callbacks).
+			ImGui::UpdatePlatformWindows();
+		}
+#endif
 		m_state = State::Ended;
 	}
 
+	[[nodiscard]] auto get_draw_counts() const -> detail::DrawRenderer::Counts {
+		auto ret = m_draw_renderer ? m_draw_renderer->get_counts() : detail::DrawRenderer::Counts{};
+		for (auto const& window : m_window_renderers) {
+			auto const counts = window.renderer->get_counts();
+			ret.commands += counts.commands;
+			ret.draws += counts.draws;
+		}
+		return ret;
+	}
+
+	// main viewport.
+	void render(detail::PassContext const& pass) {
+		auto* draw_data = ImGui::GetDrawData();
+		if (draw_data == nullptr) { return; }
+		if (m_draw_renderer) {
+			m_draw_renderer->render(*draw_data, pass);
+		} else if (pass.recorder != nullptr) {
+			auto const secondary = pass.recorder->begin_secondary(pass.inheritance);
+			ImGui_ImplVulkan_RenderDrawData(draw_data, secondary);
+			secondary.end();
+			pass.primary.executeCommands(secondary);
+		} else {
+			ImGui_ImplVulkan_RenderDrawData(draw_data, pass.primary);
+		}
+	}
+
+	// secondary windows and Dear ImGui platform windows: the Vulkan backend only renders into windows it presents itself.
+	void render(detail::PassContext const& pass, GLFWwindow const* window, ImDrawData& draw_data) {
+		get_window_renderer(window).render(draw_data, pass);
+	}
+
+	// must be called after the window has been removed from Renderer (which idles the device).
+	void remove_window(GLFWwindow const* window) {
+		std::erase_if(m_window_renderers, [window](WindowRenderer const& w) { return w.window == window; });
+	}
+
   private:
 	enum class State : std::int8_t { Ended, Begun };
 
+	// each window is rendered (and its geometry ring partition written) once per frame.
+	struct WindowRenderer {
+		GLFWwindow const* window{};
+		std::unique_ptr<detail::DrawRenderer> renderer{};
+	};
+
+	auto get_window_renderer(GLFWwindow const* window) -> detail::DrawRenderer& {
+		auto const it = std::ranges::find(m_window_renderers, window, &WindowRenderer::window);
+		if (it != m_window_renderers.end()) { return *it->renderer; }
+		m_window_renderers.push_back({window, std::make_unique<detail::DrawRenderer>(m_memory_info, buffering_v, m_options)});
+		return *m_window_renderers.back().renderer;
+	}
+
 	vk::Device m_device{};
+	detail::DeviceMemory::CreateInfo m_memory_info{};
+	Options m_options{};
+	std::optional<detail::DrawRenderer> m_draw_renderer{};
+	std::vector<WindowRenderer> m_window_renderers{};
 	State m_state{State::Ended};
 };
 
@@ -219,10 +343,6 @@ class Surface {
 		surface = vk::UniqueSurfaceKHR{raw_surface, *instance};
 	}
 
-	[[nodiscard]] auto get_capabilities(vk::PhysicalDevice const device) const -> vk::SurfaceCapabilitiesKHR {
-		return device.getSurfaceCapabilitiesKHR(*surface);
-	}
-
 	GLFWwindow* window{};
 	vk::UniqueInstance instance{};
 	vk::UniqueSurfaceKHR surface{};
@@ -291,35 +411,171 @@ class Renderer {
 	auto operator=(Renderer const&) = delete;
 	auto operator=(Renderer&&) = delete;
 
-	explicit Renderer(Surface surface, PhysicalDevice gpu) : m_surface(std::move(surface)), m_gpu(std::move(gpu)) {
+	explicit Renderer(Surface surface, PhysicalDevice gpu, Options const& options) : m_surface(std::move(surface)), m_gpu(std::move(gpu)) {
 		create_device();
 		create_swapchain();
-		create_render_pass();
+		if (options.recording_threads > 0) {
+			m_recorder.emplace(*m_device, m_gpu.queue_family, options.recording_threads);
+			m_secondary_pass = options.imgui_ring_buffer && options.parallel_imgui_commands > 0;
+		}
+		m_textures = std::make_shared<detail::TextureStore>(get_memory_create_info(gpu::MemoryCategory::UserTextures), buffering_v,
+															select_depth_format(m_gpu.device),
+															detail::TextureStore::query_block_support(m_gpu.device, m_features));
 	}
 
 	~Renderer() { wait_idle(); }
 
-	void create_dear_imgui(std::optional<DearImGui>& out, GLFWwindow* window) {
-		out.emplace(window, *m_surface.instance, m_gpu.device, *m_device, m_gpu.queue_family, m_queue, *m_render_pass);
+	void create_dear_imgui(std::optional<DearImGui>& out, detail::ImGuiHeap& heap, Options const& options) {
+		auto const create_info = DearImGui::CreateInfo{
+			.heap = &heap,
+			.window = m_surface.window,
+			.instance = *m_surface.instance,
+			.physical_device = m_gpu.device,
+			.device = *m_device,
+			.queue_family = m_gpu.queue_family,
+			.queue = m_queue,
+			.render_pass = *m_render_pass,
+			.memory = get_memory_create_info(gpu::MemoryCategory::ImGuiBuffers),
+		};
+		out.emplace(create_info, options);
 	}
 
+	[[nodiscard]] auto get_memory_create_info(gpu::MemoryCategory const category) -> detail::DeviceMemory::CreateInfo {
+		return detail::DeviceMemory::CreateInfo{
+			.device = *m_device,
+			.properties = &m_memory_properties,
+			.tracker = &m_memory,
+			.category = category,
+		};
+	}
+
+	/// \brief Record a render pass per window that can be drawn to (invoking render(pass, window) in each),
+	/// submit them together, and present all their images with a single vkQueuePresentKHR.
 	template <typename Func>
 	void execute_pass(ImVec4 const& clear, Func render) {
-		auto const framebuffer = get_framebuffer_extent(m_surface.window);
-		if (!begin_pass(framebuffer, clear)) { return; }
-		render(m_command_buffer);
-		end_pass(framebuffer);
+		count_vk_objects();
+		++m_frame_stats.frame_index;
+		if (!begin_frame()) {
+			m_textures->discard_renders();
+			m_frame_stats.windows = 0;
+			return;
+		}
+		for (auto const& window : m_windows) {
+			if (!window->image_index) { continue; }
+			render(begin_pass(*window, clear), window->glfw);
+			m_command_buffer.endRenderPass();
+		}
+		end_frame();
 	}
 
-	void recreate_swapchain(vk::SurfaceCapabilitiesKHR const& caps, vk::Extent2D const image_extent) {
-		assert(image_extent.width > 0 && image_extent.height > 0);
-		m_swapchain.create_info.imageExtent = image_extent;
-		m_swapchain.create_info.minImageCount = get_image_count(caps);
-		m_swapchain.recreate(*m_device);
+	/// \brief Present window (eg, a Dear ImGui platform window) alongside the main window, through its own surface and swapchain.
+	/// Throws if the surface cannot be presented to by the queue, or does not support the main window's format.
+	void add_window(GLFWwindow* glfw) {
+		auto window = std::make_unique<Window>();
+		window->glfw = glfw;
+		VkSurfaceKHR raw_surface{};
+		auto const result = glfwCreateWindowSurface(*m_surface.instance, glfw, nullptr, &raw_surface);
+		if (result != VK_SUCCESS || !raw_surface) { throw Exception{"Renderer::add_window(): Failed to create Window Surface"}; }
+		window->surface = vk::UniqueSurfaceKHR{raw_surface, *m_surface.instance};
+
+		if (m_gpu.device.getSurfaceSupportKHR(m_gpu.queue_family, *window->surface) == 0) {
+			throw Exception{"Renderer::add_window(): Window Surface not supported by queue family"};
+		}
+		// the render pass (and thus the pipelines) are shared with the main window.
+		auto const formats = m_gpu.device.getSurfaceFormatsKHR(*window->surface);
+		if (std::ranges::find(formats, m_format) == formats.end()) {
+			throw Exception{"Renderer::add_window(): Window Surface does not support the main window's format"};
+		}
+
+		setup_window(*window);
+		m_windows.push_back(std::move(window));
+		update_swapchain_memory();
+	}
+
+	void remove_window(GLFWwindow* glfw) {
+		auto const it = std::ranges::find(m_windows, glfw, [](std::unique_ptr<Window> const& window) { return window->glfw; });
+		// the main window is owned by the App.
+		if (it == m_windows.end() || it == m_windows.begin()) { return; }
+		// its swapchain images may be in use by the last frame.
+		wait_idle();
+		m_windows.erase(it);
+		update_swapchain_memory();
 	}
 
 	[[nodiscard]] auto get_gpu_info() const -> gpu::Info { return gpu::Info{.type = m_gpu.type, .name = m_gpu.name}; }
 
+	[[nodiscard]] auto create_texture(Bitmap const& bitmap) -> Texture { return Texture{m_textures, m_textures->create(bitmap)}; }
+
+	[[nodiscard]] auto create_texture(CompressedBitmap const& bitmap) -> Texture {
+		return Texture{m_textures, m_textures->create(bitmap)};
+	}
+
+	[[nodiscard]] auto is_block_format_supported(BlockFormat const format) const -> bool { return m_textures->is_supported(format); }
+
+	void set_textures_mirrored(bool const mirrored) { m_textures->set_mirrored(mirrored); }
+
+	[[nodiscard]] auto get_texture_mirror(ImTextureID const id) const -> detail::TextureStore::Mirror const* {
+		return m_textures->get_mirror(id);
+	}
+
+	[[nodiscard]] auto create_render_target(RenderTargetCreateInfo const& create_info) -> RenderTarget {
+		if (create_info.width <= 0 || create_info.height <= 0) { throw Exception{"App::create_render_target(): Invalid size"}; }
+		auto const extent = vk::Extent2D{std::uint32_t(create_info.width), std::uint32_t(create_info.height)};
+		return RenderTarget{m_textures, m_textures->create_render_target(extent, create_info.depth)};
+	}
+
+	[[nodiscard]] auto create_virtual_image(VirtualImageCreateInfo const& create_info) -> VirtualImage {
+		return VirtualImage{m_textures, create_info};
+	}
+
+	[[nodiscard]] auto create_image_atlas(ImageAtlasCreateInfo const& create_info) -> ImageAtlas {
+		return ImageAtlas{m_textures, create_info};
+	}
+
+	[[nodiscard]] auto create_glyph_atlas(GlyphCacheCreateInfo const& create_info) -> std::shared_ptr<detail::GlyphAtlas> {
+		return std::make_shared<detail::GlyphAtlas>(m_textures, create_info);
+	}
+
+	[[nodiscard]] auto get_vulkan_handles() const -> VulkanHandles {
+		return VulkanHandles{
+			.instance = static_cast<VkInstance>(*m_surface.instance),
+			.physical_device = static_cast<VkPhysicalDevice>(m_gpu.device),
+			.device = static_cast<VkDevice>(*m_device),
+			.queue = static_cast<VkQueue>(m_queue),
+			.queue_family = m_gpu.queue_family,
+			.get_instance_proc_addr = VULKAN_HPP_DEFAULT_DISPATCHER.vkGetInstanceProcAddr,
+		};
+	}
+
+	[[nodiscard]] auto get_frame_stats() const -> FrameStats { return m_frame_stats; }
+
+	[[nodiscard]] auto get_memory_stats() const -> gpu::MemoryStats {
+		auto ret = gpu::MemoryStats{.has_budget = m_memory_budget};
+		ret.allocated = m_memory.get_totals();
+		if (ImGui::GetCurrentContext() != nullptr) {
+			// font atlas texture is owned by the Dear ImGui backend: estimate from its RGBA32 pixels.
+			auto const& fonts = *ImGui::GetIO().Fonts;
+			auto const atlas_bytes = std::uint64_t(fonts.TexWidth) * std::uint64_t(fonts.TexHeight) * 4;
+			ret.allocated.at(std::size_t(gpu::MemoryCategory::Fonts)) += atlas_bytes;
+		}
+
+		auto properties = vk::PhysicalDeviceMemoryProperties2{};
+		auto budget = vk::PhysicalDeviceMemoryBudgetPropertiesEXT{};
+		if (m_memory_budget) { properties.pNext = &budget; }
+		m_gpu.device.getMemoryProperties2(&properties);
+
+		auto const& heaps = properties.memoryProperties.memoryHeaps;
+		ret.heap_count = properties.memoryProperties.memoryHeapCount;
+		for (std::uint32_t index = 0; index < ret.heap_count; ++index) {
+			auto& heap = ret.heaps.at(index);
+			heap.size = heaps.at(index).size;
+			heap.device_local = static_cast<bool>(heaps.at(index).flags & vk::MemoryHeapFlagBits::eDeviceLocal);
+			heap.budget = m_memory_budget ? budget.heapBudget.at(index) : heap.size;
+			heap.usage = m_memory_budget ? budget.heapUsage.at(index) : 0;
+		}
+		return ret;
+	}
+
 	void wait_idle() const {
 		if (!m_device) { return; }
 		m_device->waitIdle();
@@ -337,20 +593,26 @@ class Renderer {
 				.setImageFormat(format.format);
 		}
 
-		void recreate(vk::Device const device) {
+		void recreate(vk::Device const device, vk::RenderPass const render_pass) {
 			create_info.oldSwapchain = *swapchain;
 			device.waitIdle();
 			swapchain = device.createSwapchainKHRUnique(create_info);
 			images = device.getSwapchainImagesKHR(*swapchain);
+			framebuffers.clear();
 			image_views.clear();
 			image_views.reserve(images.size());
+			framebuffers.reserve(images.size());
 			auto ivci = vk::ImageViewCreateInfo{};
 			ivci.setViewType(vk::ImageViewType::e2D)
 				.setFormat(create_info.imageFormat)
 				.setSubresourceRange(vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1});
+			auto fci = vk::FramebufferCreateInfo{};
+			fci.setLayers(1).setRenderPass(render_pass).setWidth(create_info.imageExtent.width).setHeight(create_info.imageExtent.height);
 			for (auto const image : images) {
 				ivci.setImage(image);
 				image_views.push_back(device.createImageViewUnique(ivci));
+				fci.setAttachments(*image_views.back());
+				framebuffers.push_back(device.createFramebufferUnique(fci));
 			}
 			present_semaphores.clear();
 			present_semaphores.resize(images.size());
@@ -361,9 +623,40 @@ class Renderer {
 		vk::UniqueSwapchainKHR swapchain{};
 		std::vector<vk::Image> images{};
 		std::vector<vk::UniqueImageView> image_views{};
+		std::vector<vk::UniqueFramebuffer> framebuffers{};
 		std::vector<vk::UniqueSemaphore> present_semaphores{};
 	};
 
+	// presentable window: its own surface and swapchain, sharing the device, render pass, command buffer and fence.
+	struct Window {
+		GLFWwindow* glfw{};
+		vk::UniqueSurfaceKHR surface{};
+		Swapchain swapchain{};
+		vk::UniqueSemaphore draw_semaphore{};
+		std::optional<std::uint32_t> image_index{};
+		vk::Extent2D framebuffer_extent{};
+		std::uint64_t image_bytes{};
+		bool swapchain_dirty{};
+	};
+
+	// reused across frames.
+	struct Present {
+		void clear() {
+			wait_semaphores.clear();
+			wait_stages.clear();
+			signal_semaphores.clear();
+			swapchains.clear();
+			image_indices.clear();
+		}
+
+		std::vector<vk::Semaphore> wait_semaphores{};
+		std::vector<vk::PipelineStageFlags> wait_stages{};
+		std::vector<vk::Semaphore> signal_semaphores{};
+		std::vector<vk::SwapchainKHR> swapchains{};
+		std::vector<std::uint32_t> image_indices{};
+		std::vector<vk::Result> results{};
+	};
+
 	void create_device() {
 		static constexpr float priority_v = 1.0f;
 		static constexpr std::array required_extensions_v = {VK_KHR_SWAPCHAIN_EXTENSION_NAME,
@@ -373,31 +666,91 @@ class Renderer {
 		};
 
 		auto const available_extensions = m_gpu.device.enumerateDeviceExtensionProperties();
-		for (auto const* ext : required_extensions_v) {
+		auto const is_available = [&](std::string_view const ext) {
 			auto const found = [ext](vk::ExtensionProperties const& props) { return std::string_view{props.extensionName} == ext; };
-			if (std::ranges::find_if(available_extensions, found) == available_extensions.end()) {
+			return std::ranges::find_if(available_extensions, found) != available_extensions.end();
+		};
+		for (auto const* ext : required_extensions_v) {
+			if (!is_available(ext)) {
 				throw Exception{
 					std::format("App::stage_initialize(): Required extension '{}' not supported by selected GPU '{}'", ext, m_gpu.name)};
 			}
 		}
 
+		auto extensions = std::vector<char const*>{required_extensions_v.begin(), required_extensions_v.end()};
+		m_memory_budget = is_available(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+		if (m_memory_budget) { extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME); }
+
+		// block compression is optional: unsupported formats are decoded on the CPU.
+		auto const supported_features = m_gpu.device.getFeatures();
+		m_features.setTextureCompressionBC(supported_features.textureCompressionBC)
+			.setTextureCompressionETC2(supported_features.textureCompressionETC2)
+			.setTextureCompressionASTC_LDR(supported_features.textureCompressionASTC_LDR);
+
 		auto qci = vk::DeviceQueueCreateInfo{};
 		qci.setQueueFamilyIndex(m_gpu.queue_family).setQueueCount(1).setQueuePriorities(priority_v);
 		auto dci = vk::DeviceCreateInfo{};
-		dci.setQueueCreateInfos(qci).setPEnabledExtensionNames(required_extensions_v);
+		dci.setQueueCreateInfos(qci).setPEnabledExtensionNames(extensions).setPEnabledFeatures(&m_features);
 		m_device = m_gpu.device.createDeviceUnique(dci);
 		m_queue = m_device->getQueue(m_gpu.queue_family, 0);
+		m_memory_properties = m_gpu.device.getMemoryProperties();
 
 		VULKAN_HPP_DEFAULT_DISPATCHER.init(*m_device);
+		detail::install_vk_object_counter();
+		m_vk_objects_counted = detail::get_vk_objects_created();
 	}
 
 	void create_swapchain() {
-		auto const framebuffer_extent = get_framebuffer_extent(m_surface.window);
-		auto const format = select_format(m_gpu.device.getSurfaceFormatsKHR(*m_surface.surface));
-		m_swapchain.setup_create_info(*m_surface.surface, m_gpu.queue_family, format);
-		auto const caps = m_surface.get_capabilities(m_gpu.device);
-		auto const image_extent = get_image_extent(caps, framebuffer_extent);
-		recreate_swapchain(caps, image_extent);
+		auto window = std::make_unique<Window>();
+		window->glfw = m_surface.window;
+		window->surface = std::move(m_surface.surface);
+		m_format = select_format(m_gpu.device.getSurfaceFormatsKHR(*window->surface));
+		// framebuffers require the render pass.
+		create_render_pass();
+		setup_window(*window);
+		m_windows.push_back(std::move(window));
+		update_swapchain_memory();
+	}
+
+	void setup_window(Window& window) {
+		window.swapchain.setup_create_info(*window.surface, m_gpu.queue_family, m_format);
+		window.draw_semaphore = m_device->createSemaphoreUnique({});
+		refresh_swapchain(window, get_framebuffer_extent(window.glfw), true);
+	}
+
+	// queries surface capabilities, recreates the swapchain if forced or if the image extent has changed.
+	void refresh_swapchain(Window& window, vk::Extent2D const framebuffer, bool const force) {
+		auto const caps = m_gpu.device.getSurfaceCapabilitiesKHR(*window.surface);
+		auto const image_extent = get_image_extent(caps, framebuffer);
+		window.framebuffer_extent = framebuffer;
+		window.swapchain_dirty = false;
+		if (force || image_extent != window.swapchain.create_info.imageExtent) { recreate_swapchain(window, caps, image_extent); }
+	}
+
+	void recreate_swapchain(Window& window, vk::SurfaceCapabilitiesKHR const& caps, vk::Extent2D const image_extent) {
+		assert(image_extent.width > 0 && image_extent.height > 0);
+		window.swapchain.create_info.imageExtent = image_extent;
+		window.swapchain.create_info.minImageCount = get_image_count(caps);
+		window.swapchain.recreate(*m_device, *m_render_pass);
+		++m_frame_stats.swapchain_recreations;
+		// swapchain images are owned by the driver: estimate assuming 4 bytes per texel.
+		auto const image_bytes = std::uint64_t{image_extent.width} * image_extent.height * 4;
+		window.image_bytes = image_bytes * window.swapchain.images.size();
+		update_swapchain_memory();
+	}
+
+	// objects created since the previous frame, by anyone (renderer, textures, Dear ImGui backend, recorder threads).
+	void count_vk_objects() {
+		auto const counted = detail::get_vk_objects_created();
+		auto const created = counted - std::exchange(m_vk_objects_counted, counted);
+		m_frame_stats.vk_objects_created = static_cast<std::uint32_t>(created);
+		m_frame_stats.total_vk_objects_created += created;
+	}
+
+	void update_swapchain_memory() {
+		auto bytes = std::uint64_t{};
+		for (auto const& window : m_windows) { bytes += window->image_bytes; }
+		m_memory.set(gpu::MemoryCategory::Swapchain, bytes);
 	}
 
 	void create_render_pass() {
@@ -413,12 +766,10 @@ class Renderer {
 			.setStoreOp(vk::AttachmentStoreOp::eStore)
 			.setInitialLayout(vk::ImageLayout::eUndefined)
 			.setFinalLayout(vk::ImageLayout::ePresentSrcKHR)
-			.setFormat(m_swapchain.create_info.imageFormat);
+			.setFormat(m_format.format);
 		rpci.setSubpasses(sd).setAttachments(ad);
 		m_render_pass = m_device->createRenderPassUnique(rpci);
 
-		m_draw_semaphore = m_device->createSemaphoreUnique({});
-
 		auto cpci = vk::CommandPoolCreateInfo{};
 		cpci.setQueueFamilyIndex(m_gpu.queue_family)
 			.setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient);
@@ -428,101 +779,170 @@ class Renderer {
 		m_command_buffer = m_device->allocateCommandBuffers(cbai).front();
 	}
 
-	[[nodiscard]] auto create_framebuffer(vk::ImageView const render_target) const -> vk::UniqueFramebuffer {
-		auto fci = vk::FramebufferCreateInfo{};
-		fci.setLayers(1)
-			.setRenderPass(*m_render_pass)
-			.setAttachments(render_target)
-			.setWidth(m_swapchain.create_info.imageExtent.width)
-			.setHeight(m_swapchain.create_info.imageExtent.height);
-		return m_device->createFramebufferUnique(fci);
-	}
+	// waits for the previous frame, and acquires an image of each window that can be drawn to.
+	// \returns false if no window can be drawn to (eg, all minimized).
+	auto begin_frame() -> bool {
+		auto const is_drawable = [](std::unique_ptr<Window> const& window) {
+			auto const framebuffer = get_framebuffer_extent(window->glfw);
+			return framebuffer.width > 0 && framebuffer.height > 0;
+		};
+		if (std::ranges::none_of(m_windows, is_drawable)) { return false; }
 
-	auto begin_pass(vk::Extent2D const framebuffer, ImVec4 const& clear) -> bool {
-		if (framebuffer.width == 0 || framebuffer.height == 0) { return false; }
+		auto const result = m_device->waitForFences(*m_render_fence, vk::True, max_timeout_v);
+		if (result != vk::Result::eSuccess) { throw Exception{"Renderer::begin_frame(): Failed to wait for Vulkan render Fence"}; }
+		m_textures->next_frame();
+		if (m_recorder) { m_recorder->next_frame(); }
 
-		static constexpr auto max_timeout_v = static_cast<std::uint64_t>(std::chrono::nanoseconds(2s).count());
+		auto acquired = false;
+		for (auto const& window : m_windows) { acquired = acquire_image(*window) || acquired; }
+		if (!acquired) { return false; }
 
-		auto result = m_device->waitForFences(*m_render_fence, vk::True, max_timeout_v);
-		if (result != vk::Result::eSuccess) { throw Exception{"Renderer::begin_pass(): Failed to wait for Vulkan render Fence"}; }
+		// reset only once a submission that will signal the fence is guaranteed.
 		m_device->resetFences(*m_render_fence);
 
-		auto const caps = m_surface.get_capabilities(m_gpu.device);
-		auto const image_extent = get_image_extent(caps, framebuffer);
-		if (image_extent != m_swapchain.create_info.imageExtent) { recreate_swapchain(caps, image_extent); }
+		m_command_buffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+		m_textures->record_uploads(m_command_buffer);
+		m_textures->record_renders(m_command_buffer, m_recorder ? &*m_recorder : nullptr);
+		return true;
+	}
+
+	auto acquire_image(Window& window) -> bool {
+		auto const framebuffer = get_framebuffer_extent(window.glfw);
+		if (framebuffer.width == 0 || framebuffer.height == 0) { return false; }
+
+		// surface capabilities are only queried when the framebuffer has changed (or the swapchain has been flagged).
+		if (window.swapchain_dirty || framebuffer != window.framebuffer_extent) { refresh_swapchain(window, framebuffer, false); }
 
 		auto image_index = std::uint32_t{};
-		result = m_device->acquireNextImageKHR(*m_swapchain.swapchain, max_timeout_v, *m_draw_semaphore, {}, &image_index);
+		auto const result =
+			m_device->acquireNextImageKHR(*window.swapchain.swapchain, max_timeout_v, *window.draw_semaphore, {}, &image_index);
 		if (result == vk::Result::eErrorOutOfDateKHR) {
-			recreate_swapchain(caps, image_extent);
+			refresh_swapchain(window, framebuffer, true);
 			return false;
 		}
 		if (result != vk::Result::eSuccess && result != vk::Result::eSuboptimalKHR) {
-			throw Exception{"Renderer::begin_pass(): Failed to acquire Vulkan Swapchain Image"};
+			throw Exception{"Renderer::begin_frame(): Failed to acquire Vulkan Swapchain Image"};
 		}
+		if (result == vk::Result::eSuboptimalKHR) { window.swapchain_dirty = true; }
+		window.image_index = image_index;
+		return true;
+	}
 
-		m_image_index = image_index;
-
-		m_framebuffer = create_framebuffer(*m_swapchain.image_views.at(image_index));
+	auto begin_pass(Window const& window, ImVec4 const& clear) -> detail::PassContext {
+		auto const& framebuffer = *window.swapchain.framebuffers.at(*window.image_index);
 		auto render_area = vk::Rect2D{};
-		render_area.setExtent(m_swapchain.create_info.imageExtent);
+		render_area.setExtent(window.swapchain.create_info.imageExtent);
 
 		auto const vk_clear_colour = std::array<vk::ClearValue, 1>{vk::ClearColorValue{clear.x, clear.y, clear.z, clear.w}};
 		auto rpbi = vk::RenderPassBeginInfo{};
-		rpbi.setRenderPass(*m_render_pass).setFramebuffer(*m_framebuffer).setRenderArea(render_area).setClearValues(vk_clear_colour);
+		rpbi.setRenderPass(*m_render_pass).setFramebuffer(framebuffer).setRenderArea(render_area).setClearValues(vk_clear_colour);
 
-		m_command_buffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
-		m_command_buffer.beginRenderPass(rpbi, vk::SubpassContents::eInline);
-		return true;
-	}
+		auto const contents = m_secondary_pass ? vk::SubpassContents::eSecondaryCommandBuffers : vk::SubpassContents::eInline;
+		m_command_buffer.beginRenderPass(rpbi, contents);
 
-	void end_pass(vk::Extent2D const framebuffer) {
-		assert(m_image_index);
-		auto const image_index = *std::exchange(m_image_index, {});
+		auto ret = detail::PassContext{.primary = m_command_buffer};
+		if (m_secondary_pass) {
+			ret.recorder = &*m_recorder;
+			ret.inheritance.setRenderPass(*m_render_pass).setSubpass(0).setFramebuffer(framebuffer);
+		}
+		return ret;
+	}
 
-		m_command_buffer.endRenderPass();
+	// a single submission waits for every acquired image, and a single present covers all their swapchains.
+	void end_frame() {
 		m_command_buffer.end();
 
+		m_present.clear();
+		for (auto const& window : m_windows) {
+			if (!window->image_index) { continue; }
+			m_present.wait_semaphores.push_back(*window->draw_semaphore);
+			m_present.signal_semaphores.push_back(*window->swapchain.present_semaphores.at(*window->image_index));
+			m_present.swapchains.push_back(*window->swapchain.swapchain);
+			m_present.image_indices.push_back(*window->image_index);
+		}
+		m_present.wait_stages.resize(m_present.wait_semaphores.size(), vk::PipelineStageFlagBits::eColorAttachmentOutput);
+		m_present.results.resize(m_present.swapchains.size());
+
 		auto si = vk::SubmitInfo{};
-		static constexpr vk::PipelineStageFlags wdsm = vk::PipelineStageFlagBits::eColorAttachmentOutput;
-		auto const present_semaphore = *m_swapchain.present_semaphores.at(image_index);
 		si.setCommandBuffers(m_command_buffer)
-			.setWaitSemaphores(*m_draw_semaphore)
-			.setWaitDstStageMask(wdsm)
-			.setSignalSemaphores(present_semaphore);
-		auto result = m_queue.submit(1, &si, *m_render_fence);
-		if (result != vk::Result::eSuccess) { throw Exception{"Renderer::end_pass(): Failed to submit Vulkan render Command Buffer"}; }
+			.setWaitSemaphores(m_present.wait_semaphores)
+			.setWaitDstStageMask(m_present.wait_stages)
+			.setSignalSemaphores(m_present.signal_semaphores);
+		auto const result = m_queue.submit(1, &si, *m_render_fence);
+		if (result != vk::Result::eSuccess) { throw Exception{"Renderer::end_frame(): Failed to submit Vulkan render Command Buffer"}; }
 
 		auto pi = vk::PresentInfoKHR{};
-		pi.setSwapchains(*m_swapchain.swapchain).setImageIndices(image_index).setWaitSemaphores(present_semaphore);
-		result = m_queue.presentKHR(&pi);
-		if (result == vk::Result::eErrorOutOfDateKHR) {
-			auto const caps = m_surface.get_capabilities(m_gpu.device);
-			auto const image_extent = get_image_extent(caps, framebuffer);
-			recreate_swapchain(caps, image_extent);
+		pi.setSwapchains(m_present.swapchains)
+			.setImageIndices(m_present.image_indices)
+			.setWaitSemaphores(m_present.signal_semaphores)
+			.setResults(m_present.results);
+		// per swapchain results are written to m_present.results.
+		[[maybe_unused]] auto const present_result = m_queue.presentKHR(&pi);
+
+		auto presented = std::size_t{};
+		for (auto const& window : m_windows) {
+			if (!std::exchange(window->image_index, {})) { continue; }
+			auto const window_result = m_present.results.at(presented++);
+			if (window_result == vk::Result::eErrorOutOfDateKHR) {
+				refresh_swapchain(*window, get_framebuffer_extent(window->glfw), true);
+			} else if (window_result == vk::Result::eSuboptimalKHR) {
+				window->swapchain_dirty = true;
+			}
 		}
+		m_frame_stats.windows = static_cast<std::uint32_t>(presented);
 	}
 
 	Surface m_surface;
 	PhysicalDevice m_gpu{};
 	vk::UniqueDevice m_device{};
 	vk::Queue m_queue{};
+	vk::PhysicalDeviceMemoryProperties m_memory_properties{};
+	vk::PhysicalDeviceFeatures m_features{};
+	bool m_memory_budget{};
+	detail::MemoryTracker m_memory{};
 
-	Swapchain m_swapchain{};
+	vk::SurfaceFormatKHR m_format{};
 	vk::UniqueRenderPass m_render_pass{};
-	vk::UniqueSemaphore m_draw_semaphore{};
 	vk::UniqueFence m_render_fence{};
 	vk::UniqueCommandPool m_command_pool{};
 	vk::CommandBuffer m_command_buffer{};
 
-	std::optional<std::uint32_t> m_image_index{};
-	vk::UniqueFramebuffer m_framebuffer{};
+	// the main window is first.
+	std::vector<std::unique_ptr<Window>> m_windows{};
+	Present m_present{};
+
+	FrameStats m_frame_stats{};
+	std::uint64_t m_vk_objects_counted{};
+
+	std::optional<detail::ParallelRecorder> m_recorder{};
+	// whether the swapchain render pass is recorded via secondary command buffers.
+	bool m_secondary_pass{};
+
+	// Texture instances only hold weak references.
+	std::shared_ptr<detail::TextureStore> m_textures{};
 };
 } // namespace
 
 class App::Impl {
   public:
-	explicit Impl(App& app) : m_app(app) {}
+	explicit Impl(App& app, std::size_t const bounded_post_capacity) : m_app(app), m_bounded_posted(bounded_post_capacity) {}
+
+	Impl(Impl const&) = delete;
+	Impl(Impl&&) = delete;
+	auto operator=(Impl const&) = delete;
+	auto operator=(Impl&&) = delete;
+
+	~Impl() {
+		m_remote.reset();
+		release_glyph_atlases();
+		m_secondary_windows.reset();
+		m_dear_imgui.reset();
+		m_renderer.reset();
+		m_window.reset();
+		// producer threads may be inside wake().
+		auto lock = std::scoped_lock{m_glfw_mutex};
+		m_glfw.reset();
+	}
 
 	void run_event_loop() {
 		m_app.stage_initialize();
@@ -532,13 +952,17 @@ class App::Impl {
 
 		m_app.pre_first_frame();
 		while (glfwWindowShouldClose(get_window()) == GLFW_FALSE) {
+			m_imgui_heap.next_frame();
 			glfwPollEvents();
+			run_posted();
 			m_dear_imgui->begin_frame();
+			m_secondary_windows->begin_frame();
 			m_app.update();
 			m_dear_imgui->end_frame();
-			auto const render = [](vk::CommandBuffer const command_buffer) {
-				if (auto* draw_data = ImGui::GetDrawData()) { ImGui_ImplVulkan_RenderDrawData(draw_data, command_buffer); }
-			};
+			m_secondary_windows->end_frame();
+			resolve_glyphs();
+			publish_remote();
+			auto const render = [this](detail::PassContext const& pass, GLFWwindow* window) { render_window(pass, window); };
 			m_renderer->execute_pass({}, render);
 
 			if (m_reboot) {
@@ -563,30 +987,141 @@ class App::Impl {
 
 	[[nodiscard]] auto will_reboot() const -> bool { return m_reboot; }
 
+	[[nodiscard]] auto get_imgui_alloc_stats() const -> AllocStats { return m_imgui_heap.get_stats(); }
+
+	[[nodiscard]] auto get_frame_stats() const -> FrameStats {
+		if (!m_renderer) { return {}; }
+		auto ret = m_renderer->get_frame_stats();
+		if (m_dear_imgui) {
+			auto const counts = m_dear_imgui->get_draw_counts();
+			ret.imgui_commands = counts.commands;
+			ret.imgui_draws = counts.draws;
+		}
+		return ret;
+	}
+
+	[[nodiscard]] auto get_memory_stats() const -> gpu::MemoryStats {
+		if (!m_renderer) { return {}; }
+		return m_renderer->get_memory_stats();
+	}
+
+	[[nodiscard]] auto create_texture(Bitmap const& bitmap) -> Texture {
+		if (!m_renderer) { throw Exception{"App::create_texture(): stage_create() not called"}; }
+		return m_renderer->create_texture(bitmap);
+	}
+
+	[[nodiscard]] auto create_texture(CompressedBitmap const& bitmap) -> Texture {
+		if (!m_renderer) { throw Exception{"App::create_texture(): stage_create() not called"}; }
+		return m_renderer->create_texture(bitmap);
+	}
+
+	[[nodiscard]] auto is_block_format_supported(BlockFormat const format) const -> bool {
+		if (!m_renderer) { return false; }
+		return m_renderer->is_block_format_supported(format);
+	}
+
+	[[nodiscard]] auto create_render_target(RenderTargetCreateInfo const& create_info) -> RenderTarget {
+		if (!m_renderer) { throw Exception{"App::create_render_target(): stage_create() not called"}; }
+		return m_renderer->create_render_target(create_info);
+	}
+
+	[[nodiscard]] auto create_virtual_image(VirtualImageCreateInfo const& create_info) -> VirtualImage {
+		if (!m_renderer) { throw Exception{"App::create_virtual_image(): stage_create() not called"}; }
+		return m_renderer->create_virtual_image(create_info);
+	}
+
+	[[nodiscard]] auto create_image_atlas(ImageAtlasCreateInfo const& create_info) -> ImageAtlas {
+		if (!m_renderer) { throw Exception{"App::create_image_atlas(): stage_create() not called"}; }
+		return m_renderer->create_image_atlas(create_info);
+	}
+
+	[[nodiscard]] auto create_glyph_cache(GlyphCacheCreateInfo const& create_info) -> GlyphCache {
+		if (!m_renderer) { throw Exception{"App::create_glyph_cache(): stage_create() not called"}; }
+		auto atlas = m_renderer->create_glyph_atlas(create_info);
+		m_glyph_atlases.push_back(atlas);
+		return GlyphCache{std::move(atlas)};
+	}
+
+	[[nodiscard]] auto create_secondary_window(SecondaryWindowCreateInfo const& create_info) -> SecondaryWindow {
+		if (!m_secondary_windows) { throw Exception{"App::create_secondary_window(): stage_create() not called"}; }
+		return SecondaryWindow{m_secondary_windows, m_secondary_windows->create(create_info)};
+	}
+
+	[[nodiscard]] auto get_vulkan_handles() const -> VulkanHandles {
+		if (!m_renderer) { return {}; }
+		return m_renderer->get_vulkan_handles();
+	}
+
 	void schedule_reboot() {
 		if (!m_glfw) { throw Exception{"App::schedule_reboot(): stage_initialize() not called"}; }
 		if (m_reboot || m_app.should_close_window()) { return; }
 		m_reboot = true;
 	}
 
+	void post(Task task) {
+		m_posted.push(std::move(task));
+		wake();
+	}
+
+	auto try_post(Task task) -> bool {
+		if (!m_bounded_posted.try_push(std::move(task))) { return false; }
+		wake();
+		return true;
+	}
+
+	[[nodiscard]] auto get_post_stats() const -> PostStats {
+		return PostStats{.unbounded = m_posted.get_stats(), .bounded = m_bounded_posted.get_stats()};
+	}
+
+	[[nodiscard]] auto get_remote_stats() const -> RemoteStats {
+		if (!m_remote) { return {}; }
+		return m_remote->get_stats();
+	}
+
 	void stage_initialize() {
+		auto lock = std::unique_lock{m_glfw_mutex};
 		if (m_glfw) { throw Exception{"App::stage_initialize(): already initialized"}; }
 		m_glfw.emplace();
+		lock.unlock();
 		if (glfwVulkanSupported() != GLFW_TRUE) { throw Exception{"App::stage_initialize(): GLFW: Vukan not supported"}; }
 	}
 
 	void stage_create() {
 		if (!m_glfw) { throw Exception{"App::stage_create(): stage_initialize() not called"}; }
 		if (m_window) { throw Exception{"App::stage_create(): already created"}; }
+		auto const options = m_app.get_options();
 		create_window();
-		create_renderer();
-		m_renderer->create_dear_imgui(m_dear_imgui, get_window());
+		create_renderer(options);
+		m_imgui_heap.set_backend(options.imgui_allocator);
+		m_renderer->create_dear_imgui(m_dear_imgui, m_imgui_heap, options);
+		create_secondary_windows();
+#if defined(IMGUI_HAS_VIEWPORT)
+		if (has_viewports(options)) { install_viewport_callbacks(); }
+#endif
+		if (!options.remote_address.empty()) {
+			// events arrive on the server's thread: replay them on the main thread, like GLFW's.
+			auto on_event = [this](detail::RemoteEvent const& event) { post([this, event] { replay_remote(event); }); };
+			auto get_texture = [this](ImTextureID const id) -> std::optional<detail::RemoteServer::MirroredTexture> {
+				auto const* mirror = m_renderer->get_texture_mirror(id);
+				if (mirror == nullptr) { return {}; }
+				return detail::RemoteServer::MirroredTexture{
+					.pixels = mirror->pixels,
+					.width = int(mirror->extent.width),
+					.height = int(mirror->extent.height),
+					.generation = mirror->generation,
+				};
+			};
+			m_remote.emplace(options.remote_address, std::move(on_event), std::move(get_texture));
+		}
 	}
 
 	void stage_destroy() {
 		if (!m_glfw) { throw Exception{"App::stage_destroy(): stage_initialize() not called"}; }
 		if (!m_renderer) { return; }
 		m_renderer->wait_idle();
+		m_remote.reset();
+		release_glyph_atlases();
+		m_secondary_windows.reset();
 		m_dear_imgui.reset();
 		m_renderer.reset();
 		m_window.reset();
@@ -605,6 +1140,117 @@ class App::Impl {
 		void operator()(GLFWwindow* ptr) const noexcept { glfwDestroyWindow(ptr); }
 	};
 
+	void wake() {
+		// only the first post after a drain needs to wake the loop.
+		if (m_wake_pending.exchange(true, std::memory_order_acq_rel)) { return; }
+		auto lock = std::scoped_lock{m_glfw_mutex};
+		if (m_glfw) { glfwPostEmptyEvent(); }
+	}
+
+	// secondary windows are presented (and rendered) alongside the main window.
+	void create_secondary_windows() {
+		auto on_create = [this](GLFWwindow* window) { m_renderer->add_window(window); };
+		auto on_destroy = [this](GLFWwindow* window) {
+			m_renderer->remove_window(window);
+			m_dear_imgui->remove_window(window);
+		};
+		m_secondary_windows = std::make_shared<detail::WindowStore>(std::move(on_create), std::move(on_destroy));
+	}
+
+	void render_window(detail::PassContext const& pass, GLFWwindow* window) {
+		if (window == get_window()) {
+			m_dear_imgui->render(pass);
+			return;
+		}
+		if (auto* draw_data = get_draw_data(window); draw_data != nullptr) { m_dear_imgui->render(pass, window, *draw_data); }
+	}
+
+	// draw data of a secondary window or a Dear ImGui platform window, null if it has none (this frame).
+	[[nodiscard]] auto get_draw_data(GLFWwindow* window) const -> ImDrawData* {
+		if (auto* ret = m_secondary_windows->get_draw_data(window); ret != nullptr) { return ret; }
+#if defined(IMGUI_HAS_VIEWPORT)
+		if (auto const* viewport = ImGui::FindViewportByPlatformHandle(window); viewport != nullptr) { return viewport->DrawData; }
+#endif
+		return nullptr;
+	}
+
+	void resolve_glyphs() {
+		if (m_glyph_atlases.empty()) { return; }
+		// glyphs are resolved across all windows at once, so that none of this frame's glyphs are evicted by another window.
+		m_draw_datas.clear();
+#if defined(IMGUI_HAS_VIEWPORT)
+		for (auto const* viewport : ImGui::GetPlatformIO().Viewports) {
+			if (viewport->DrawData != nullptr) { m_draw_datas.push_back(viewport->DrawData); }
+		}
+#else
+		if (auto* draw_data = ImGui::GetDrawData(); draw_data != nullptr) { m_draw_datas.push_back(draw_data); }
+#endif
+		m_secondary_windows->append_draw_datas(m_draw_datas);
+		std::erase_if(m_glyph_atlases, [this](std::weak_ptr<detail::GlyphAtlas> const& weak) {
+			auto atlas = weak.lock();
+			if (!atlas) { return true; }
+			atlas->resolve(m_draw_datas);
+			return false;
+		});
+	}
+
+	void publish_remote() {
+		if (!m_remote) { return; }
+		// textures are copied (or read back) only while a viewer is connected.
+		m_renderer->set_textures_mirrored(m_remote->is_connected());
+		if (auto const* draw_data = ImGui::GetDrawData(); draw_data != nullptr) { m_remote->publish(*draw_data); }
+	}
+
+	// replays a RemoteViewer's input through the GLFW backend's callbacks (which chain to ours).
+	// Keys and mouse buttons are fed to Dear ImGui directly: the backend queries the (local) window for modifiers.
+	void replay_remote(detail::RemoteEvent const& event) {
+		using Type = detail::RemoteEventType;
+		if (!m_dear_imgui) { return; }
+		auto* window = get_window();
+		auto& io = ImGui::GetIO();
+		auto const& ints = event.ints;
+		switch (event.type) {
+		case Type::WindowResize: glfwSetWindowSize(window, ints[0], ints[1]); break;
+		case Type::WindowFocus: ImGui_ImplGlfw_WindowFocusCallback(window, ints[0]); break;
+		case Type::Key: {
+			auto const mods = detail::to_mods_after(ints[0], ints[2], ints[3]);
+			detail::add_imgui_modifiers(io, mods);
+			if (auto const key = detail::to_imgui_key(ints[0]); key != ImGuiKey_None && ints[2] != GLFW_REPEAT) {
+				io.AddKeyEvent(key, ints[2] == GLFW_PRESS);
+			}
+			on_key(ints[0], ints[1], ints[2], ints[3]);
+			break;
+		}
+		case Type::Character: ImGui_ImplGlfw_CharCallback(window, unsigned(ints[0])); break;
+		case Type::CursorPosition: ImGui_ImplGlfw_CursorPosCallback(window, event.reals[0], event.reals[1]); break;
+		case Type::CursorEnter: ImGui_ImplGlfw_CursorEnterCallback(window, ints[0]); break;
+		case Type::MouseButton:
+			detail::add_imgui_modifiers(io, ints[2]);
+			if (ints[0] >= 0 && ints[0] < ImGuiMouseButton_COUNT) { io.AddMouseButtonEvent(ints[0], ints[1] == GLFW_PRESS); }
+			on_mouse_button(ints[0], ints[1], ints[2]);
+			break;
+		case Type::MouseScroll: ImGui_ImplGlfw_ScrollCallback(window, event.reals[0], event.reals[1]); break;
+		default: break;
+		}
+	}
+
+	// ImFont allocations must be freed before the Dear ImGui context (and heap) is destroyed.
+	void release_glyph_atlases() {
+		for (auto const& weak : m_glyph_atlases) {
+			if (auto atlas = weak.lock()) { atlas->release(); }
+		}
+		m_glyph_atlases.clear();
+	}
+
+	void run_posted() {
+		m_wake_pending.store(false, std::memory_order_release);
+		static constexpr auto run = [](Task const& task) {
+			if (task) { task(); }
+		};
+		m_posted.drain(run);
+		m_bounded_posted.drain(run);
+	}
+
 	void install_glfw_callbacks() const {
 		static auto const self = [](GLFWwindow* window) -> Impl& { return *static_cast<Impl*>(glfwGetWindowUserPointer(window)); };
 		auto* window = get_window();
@@ -628,10 +1274,41 @@ class App::Impl {
 		glfwSetDropCallback(window, [](GLFWwindow* w, int c, char const** p) { self(w).m_app.on_path_drop({p, std::size_t(c)}); });
 	}
 
-	void create_renderer() {
+#if defined(IMGUI_HAS_VIEWPORT)
+	// platform windows are presented by Renderer (alongside the main window) instead of the Vulkan backend.
+	static void install_viewport_callbacks() {
+		static auto const self = []() -> Impl& {
+			auto* window = static_cast<GLFWwindow*>(ImGui::GetMainViewport()->PlatformHandle);
+			return *static_cast<Impl*>(glfwGetWindowUserPointer(window));
+		};
+		auto& platform_io = ImGui::GetPlatformIO();
+		// RendererUserData is left alone: the Vulkan backend owns it (and casts it to its own type).
+		platform_io.Renderer_CreateWindow = [](ImGuiViewport* viewport) {
+			auto& impl = self();
+			auto* window = static_cast<GLFWwindow*>(viewport->PlatformHandle);
+			impl.m_renderer->add_window(window);
+			impl.m_viewport_windows.insert_or_assign(viewport->ID, window);
+		};
+		// also called for the main viewport (on shutdown), which is not in m_viewport_windows.
+		platform_io.Renderer_DestroyWindow = [](ImGuiViewport* viewport) {
+			auto& impl = self();
+			auto const it = impl.m_viewport_windows.find(viewport->ID);
+			if (it == impl.m_viewport_windows.end()) { return; }
+			impl.m_renderer->remove_window(it->second);
+			// not during its own destruction (which has already released its window renderers).
+			if (impl.m_dear_imgui) { impl.m_dear_imgui->remove_window(it->second); }
+			impl.m_viewport_windows.erase(it);
+		};
+		platform_io.Renderer_SetWindowSize = nullptr;
+		platform_io.Renderer_RenderWindow = nullptr;
+		platform_io.Renderer_SwapBuffers = nullptr;
+	}
+#endif
+
+	void create_renderer(Options const& options) {
 		auto surface = Surface{get_window()};
 		auto gpu = PhysicalDevice::select(m_app.get_gpu_type_priority(), surface);
-		m_renderer.emplace(std::move(surface), std::move(gpu));
+		m_renderer.emplace(std::move(surface), std::move(gpu), options);
 	}
 
 	void on_key(int const key, int const scancode, int const action, int const mods) {
@@ -656,14 +1333,29 @@ class App::Impl {
 	std::optional<Glfw> m_glfw{};
 	std::unique_ptr<GLFWwindow, Deleter> m_window{};
 	std::optional<Renderer> m_renderer{};
+	detail::ImGuiHeap m_imgui_heap{};
 	std::optional<DearImGui> m_dear_imgui{};
+	// SecondaryWindow instances only hold weak references.
+	std::shared_ptr<detail::WindowStore> m_secondary_windows{};
+	std::vector<std::weak_ptr<detail::GlyphAtlas>> m_glyph_atlases{};
+	std::vector<ImDrawData*> m_draw_datas{};
+	// Dear ImGui platform windows presented by m_renderer.
+	std::unordered_map<ImGuiID, GLFWwindow*> m_viewport_windows{};
+	std::optional<detail::RemoteServer> m_remote{};
+
+	MpscQueue<Task> m_posted{};
+	BoundedMpscQueue<Task> m_bounded_posted;
+	std::atomic<bool> m_wake_pending{};
+	std::mutex m_glfw_mutex{};
 
 	bool m_reboot{};
 };
 
 void App::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
 
-App::App() : m_impl(new Impl{*this}) {}
+App::App() : App(post_capacity_v) {}
+
+App::App(std::size_t const bounded_post_capacity) : m_impl(new Impl{*this, bounded_post_capacity}) {}
 
 auto App::create_windowed_window(char const* title, int const width, int const height) -> GLFWwindow* {
 	return glfwCreateWindow(width, height, title, nullptr, nullptr);
@@ -702,5 +1394,47 @@ auto App::get_gpu_info() const -> gpu::Info { return m_impl->get_gpu_info(); }
 
 auto App::will_reboot() const -> bool { return m_impl->will_reboot(); }
 
+auto App::get_imgui_alloc_stats() const -> AllocStats { return m_impl->get_imgui_alloc_stats(); }
+
+auto App::get_frame_stats() const -> FrameStats { return m_impl->get_frame_stats(); }
+
+auto App::get_memory_stats() const -> gpu::MemoryStats { return m_impl->get_memory_stats(); }
+
+auto App::create_texture(Bitmap const& bitmap) -> Texture { return m_impl->create_texture(bitmap); }
+
+auto App::create_texture(CompressedBitmap const& bitmap) -> Texture { return m_impl->create_texture(bitmap); }
+
+auto App::is_block_format_supported(BlockFormat const format) const -> bool { return m_impl->is_block_format_supported(format); }
+
+auto App::create_render_target(RenderTargetCreateInfo const& create_info) -> RenderTarget {
+	return m_impl->create_render_target(create_info);
+}
+
+auto App::create_virtual_image(VirtualImageCreateInfo const& create_info) -> VirtualImage {
+	return m_impl->create_virtual_image(create_info);
+}
+
+auto App::create_image_atlas(ImageAtlasCreateInfo const& create_info) -> ImageAtlas {
+	return m_impl->create_image_atlas(create_info);
+}
+
+auto App::create_glyph_cache(GlyphCacheCreateInfo const& create_info) -> GlyphCache {
+	return m_impl->create_glyph_cache(create_info);
+}
+
+auto App::create_secondary_window(SecondaryWindowCreateInfo const& create_info) -> SecondaryWindow {
+	return m_impl->create_secondary_window(create_info);
+}
+
+auto App::get_vulkan_handles() const -> VulkanHandles { return m_impl->get_vulkan_handles(); }
+
 void App::schedule_reboot() { m_impl->schedule_reboot(); }
+
+void App::post(Task task) { m_impl->post(std::move(task)); }
+
+auto App::try_post(Task task) -> bool { return m_impl->try_post(std::move(task)); }
+
+auto App::get_post_stats() const -> PostStats { return m_impl->get_post_stats(); }
+
+auto App::get_remote_stats() const -> RemoteStats { return m_impl->get_remote_stats(); }
 } // namespace gvdi
@@ -0,0 +1,352 @@
+#include "detail/skyline_packer.hpp"
+#include "detail/texture_store.hpp"
+#include "gvdi/exception.hpp"
+#include "gvdi/image_atlas.hpp"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gvdi {
+namespace {
+constexpr auto no_page_v = std::numeric_limits<std::uint32_t>::max();
+
+struct Placement {
+	std::uint32_t page{no_page_v};
+	// position of the pixels, within the padding.
+	int x{};
+	int y{};
+};
+} // namespace
+
+class ImageAtlas::Impl {
+  public:
+	Impl(Impl const&) = delete;
+	Impl(Impl&&) = delete;
+	auto operator=(Impl const&) = delete;
+	auto operator=(Impl&&) = delete;
+
+	explicit Impl(std::shared_ptr<detail::TextureStore> const& store, ImageAtlasCreateInfo const& create_info)
+		: m_store(store), m_page_size(create_info.page_size), m_max_image_size(create_info.max_image_size),
+		  m_padding(create_info.padding), m_repack_pixels(std::max(create_info.repack_pixels_per_frame, 1u)) {
+		if (m_padding < 0 || m_max_image_size <= 0 || m_max_image_size + (2 * m_padding) > m_page_size) {
+			throw Exception{"ImageAtlas: Invalid ImageAtlasCreateInfo (max_image_size + 2 * padding must fit in page_size)"};
+		}
+	}
+
+	~Impl() = default;
+
+	auto add(Bitmap const& bitmap) -> Id {
+		validate(bitmap, "ImageAtlas::add()");
+		auto const index = acquire_index();
+		auto& image = m_images[index];
+		assign(image, bitmap);
+		image.current = place(m_pages, image);
+		if (is_repacking()) { image.next = place(m_next_pages, image); }
+		enqueue(index);
+		return Id{index};
+	}
+
+	void update(Id const id, Bitmap const& bitmap) {
+		validate(bitmap, "ImageAtlas::update()");
+		auto* image = find(id);
+		if (image == nullptr) { throw Exception{std::format("ImageAtlas::update(): Invalid Id: {}", std::uint32_t(id))}; }
+		if (bitmap.width == image->width && bitmap.height == image->height) {
+			std::memcpy(image->pixels.data(), bitmap.bytes.data(), bitmap.bytes.size());
+		} else {
+			// the old space is wasted until the next repack.
+			m_live_area -= get_area(*image);
+			assign(*image, bitmap);
+			image->current = place(m_pages, *image);
+			if (is_repacking()) { image->next = place(m_next_pages, *image); }
+		}
+		enqueue(std::uint32_t(id));
+	}
+
+	void remove(Id const id) {
+		auto* image = find(id);
+		if (image == nullptr) { return; }
+		m_live_area -= get_area(*image);
+		*image = Image{};
+		m_free_indices.push_back(std::uint32_t(id));
+	}
+
+	auto get_region(Id const id) -> AtlasRegion {
+		tick();
+		auto const* image = find(id);
+		if (image == nullptr) { return {}; }
+		// uploads enqueued before the frame is rendered: images added this frame are visible in it.
+		flush();
+		auto const scale = 1.0f / static_cast<float>(m_page_size);
+		auto const& placement = image->current;
+		return AtlasRegion{
+			.id = m_pages[placement.page].texture.get_id(),
+			.uv0 = ImVec2{float(placement.x) * scale, float(placement.y) * scale},
+			.uv1 = ImVec2{float(placement.x + image->width) * scale, float(placement.y + image->height) * scale},
+			.size = ImVec2{float(image->width), float(image->height)},
+		};
+	}
+
+	void draw(Id const id, ImVec2 size) {
+		auto const region = get_region(id);
+		if (region.size.x <= 0.0f) { return; }
+		if (size.x <= 0.0f || size.y <= 0.0f) { size = region.size; }
+		ImGui::Image(region.id, size, region.uv0, region.uv1);
+	}
+
+	[[nodiscard]] auto get_stats() const -> ImageAtlasStats {
+		auto const page_area = double(m_page_size) * double(m_page_size) * double(m_pages.size());
+		return ImageAtlasStats{
+			.images = std::uint32_t(m_images.size() - m_free_indices.size()),
+			.pages = std::uint32_t(m_pages.size()),
+			.occupancy = page_area > 0.0 ? float(double(m_live_area) / page_area) : 0.0f,
+			.total_repacks = m_total_repacks,
+			.repacking = is_repacking(),
+		};
+	}
+
+	[[nodiscard]] auto is_valid() const -> bool { return !m_store.expired(); }
+
+  private:
+	struct Image {
+		std::vector<std::byte> pixels{};
+		int width{};
+		int height{};
+		Placement current{};
+		// placement in the pages being repacked into.
+		Placement next{};
+	};
+
+	struct Page {
+		Texture texture{};
+		std::uint32_t handle{};
+		detail::SkylinePacker packer;
+	};
+
+	void validate(Bitmap const& bitmap, std::string_view const function) const {
+		if (bitmap.width <= 0 || bitmap.height <= 0) { throw Exception{std::format("{}: Invalid Bitmap size", function)}; }
+		if (bitmap.bytes.size() != std::size_t(bitmap.width) * std::size_t(bitmap.height) * 4) {
+			throw Exception{std::format("{}: Bitmap size mismatch", function)};
+		}
+		if (bitmap.width > m_max_image_size || bitmap.height > m_max_image_size) {
+			throw Exception{std::format("{}: Bitmap larger than max_image_size ({})", function, m_max_image_size)};
+		}
+	}
+
+	[[nodiscard]] auto find(Id const id) -> Image* {
+		auto const index = std::uint32_t(id);
+		if (index >= m_images.size() || m_images[index].current.page == no_page_v) { return nullptr; }
+		return &m_images[index];
+	}
+
+	[[nodiscard]] auto is_repacking() const -> bool { return !m_next_pages.empty(); }
+
+	[[nodiscard]] auto get_area(Image const& image) const -> std::int64_t {
+		return std::int64_t(image.width + (2 * m_padding)) * std::int64_t(image.height + (2 * m_padding));
+	}
+
+	auto acquire_index() -> std::uint32_t {
+		if (!m_free_indices.empty()) {
+			auto const ret = m_free_indices.back();
+			m_free_indices.pop_back();
+			return ret;
+		}
+		m_images.emplace_back();
+		return std::uint32_t(m_images.size() - 1);
+	}
+
+	void assign(Image& image, Bitmap const& bitmap) {
+		image.pixels.assign(bitmap.bytes.begin(), bitmap.bytes.end());
+		image.width = bitmap.width;
+		image.height = bitmap.height;
+		m_live_area += get_area(image);
+	}
+
+	auto place(std::vector<Page>& pages, Image const& image) -> Placement {
+		auto const width = image.width + (2 * m_padding);
+		auto const height = image.height + (2 * m_padding);
+		for (std::size_t page = 0; page < pages.size(); ++page) {
+			if (auto const position = pages[page].packer.insert(width, height)) {
+				return Placement{.page = std::uint32_t(page), .x = position->x + m_padding, .y = position->y + m_padding};
+			}
+		}
+
+		auto store = m_store.lock();
+		if (!store) { throw Exception{"ImageAtlas: Renderer destroyed"}; }
+		auto const handle = store->create(vk::Extent2D{std::uint32_t(m_page_size), std::uint32_t(m_page_size)});
+		auto packer = detail::SkylinePacker{m_page_size, m_page_size};
+		pages.push_back(Page{.texture = Texture{store, handle}, .handle = handle, .packer = std::move(packer)});
+		// max_image_size + 2 * padding fits in an empty page.
+		auto const position = pages.back().packer.insert(width, height).value();
+		return Placement{.page = std::uint32_t(pages.size() - 1), .x = position.x + m_padding, .y = position.y + m_padding};
+	}
+
+	// upload to the current pages, and to the next ones if they have already been written.
+	void enqueue(std::uint32_t const index) {
+		m_dirty.push_back(index);
+		if (is_repacking()) { m_repack_queue.push_back(index); }
+	}
+
+	void tick() {
+		auto const frame = ImGui::GetFrameCount();
+		if (frame == m_frame) { return; }
+		m_frame = frame;
+
+		if (is_repacking()) {
+			upload_repack();
+			return;
+		}
+		// space below the skyline is never reused: repack once a quarter of a page has been wasted.
+		auto used_area = std::int64_t{};
+		for (auto const& page : m_pages) { used_area += page.packer.get_used_area(); }
+		if (4 * (used_area - m_live_area) >= std::int64_t(m_page_size) * std::int64_t(m_page_size)) { begin_repack(); }
+	}
+
+	void begin_repack() {
+		auto order = std::vector<std::uint32_t>{};
+		for (std::uint32_t index = 0; index < m_images.size(); ++index) {
+			if (m_images[index].current.page != no_page_v) { order.push_back(index); }
+		}
+		// tallest first: fewer gaps under the skyline.
+		std::ranges::sort(order, [this](std::uint32_t const a, std::uint32_t const b) {
+			auto const& lhs = m_images[a];
+			auto const& rhs = m_images[b];
+			return lhs.height != rhs.height ? lhs.height > rhs.height : lhs.width > rhs.width;
+		});
+		if (order.empty()) {
+			// nothing live: drop all pages.
+			m_pages.clear();
+			++m_total_repacks;
+			return;
+		}
+		// uploaded from the back.
+		for (auto it = order.rbegin(); it != order.rend(); ++it) { m_images[*it].next = place(m_next_pages, m_images[*it]); }
+		m_repack_queue = std::move(order);
+		std::ranges::reverse(m_repack_queue);
+	}
+
+	void upload_repack() {
+		auto budget = std::int64_t(m_repack_pixels);
+		m_writes.clear();
+		while (!m_repack_queue.empty() && budget > 0) {
+			auto const index = m_repack_queue.back();
+			m_repack_queue.pop_back();
+			auto const& image = m_images[index];
+			// removed since being queued.
+			if (image.current.page == no_page_v) { continue; }
+			m_writes.push_back(PageWrite{.page = image.next.page, .index = index, .placement = image.next});
+			budget -= std::int64_t(image.width) * std::int64_t(image.height);
+		}
+		write(m_next_pages);
+		if (!m_repack_queue.empty()) { return; }
+
+		// complete: replace the pages (destruction is deferred until the GPU has finished using them).
+		for (auto& image : m_images) {
+			if (image.current.page != no_page_v) { image.current = std::exchange(image.next, {}); }
+		}
+		m_pages = std::move(m_next_pages);
+		m_next_pages.clear();
+		++m_total_repacks;
+	}
+
+	void flush() {
+		if (m_dirty.empty()) { return; }
+		m_writes.clear();
+		for (auto const index : m_dirty) {
+			auto const& image = m_images[index];
+			if (image.current.page == no_page_v) { continue; }
+			m_writes.push_back(PageWrite{.page = image.current.page, .index = index, .placement = image.current});
+		}
+		m_dirty.clear();
+		write(m_pages);
+	}
+
+	// one upload (staging buffer) per page.
+	void write(std::vector<Page> const& pages) {
+		auto store = m_store.lock();
+		if (!store || m_writes.empty()) { return; }
+		std::ranges::sort(m_writes, {}, &PageWrite::page);
+		auto writes = std::vector<detail::TextureStore::Write>{};
+		for (auto it = m_writes.begin(); it != m_writes.end();) {
+			auto const page = it->page;
+			writes.clear();
+			for (; it != m_writes.end() && it->page == page; ++it) {
+				auto const& image = m_images[it->index];
+				writes.push_back(detail::TextureStore::Write{
+					.bitmap = Bitmap{.bytes = image.pixels, .width = image.width, .height = image.height},
+					.offset = vk::Offset2D{it->placement.x, it->placement.y},
+				});
+			}
+			store->update(pages[page].handle, writes);
+		}
+		m_writes.clear();
+	}
+
+	struct PageWrite {
+		std::uint32_t page{};
+		std::uint32_t index{};
+		Placement placement{};
+	};
+
+	std::weak_ptr<detail::TextureStore> m_store;
+	int m_page_size{};
+	int m_max_image_size{};
+	int m_padding{};
+	std::uint32_t m_repack_pixels{};
+
+	std::vector<Image> m_images{};
+	std::vector<std::uint32_t> m_free_indices{};
+	std::vector<Page> m_pages{};
+	// area (including padding) of images in the atlas.
+	std::int64_t m_live_area{};
+
+	// pending uploads into m_pages.
+	std::vector<std::uint32_t> m_dirty{};
+	std::vector<PageWrite> m_writes{};
+
+	// non-empty while repacking, uploaded from the back.
+	std::vector<Page> m_next_pages{};
+	std::vector<std::uint32_t> m_repack_queue{};
+	std::uint64_t m_total_repacks{};
+
+	int m_frame{-1};
+};
+
+void ImageAtlas::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
+
+ImageAtlas::ImageAtlas(std::shared_ptr<detail::TextureStore> const& store, ImageAtlasCreateInfo const& create_info)
+	: m_impl(new Impl{store, create_info}) {}
+
+auto ImageAtlas::add(Bitmap const& bitmap) -> Id {
+	if (!m_impl) { throw Exception{"ImageAtlas::add(): Invalid ImageAtlas"}; }
+	return m_impl->add(bitmap);
+}
+
+void ImageAtlas::update(Id const id, Bitmap const& bitmap) {
+	if (!m_impl) { throw Exception{"ImageAtlas::update(): Invalid ImageAtlas"}; }
+	m_impl->update(id, bitmap);
+}
+
+void ImageAtlas::remove(Id const id) {
+	if (m_impl) { m_impl->remove(id); }
+}
+
+auto ImageAtlas::get_region(Id const id) -> AtlasRegion {
+	if (!m_impl || !m_impl->is_valid()) { return {}; }
+	return m_impl->get_region(id);
+}
+
+void ImageAtlas::draw(Id const id, ImVec2 const size) {
+	if (m_impl && m_impl->is_valid()) { m_impl->draw(id, size); }
+}
+
+auto ImageAtlas::get_stats() const -> ImageAtlasStats {
+	if (!m_impl) { return {}; }
+	return m_impl->get_stats();
+}
+
+auto ImageAtlas::is_valid() const -> bool { return m_impl && m_impl->is_valid(); }
+} // namespace gvdi
@@ -0,0 +1,65 @@
+#include "detail/mapped_file.hpp"
+#include "gvdi/exception.hpp"
+#include "gvdi/virtual_image.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+
+namespace gvdi {
+MappedImage::MappedImage(char const* path, int const width, int const height, std::size_t const offset)
+	: m_file(std::make_unique<detail::MappedFile>(path)) {
+	if (width <= 0 || height <= 0) { throw Exception{"MappedImage: Invalid size"}; }
+	auto const bytes = m_file->get_bytes();
+	auto const expected = std::size_t(width) * std::size_t(height) * 4;
+	if (offset > bytes.size() || bytes.size() - offset < expected) {
+		throw Exception{std::format("MappedImage: '{}' too small: expected {} bytes after offset {}, got {}", path, expected, offset,
+									bytes.size())};
+	}
+	m_bitmap = Bitmap{.bytes = bytes.subspan(offset, expected), .width = width, .height = height};
+}
+
+MappedImage::~MappedImage() = default;
+
+void MappedImage::read(ImageRegion const& region, std::span<std::byte> const out) const {
+	if (out.size() < std::size_t(region.width) * std::size_t(region.height) * 4) {
+		throw Exception{"MappedImage::read(): Output too small"};
+	}
+
+	auto const* pixels = m_bitmap.bytes.data();
+	auto const stride = std::size_t(m_bitmap.width) * 4;
+	auto* dst = out.data();
+	if (region.level == 0) {
+		for (int y = 0; y < region.height; ++y) {
+			auto const* src = pixels + (std::size_t(region.y + y) * stride) + (std::size_t(region.x) * 4);
+			std::memcpy(dst, src, std::size_t(region.width) * 4);
+			dst += std::size_t(region.width) * 4;
+		}
+		return;
+	}
+
+	// 2x2 samples per texel, spread over its block of (2^level)^2 pixels (clamped to the image):
+	// every texel costs the same at all levels, coarse levels only touch a fraction of the pages.
+	auto const scale = std::int64_t{1} << region.level;
+	auto const get_samples = [scale](std::int64_t const texel, std::int64_t const extent) {
+		auto const begin = texel * scale;
+		auto const span = std::min(begin + scale, extent) - begin;
+		return std::array{begin + (span / 4), begin + ((3 * span) / 4)};
+	};
+	for (int y = 0; y < region.height; ++y) {
+		auto const rows = get_samples(region.y + y, m_bitmap.height);
+		auto const* row0 = pixels + (std::size_t(rows[0]) * stride);
+		auto const* row1 = pixels + (std::size_t(rows[1]) * stride);
+		for (int x = 0; x < region.width; ++x) {
+			auto const columns = get_samples(region.x + x, m_bitmap.width);
+			auto const offset0 = std::size_t(columns[0]) * 4;
+			auto const offset1 = std::size_t(columns[1]) * 4;
+			for (std::size_t channel = 0; channel < 4; ++channel) {
+				auto const sum = unsigned(row0[offset0 + channel]) + unsigned(row0[offset1 + channel]) + unsigned(row1[offset0 + channel]) +
+								 unsigned(row1[offset1 + channel]);
+				*dst++ = std::byte((sum + 2) / 4);
+			}
+		}
+	}
+}
+} // namespace gvdi
@@ -0,0 +1,223 @@
+#include "gvdi/plot.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+
+namespace gvdi {
+namespace {
+// keeps each PrimReserve() well within 16-bit indices.
+constexpr std::size_t rects_per_batch_v{4096};
+// below this many samples per pixel column, samples are drawn individually.
+constexpr double raw_samples_per_column_v{2.0};
+constexpr double min_view_span_v{4.0};
+constexpr float zoom_step_v{0.85f};
+
+struct Mapping {
+	ImVec2 pos{};
+	ImVec2 extent{};
+	double first{};
+	double span{};
+	float y_min{};
+	float y_span{};
+
+	[[nodiscard]] auto to_x(double const sample) const -> float {
+		return pos.x + static_cast<float>((sample - first) / span * static_cast<double>(extent.x));
+	}
+
+	[[nodiscard]] auto to_y(float const value) const -> float { return pos.y + ((1.0f - ((value - y_min) / y_span)) * extent.y); }
+};
+
+class RectBatch {
+  public:
+	RectBatch(RectBatch const&) = delete;
+	RectBatch(RectBatch&&) = delete;
+	auto operator=(RectBatch const&) = delete;
+	auto operator=(RectBatch&&) = delete;
+
+	explicit RectBatch(ImDrawList& draw_list, std::size_t const count, ImU32 const color)
+		: m_draw_list(draw_list), m_remaining(count), m_color(color) {}
+
+	~RectBatch() { m_draw_list.PrimUnreserve(static_cast<int>(m_reserved * 6), static_cast<int>(m_reserved * 4)); }
+
+	void push(ImVec2 const min, ImVec2 const max) {
+		if (m_reserved == 0) {
+			m_reserved = std::min(m_remaining, rects_per_batch_v);
+			m_remaining -= m_reserved;
+			m_draw_list.PrimReserve(static_cast<int>(m_reserved * 6), static_cast<int>(m_reserved * 4));
+		}
+		m_draw_list.PrimRect(min, max, m_color);
+		--m_reserved;
+	}
+
+  private:
+	ImDrawList& m_draw_list;
+	std::size_t m_remaining;
+	std::size_t m_reserved{};
+	ImU32 m_color;
+};
+} // namespace
+
+auto Plot::draw(char const* label, std::span<Entry const> const entries, ImVec2 const size) -> bool {
+	static constexpr auto window_flags_v = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse;
+	if (!ImGui::BeginChild(label, size, ImGuiChildFlags_None, window_flags_v)) {
+		ImGui::EndChild();
+		return false;
+	}
+
+	auto const pos = ImGui::GetCursorScreenPos();
+	auto const extent = ImGui::GetContentRegionAvail();
+	if (extent.x < 1.0f || extent.y < 1.0f) {
+		ImGui::EndChild();
+		return true;
+	}
+	ImGui::InvisibleButton("##plot", extent);
+
+	auto sample_count = std::size_t{};
+	for (auto const& entry : entries) {
+		if (entry.series != nullptr) { sample_count = std::max(sample_count, entry.series->size()); }
+	}
+	update_view(sample_count, pos, extent);
+	if (auto_fit_y) { update_y_range(entries); }
+
+	auto& draw_list = *ImGui::GetWindowDrawList();
+	auto const max = ImVec2{pos.x + extent.x, pos.y + extent.y};
+	draw_list.AddRectFilled(pos, max, ImGui::GetColorU32(ImGuiCol_FrameBg));
+	draw_list.PushClipRect(pos, max, true);
+	for (auto const& entry : entries) {
+		if (entry.series != nullptr) { draw_entry(draw_list, entry, pos, extent); }
+	}
+	draw_list.PopClipRect();
+	draw_list.AddRect(pos, max, ImGui::GetColorU32(ImGuiCol_Border));
+
+	auto text = std::array<char, 32>{};
+	auto const text_color = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+	auto const padding = ImGui::GetStyle().FramePadding;
+	auto const draw_label = [&](ImVec2 const position, float const value) {
+		auto const result = std::format_to_n(text.data(), text.size(), "{:.4g}", value);
+		draw_list.AddText(position, text_color, text.data(), result.out);
+	};
+	draw_label(ImVec2{pos.x + padding.x, pos.y + padding.y}, y_max);
+	draw_label(ImVec2{pos.x + padding.x, max.y - padding.y - ImGui::GetTextLineHeight()}, y_min);
+
+	ImGui::EndChild();
+	return true;
+}
+
+void Plot::update_view(std::size_t const sample_count, ImVec2 const pos, ImVec2 const extent) {
+	auto const count = static_cast<double>(sample_count);
+	auto const& io = ImGui::GetIO();
+	auto const hovered = ImGui::IsItemHovered();
+
+	if (hovered && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) { m_fit_all = true; }
+	if (m_fit_all || m_last <= m_first) {
+		m_first = 0.0;
+		m_last = std::max(count, min_view_span_v);
+	}
+
+	auto span = m_last - m_first;
+	auto interacted = false;
+	if (hovered && io.MouseWheel != 0.0f) {
+		auto const anchor = m_first + (static_cast<double>((io.MousePos.x - pos.x) / extent.x) * span);
+		auto const factor = static_cast<double>(std::pow(zoom_step_v, io.MouseWheel));
+		auto const new_span = std::max(span * factor, min_view_span_v);
+		m_first = anchor - ((anchor - m_first) * new_span / span);
+		m_last = m_first + new_span;
+		interacted = true;
+	}
+	if (ImGui::IsItemActive() && ImGui::IsMouseDragging(ImGuiMouseButton_Left) && io.MouseDelta.x != 0.0f) {
+		auto const delta = static_cast<double>(io.MouseDelta.x / extent.x) * (m_last - m_first);
+		m_first -= delta;
+		m_last -= delta;
+		interacted = true;
+	}
+
+	span = m_last - m_first;
+	if (interacted) {
+		m_fit_all = false;
+		// the view follows appended samples while its right edge is at (or beyond) the newest one.
+		m_follow = m_last >= count;
+	} else if (m_follow && !m_fit_all) {
+		m_last = std::max(count, span);
+		m_first = m_last - span;
+	}
+}
+
+void Plot::update_y_range(std::span<Entry const> const entries) {
+	auto range = MinMax{};
+	auto const first = static_cast<std::size_t>(std::max(std::floor(m_first), 0.0));
+	auto const last = static_cast<std::size_t>(std::max(std::ceil(m_last) + 1.0, 0.0));
+	for (auto const& entry : entries) {
+		if (entry.series != nullptr) { range.add(entry.series->get_min_max(first, last)); }
+	}
+	if (range.is_empty()) { range = MinMax{.min = 0.0f, .max = 1.0f}; }
+	if (range.max - range.min <= 0.0f) {
+		range.min -= 0.5f;
+		range.max += 0.5f;
+	}
+	y_min = range.min;
+	y_max = range.max;
+}
+
+void Plot::draw_entry(ImDrawList& draw_list, Entry const& entry, ImVec2 const pos, ImVec2 const extent) {
+	auto const& series = *entry.series;
+	auto const& style = entry.style;
+	auto const y_span = y_max - y_min;
+	if (series.is_empty() || y_span <= 0.0f) { return; }
+
+	auto const mapping = Mapping{
+		.pos = pos,
+		.extent = extent,
+		.first = m_first,
+		.span = m_last - m_first,
+		.y_min = y_min,
+		.y_span = y_span,
+	};
+	auto const columns = static_cast<std::size_t>(extent.x);
+	auto const thickness = std::max(style.thickness, 1.0f);
+
+	if (mapping.span / static_cast<double>(columns) > raw_samples_per_column_v) {
+		// one bar per pixel column, spanning the minimum and maximum of its samples.
+		m_columns.resize(columns);
+		series.decimate(m_first, m_last, m_columns);
+		auto const visible = std::ranges::count_if(m_columns, [](MinMax const& mm) { return !mm.is_empty(); });
+		auto batch = RectBatch{draw_list, static_cast<std::size_t>(visible), style.color};
+		for (std::size_t column = 0; column < columns; ++column) {
+			auto const& mm = m_columns[column];
+			if (mm.is_empty()) { continue; }
+			auto top = mapping.to_y(mm.max);
+			auto bottom = mapping.to_y(mm.min);
+			if (bottom - top < thickness) {
+				auto const centre = 0.5f * (top + bottom);
+				top = centre - (0.5f * thickness);
+				bottom = centre + (0.5f * thickness);
+			}
+			auto const x = pos.x + static_cast<float>(column);
+			batch.push(ImVec2{x, top}, ImVec2{x + 1.0f, bottom});
+		}
+		return;
+	}
+
+	auto const samples = series.get_samples();
+	auto const count = static_cast<double>(samples.size());
+	auto const first = static_cast<std::size_t>(std::clamp(std::floor(m_first), 0.0, count));
+	auto const last = static_cast<std::size_t>(std::clamp(std::ceil(m_last) + 1.0, 0.0, count));
+	if (first >= last) { return; }
+
+	if (style.kind == PlotKind::Scatter) {
+		auto const half = thickness + 0.5f;
+		auto batch = RectBatch{draw_list, last - first, style.color};
+		for (auto index = first; index < last; ++index) {
+			auto const point = ImVec2{mapping.to_x(static_cast<double>(index)), mapping.to_y(samples[index])};
+			batch.push(ImVec2{point.x - half, point.y - half}, ImVec2{point.x + half, point.y + half});
+		}
+		return;
+	}
+
+	m_points.clear();
+	for (auto index = first; index < last; ++index) {
+		m_points.emplace_back(mapping.to_x(static_cast<double>(index)), mapping.to_y(samples[index]));
+	}
+	draw_list.AddPolyline(m_points.data(), static_cast<int>(m_points.size()), style.color, ImDrawFlags_None, style.thickness);
+}
+} // namespace gvdi
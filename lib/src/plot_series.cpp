@@ -0,0 +1,84 @@
+#include "gvdi/plot.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace gvdi {
+namespace {
+// independent lanes without early outs, for auto-vectorization (minps / maxps on x86, fmin / fmax on NEON).
+auto reduce(std::span<float const> const samples) -> MinMax {
+	static constexpr std::size_t lanes_v{8};
+	auto lanes = std::array<MinMax, lanes_v>{};
+	auto index = std::size_t{};
+	for (; index + lanes_v <= samples.size(); index += lanes_v) {
+		for (std::size_t lane = 0; lane < lanes_v; ++lane) { lanes[lane].add(samples[index + lane]); }
+	}
+	auto ret = MinMax{};
+	for (; index < samples.size(); ++index) { ret.add(samples[index]); }
+	for (auto const& lane : lanes) { ret.add(lane); }
+	return ret;
+}
+} // namespace
+
+void PlotSeries::append(std::span<float const> const samples) {
+	if (samples.empty()) { return; }
+	m_samples.insert(m_samples.end(), samples.begin(), samples.end());
+
+	if (m_levels.empty()) { m_levels.emplace_back(); }
+	auto const blocks = m_samples.size() / block_size_v;
+	for (auto block = m_levels.front().size(); block < blocks; ++block) {
+		m_levels.front().push_back(reduce(std::span{m_samples}.subspan(block * block_size_v, block_size_v)));
+	}
+
+	for (std::size_t level = 0; m_levels[level].size() >= 2; ++level) {
+		if (level + 1 == m_levels.size()) { m_levels.emplace_back(); }
+		auto const& lower = m_levels[level];
+		auto& upper = m_levels[level + 1];
+		for (auto index = upper.size(); index < lower.size() / 2; ++index) {
+			auto value = lower[2 * index];
+			value.add(lower[(2 * index) + 1]);
+			upper.push_back(value);
+		}
+	}
+}
+
+void PlotSeries::clear() {
+	m_samples.clear();
+	m_levels.clear();
+}
+
+auto PlotSeries::get_min_max(std::size_t first, std::size_t last) const -> MinMax {
+	last = std::min(last, m_samples.size());
+	if (first >= last) { return {}; }
+
+	auto const samples = std::span{m_samples};
+	auto const block_first = (first + block_size_v - 1) / block_size_v;
+	auto const block_last = last / block_size_v;
+	if (block_first >= block_last) { return reduce(samples.subspan(first, last - first)); }
+
+	// partial blocks at either end, then complete blocks climbing the pyramid.
+	auto ret = reduce(samples.subspan(first, (block_first * block_size_v) - first));
+	ret.add(reduce(samples.subspan(block_last * block_size_v, last - (block_last * block_size_v))));
+	auto begin = block_first;
+	auto end = block_last;
+	for (std::size_t level = 0; begin < end; ++level) {
+		auto const& blocks = m_levels[level];
+		if ((begin & 1) == 1) { ret.add(blocks[begin++]); }
+		if ((end & 1) == 1) { ret.add(blocks[--end]); }
+		begin /= 2;
+		end /= 2;
+	}
+	return ret;
+}
+
+void PlotSeries::decimate(double const first, double const last, std::span<MinMax> const out) const {
+	if (out.empty()) { return; }
+	auto const step = (last - first) / static_cast<double>(out.size());
+	auto const count = static_cast<double>(m_samples.size());
+	for (std::size_t column = 0; column < out.size(); ++column) {
+		auto const begin = std::clamp(std::floor(first + (step * static_cast<double>(column))), 0.0, count);
+		auto const end = std::clamp(std::floor(first + (step * static_cast<double>(column + 1))) + 2.0, 0.0, count);
+		out[column] = get_min_max(static_cast<std::size_t>(begin), static_cast<std::size_t>(end));
+	}
+}
+} // namespace gvdi
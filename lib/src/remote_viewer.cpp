@@ -0,0 +1,318 @@
+#include "detail/remote_protocol.hpp"
+#include "detail/socket.hpp"
+#include "gvdi/app.hpp"
+#include "gvdi/remote.hpp"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gvdi {
+namespace {
+using detail::RemoteDrawList;
+using detail::RemoteEvent;
+using detail::RemoteEventType;
+
+struct Frame {
+	ImVec2 display_pos{};
+	ImVec2 display_size{};
+	std::vector<std::shared_ptr<RemoteDrawList const>> lists{};
+};
+
+struct TextureData {
+	std::uint64_t id{};
+	int width{};
+	int height{};
+	std::vector<std::byte> pixels{};
+};
+
+// id, size, and (at least) one RGBA8 pixel.
+constexpr std::size_t min_texture_size_v{sizeof(std::uint64_t) + (2 * sizeof(std::int32_t)) + 4};
+
+auto read_texture(detail::ByteReader& reader) -> TextureData {
+	auto ret = TextureData{};
+	ret.id = reader.read<std::uint64_t>();
+	ret.width = reader.read<std::int32_t>();
+	ret.height = reader.read<std::int32_t>();
+	if (ret.width <= 0 || ret.height <= 0) { throw Exception{"RemoteViewer: Invalid texture size"}; }
+	auto const bytes = reader.read_bytes(std::size_t(ret.width) * std::size_t(ret.height) * 4);
+	ret.pixels.assign(bytes.begin(), bytes.end());
+	return ret;
+}
+
+auto read_textures(detail::ByteReader& reader) -> std::vector<TextureData> {
+	auto const count = reader.read<std::uint32_t>();
+	if (count > reader.get_remaining() / min_texture_size_v) { throw Exception{"RemoteViewer: Invalid texture count"}; }
+	auto ret = std::vector<TextureData>(count);
+	for (auto& texture : ret) { texture = read_texture(reader); }
+	return ret;
+}
+
+auto make_event(RemoteEventType const type, std::array<std::int32_t, 4> const& ints) -> RemoteEvent {
+	return RemoteEvent{.type = type, .ints = ints};
+}
+
+auto make_event(RemoteEventType const type, double const x, double const y) -> RemoteEvent {
+	return RemoteEvent{.type = type, .reals = {x, y}};
+}
+} // namespace
+
+class RemoteViewer::Impl {
+  public:
+	explicit Impl(App& app, std::string_view const address) : m_app(app), m_socket(detail::Socket::connect(address)) {
+		if (!detail::exchange_remote_hello(m_socket)) {
+			throw Exception{std::format("RemoteViewer: '{}' is not a compatible gvdi App (version, or vertex / index types)", address)};
+		}
+		static constexpr auto grey_v = std::array{std::byte{128}, std::byte{128}, std::byte{128}, std::byte{255}};
+		m_placeholder = m_app.create_texture(Bitmap{.bytes = grey_v, .width = 1, .height = 1});
+		m_stats.connected = true;
+		m_stats.connections = 1;
+		m_thread = std::jthread{[this](std::stop_token const& /*stop*/) { receive(); }};
+	}
+
+	Impl(Impl const&) = delete;
+	Impl(Impl&&) = delete;
+	auto operator=(Impl const&) = delete;
+	auto operator=(Impl&&) = delete;
+
+	// unblocks the receive thread.
+	~Impl() { m_socket.shutdown(); }
+
+	auto draw(ImDrawList& draw_list, ImVec2 const origin, ImVec2 const size) -> bool {
+		auto connected = false;
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			if (auto error = std::exchange(m_error, {})) { std::rethrow_exception(error); }
+			if (m_next) {
+				m_current = std::move(*m_next);
+				m_next.reset();
+				++m_stats.frames;
+			}
+			std::swap(m_received_textures, m_new_textures);
+			connected = m_stats.connected;
+		}
+
+		for (auto& texture : m_received_textures) {
+			auto const bitmap = Bitmap{.bytes = texture.pixels, .width = texture.width, .height = texture.height};
+			m_textures.insert_or_assign(texture.id, m_app.create_texture(bitmap));
+		}
+		m_received_textures.clear();
+
+		m_origin = origin;
+		m_size = size;
+		if (m_current) { emit(draw_list); }
+		return connected;
+	}
+
+	[[nodiscard]] auto is_connected() const -> bool {
+		auto lock = std::scoped_lock{m_mutex};
+		return m_stats.connected;
+	}
+
+	[[nodiscard]] auto get_stats() const -> RemoteStats {
+		auto lock = std::scoped_lock{m_mutex};
+		return m_stats;
+	}
+
+	void send(RemoteEvent const& event) {
+		if (!is_connected()) { return; }
+		m_event.clear();
+		auto writer = detail::ByteWriter{m_event};
+		detail::write_event(writer, event);
+		auto const sent = detail::send_remote_message(m_socket, detail::RemoteMessage::Event, m_event, false, m_scratch);
+		auto lock = std::scoped_lock{m_mutex};
+		if (sent == 0) {
+			m_stats.connected = false;
+			return;
+		}
+		++m_stats.events;
+	}
+
+	// viewer window -> remote display.
+	[[nodiscard]] auto to_remote(double const x, double const y) const -> std::pair<double, double> {
+		if (!m_current || m_size.x <= 0.0f || m_size.y <= 0.0f) { return {x, y}; }
+		auto const scale_x = double(m_current->display_size.x) / double(m_size.x);
+		auto const scale_y = double(m_current->display_size.y) / double(m_size.y);
+		return {m_current->display_pos.x + ((x - m_origin.x) * scale_x), m_current->display_pos.y + ((y - m_origin.y) * scale_y)};
+	}
+
+  private:
+	void receive() {
+		auto message = std::vector<std::byte>{};
+		auto scratch = std::vector<std::byte>{};
+		// draw lists of the previous frame, by hash: reused lists are shared, not copied.
+		auto previous = std::unordered_map<std::uint64_t, std::shared_ptr<RemoteDrawList const>>{};
+		auto current = std::unordered_map<std::uint64_t, std::shared_ptr<RemoteDrawList const>>{};
+		try {
+			while (auto const header = detail::receive_remote_message(m_socket, message, scratch)) {
+				if (header->type != detail::RemoteMessage::Frame) { continue; }
+				auto reader = detail::ByteReader{message};
+
+				auto textures = read_textures(reader);
+
+				auto frame = Frame{};
+				frame.display_pos = reader.read<ImVec2>();
+				frame.display_size = reader.read<ImVec2>();
+				[[maybe_unused]] auto const framebuffer_scale = reader.read<ImVec2>();
+
+				auto lists = std::uint64_t{};
+				auto lists_reused = std::uint64_t{};
+				current.clear();
+				auto const list_count = reader.read<std::uint32_t>();
+				for (std::uint32_t i = 0; i < list_count; ++i) {
+					auto const hash = reader.read<std::uint64_t>();
+					auto list = std::shared_ptr<RemoteDrawList const>{};
+					if (reader.read<std::uint8_t>() != 0) {
+						auto const it = previous.find(hash);
+						if (it == previous.end()) { throw Exception{"RemoteViewer: Reused draw list not in previous frame"}; }
+						list = it->second;
+						++lists_reused;
+					} else {
+						list = std::make_shared<RemoteDrawList const>(detail::read_draw_list(reader));
+						++lists;
+					}
+					current.insert_or_assign(hash, list);
+					frame.lists.push_back(std::move(list));
+				}
+				std::swap(previous, current);
+
+				auto lock = std::scoped_lock{m_mutex};
+				if (m_next) { ++m_stats.frames_skipped; }
+				m_next = std::move(frame);
+				m_stats.textures += textures.size();
+				std::ranges::move(textures, std::back_inserter(m_new_textures));
+				m_stats.lists += lists;
+				m_stats.lists_reused += lists_reused;
+				m_stats.raw_bytes += header->raw_size;
+				m_stats.wire_bytes += sizeof(detail::RemoteHeader) + header->size;
+			}
+		} catch (...) {
+			// rethrown by draw().
+			auto lock = std::scoped_lock{m_mutex};
+			m_error = std::current_exception();
+		}
+
+		auto lock = std::scoped_lock{m_mutex};
+		m_stats.connected = false;
+	}
+
+	void emit(ImDrawList& out) const {
+		auto const& frame = *m_current;
+		if (frame.display_size.x <= 0.0f || frame.display_size.y <= 0.0f) { return; }
+		auto const scale = ImVec2{m_size.x / frame.display_size.x, m_size.y / frame.display_size.y};
+		auto const to_local = [&](ImVec2 const p) {
+			return ImVec2{m_origin.x + ((p.x - frame.display_pos.x) * scale.x), m_origin.y + ((p.y - frame.display_pos.y) * scale.y)};
+		};
+
+		for (auto const& list : frame.lists) {
+			for (auto const& cmd : list->commands) {
+				if (cmd.elem_count == 0) { continue; }
+				auto const it = m_textures.find(cmd.texture);
+				auto const texture = it == m_textures.end() ? m_placeholder.get_id() : it->second.get_id();
+
+				// copy only the vertices referenced by cmd, rebased onto out's current vertex index.
+				auto const indices = std::span{list->indices}.subspan(cmd.idx_offset, cmd.elem_count);
+				auto const [min, max] = std::ranges::minmax(indices);
+				auto const vertices = std::span{list->vertices}.subspan(cmd.vtx_offset + min, std::size_t(max - min) + 1);
+
+				out.PushClipRect(to_local({cmd.clip_rect.x, cmd.clip_rect.y}), to_local({cmd.clip_rect.z, cmd.clip_rect.w}), true);
+				out.PushTextureID(texture);
+				out.PrimReserve(int(indices.size()), int(vertices.size()));
+				auto const base = out._VtxCurrentIdx;
+				for (auto vertex : vertices) {
+					vertex.pos = to_local(vertex.pos);
+					*out._VtxWritePtr++ = vertex;
+				}
+				for (auto const index : indices) { *out._IdxWritePtr++ = ImDrawIdx(base + (index - min)); }
+				out._VtxCurrentIdx += unsigned(vertices.size());
+				out.PopTextureID();
+				out.PopClipRect();
+			}
+		}
+	}
+
+	App& m_app;
+	detail::Socket m_socket;
+	Texture m_placeholder{};
+	std::unordered_map<std::uint64_t, Texture> m_textures{};
+	std::vector<TextureData> m_received_textures{};
+	std::optional<Frame> m_current{};
+	ImVec2 m_origin{};
+	ImVec2 m_size{};
+	std::vector<std::byte> m_event{};
+	std::vector<std::byte> m_scratch{};
+
+	mutable std::mutex m_mutex{};
+	std::optional<Frame> m_next{};
+	std::vector<TextureData> m_new_textures{};
+	RemoteStats m_stats{};
+	std::exception_ptr m_error{};
+
+	// declared last: joined before any other member is destroyed.
+	std::jthread m_thread{};
+};
+
+void RemoteViewer::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
+
+RemoteViewer::RemoteViewer(App& app, std::string_view const address) : m_impl(new Impl{app, address}) {}
+
+auto RemoteViewer::draw(ImDrawList& draw_list, ImVec2 const origin, ImVec2 const size) -> bool {
+	return m_impl->draw(draw_list, origin, size);
+}
+
+auto RemoteViewer::is_connected() const -> bool { return m_impl->is_connected(); }
+
+auto RemoteViewer::get_stats() const -> RemoteStats { return m_impl->get_stats(); }
+
+void RemoteViewer::on_window_resize(int const x, int const y) { m_impl->send(make_event(RemoteEventType::WindowResize, {x, y})); }
+
+void RemoteViewer::on_window_focus(bool const focused) {
+	m_impl->send(make_event(RemoteEventType::WindowFocus, {focused ? GLFW_TRUE : GLFW_FALSE}));
+}
+
+void RemoteViewer::on_key_press(int const key, int const scancode, int const mods) {
+	m_impl->send(make_event(RemoteEventType::Key, {key, scancode, GLFW_PRESS, mods}));
+}
+
+void RemoteViewer::on_key_release(int const key, int const scancode, int const mods) {
+	m_impl->send(make_event(RemoteEventType::Key, {key, scancode, GLFW_RELEASE, mods}));
+}
+
+void RemoteViewer::on_key_repeat(int const key, int const scancode, int const mods) {
+	m_impl->send(make_event(RemoteEventType::Key, {key, scancode, GLFW_REPEAT, mods}));
+}
+
+void RemoteViewer::on_character(std::uint32_t const codepoint) {
+	m_impl->send(make_event(RemoteEventType::Character, {std::int32_t(codepoint)}));
+}
+
+void RemoteViewer::on_cursor_reposition(double const x, double const y) {
+	auto const [remote_x, remote_y] = m_impl->to_remote(x, y);
+	m_impl->send(make_event(RemoteEventType::CursorPosition, remote_x, remote_y));
+}
+
+void RemoteViewer::on_cursor_enter(bool const entered) {
+	m_impl->send(make_event(RemoteEventType::CursorEnter, {entered ? GLFW_TRUE : GLFW_FALSE}));
+}
+
+void RemoteViewer::on_mouse_button_press(int const button, int const mods) {
+	m_impl->send(make_event(RemoteEventType::MouseButton, {button, GLFW_PRESS, mods}));
+}
+
+void RemoteViewer::on_mouse_button_release(int const button, int const mods) {
+	m_impl->send(make_event(RemoteEventType::MouseButton, {button, GLFW_RELEASE, mods}));
+}
+
+void RemoteViewer::on_mouse_scroll(double const x, double const y) { m_impl->send(make_event(RemoteEventType::MouseScroll, x, y)); }
+} // namespace gvdi
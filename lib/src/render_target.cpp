@@ -0,0 +1,23 @@
+#include "detail/texture_store.hpp"
+#include "gvdi/render_target.hpp"
+#include <utility>
+
+namespace gvdi {
+void RenderTarget::render(ImVec4 const& clear, Record record) const {
+	auto store = get_store();
+	if (!store) { return; }
+	store->enqueue_render(get_handle(), clear, std::move(record));
+}
+
+auto RenderTarget::get_render_pass() const -> VkRenderPass {
+	auto store = get_store();
+	if (!store) { return VK_NULL_HANDLE; }
+	return static_cast<VkRenderPass>(store->get_render_pass(get_handle()));
+}
+
+auto RenderTarget::get_depth_format() const -> VkFormat {
+	auto store = get_store();
+	if (!store) { return VK_FORMAT_UNDEFINED; }
+	return static_cast<VkFormat>(store->get_depth_format(get_handle()));
+}
+} // namespace gvdi
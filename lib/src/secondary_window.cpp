@@ -0,0 +1,48 @@
+#include "detail/window_store.hpp"
+#include "gvdi/exception.hpp"
+#include "gvdi/secondary_window.hpp"
+#include <utility>
+
+namespace gvdi {
+SecondaryWindow::SecondaryWindow(std::shared_ptr<detail::WindowStore> const& store, std::uint32_t const handle)
+	: m_store(store), m_handle(handle) {}
+
+SecondaryWindow::SecondaryWindow(SecondaryWindow&& rhs) noexcept { swap(rhs); }
+
+auto SecondaryWindow::operator=(SecondaryWindow&& rhs) noexcept -> SecondaryWindow& {
+	if (&rhs != this) {
+		release();
+		swap(rhs);
+	}
+	return *this;
+}
+
+SecondaryWindow::~SecondaryWindow() { release(); }
+
+auto SecondaryWindow::get_glfw_window() const -> GLFWwindow* {
+	auto store = m_store.lock();
+	if (!store) { return nullptr; }
+	return store->get_glfw_window(m_handle);
+}
+
+auto SecondaryWindow::get_draw_list() const -> ImDrawList& {
+	auto store = m_store.lock();
+	if (!store) { throw Exception{"SecondaryWindow::get_draw_list(): Invalid window"}; }
+	return store->get_draw_list(m_handle);
+}
+
+auto SecondaryWindow::should_close() const -> bool {
+	auto* window = get_glfw_window();
+	return window != nullptr && glfwWindowShouldClose(window) == GLFW_TRUE;
+}
+
+void SecondaryWindow::swap(SecondaryWindow& rhs) noexcept {
+	std::swap(m_store, rhs.m_store);
+	std::swap(m_handle, rhs.m_handle);
+}
+
+void SecondaryWindow::release() {
+	if (auto store = m_store.lock()) { store->destroy(m_handle); }
+	m_store.reset();
+}
+} // namespace gvdi
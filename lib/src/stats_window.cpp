@@ -0,0 +1,82 @@
+#include "gvdi/app.hpp"
+#include "gvdi/stats_window.hpp"
+#include <imgui.h>
+
+namespace gvdi {
+namespace {
+constexpr auto to_mib(std::uint64_t const bytes) -> double { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+constexpr auto to_ull(std::uint64_t const value) -> unsigned long long { return static_cast<unsigned long long>(value); }
+
+void draw_frame_stats(FrameStats const& stats) {
+	ImGui::Text("Frame: %llu (windows: %u)", to_ull(stats.frame_index), stats.windows);
+	ImGui::Text("Vulkan objects created: %u (total: %llu)", stats.vk_objects_created, to_ull(stats.total_vk_objects_created));
+	ImGui::Text("Swapchain recreations: %llu", to_ull(stats.swapchain_recreations));
+	ImGui::Text("ImGui draw calls: %u (commands: %u)", stats.imgui_draws, stats.imgui_commands);
+}
+
+void draw_alloc_stats(AllocStats const& stats) {
+	ImGui::Text("Allocations / frame: %llu (%llu bytes)", to_ull(stats.frame_allocations), to_ull(stats.frame_bytes));
+	ImGui::Text("Live: %.2f MiB (peak: %.2f MiB)", to_mib(stats.live_bytes), to_mib(stats.peak_live_bytes));
+	ImGui::Text("Total: %llu allocations, %llu frees", to_ull(stats.total_allocations), to_ull(stats.total_frees));
+	if (stats.pool_reserved_bytes > 0) { ImGui::Text("Pool reserved: %.2f MiB", to_mib(stats.pool_reserved_bytes)); }
+	if (ImGui::TreeNode("Size classes")) {
+		for (std::size_t i = 0; i < stats.histogram.size(); ++i) {
+			auto const limit = AllocStats::get_size_class_limit(i);
+			if (limit == 0) {
+				ImGui::Text("> %zu: %llu", AllocStats::get_size_class_limit(i - 1), to_ull(stats.histogram.at(i)));
+			} else {
+				ImGui::Text("<= %zu: %llu", limit, to_ull(stats.histogram.at(i)));
+			}
+		}
+		ImGui::TreePop();
+	}
+}
+
+void draw_post_stats(PostStats const& stats) {
+	ImGui::Text("post(): %llu (peak depth: %llu)", to_ull(stats.unbounded.pushed), to_ull(stats.unbounded.peak_depth));
+	ImGui::Text("try_post(): %llu, rejected: %llu (peak depth: %llu)", to_ull(stats.bounded.pushed), to_ull(stats.bounded.rejected),
+				to_ull(stats.bounded.peak_depth));
+}
+
+void draw_remote_stats(RemoteStats const& stats) {
+	ImGui::Text("Connected: %s (connections: %llu)", stats.connected ? "yes" : "no", to_ull(stats.connections));
+	ImGui::Text("Frames: %llu (skipped: %llu)", to_ull(stats.frames), to_ull(stats.frames_skipped));
+	ImGui::Text("Draw lists: %llu (reused: %llu)", to_ull(stats.lists), to_ull(stats.lists_reused));
+	ImGui::Text("Textures: %llu", to_ull(stats.textures));
+	auto const ratio = stats.wire_bytes > 0 ? static_cast<double>(stats.raw_bytes) / static_cast<double>(stats.wire_bytes) : 0.0;
+	ImGui::Text("Sent: %.2f MiB (%.2f MiB raw, ratio: %.1f)", to_mib(stats.wire_bytes), to_mib(stats.raw_bytes), ratio);
+	ImGui::Text("Input events: %llu", to_ull(stats.events));
+}
+
+void draw_memory_stats(gpu::MemoryStats const& stats) {
+	if (!stats.has_budget) { ImGui::TextUnformatted("VK_EXT_memory_budget not available"); }
+	auto const heaps = stats.get_heaps();
+	for (std::size_t i = 0; i < heaps.size(); ++i) {
+		auto const& heap = heaps[i];
+		auto const ratio = heap.budget > 0 ? static_cast<double>(heap.usage) / static_cast<double>(heap.budget) : 0.0;
+		ImGui::Text("Heap %zu%s: %.1f / %.1f MiB (size: %.1f MiB)", i, heap.device_local ? " [device]" : "", to_mib(heap.usage),
+					to_mib(heap.budget), to_mib(heap.size));
+		ImGui::ProgressBar(static_cast<float>(ratio));
+	}
+	ImGui::Separator();
+	for (std::size_t i = 0; i < gpu::memory_category_count_v; ++i) {
+		auto const category = static_cast<gpu::MemoryCategory>(i);
+		auto const name = to_string_view(category);
+		ImGui::Text("%.*s: %.2f MiB", static_cast<int>(name.size()), name.data(), to_mib(stats.get_allocated(category)));
+	}
+}
+} // namespace
+
+void show_stats_window(App const& app, bool* open) {
+	ImGui::SetNextWindowSize({400.0f, 400.0f}, ImGuiCond_FirstUseEver);
+	if (ImGui::Begin("gvdi Stats", open)) {
+		if (ImGui::CollapsingHeader("Frame", ImGuiTreeNodeFlags_DefaultOpen)) { draw_frame_stats(app.get_frame_stats()); }
+		if (ImGui::CollapsingHeader("ImGui Allocations", ImGuiTreeNodeFlags_DefaultOpen)) { draw_alloc_stats(app.get_imgui_alloc_stats()); }
+		if (ImGui::CollapsingHeader("Post Queues")) { draw_post_stats(app.get_post_stats()); }
+		if (ImGui::CollapsingHeader("Remote")) { draw_remote_stats(app.get_remote_stats()); }
+		if (ImGui::CollapsingHeader("GPU Memory", ImGuiTreeNodeFlags_DefaultOpen)) { draw_memory_stats(app.get_memory_stats()); }
+	}
+	ImGui::End();
+}
+} // namespace gvdi
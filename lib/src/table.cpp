@@ -0,0 +1,536 @@
+#include "detail/thread_pool.hpp"
+#include "gvdi/exception.hpp"
+#include "gvdi/table.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gvdi {
+namespace {
+// index of a source row in a view, 32-bit to halve the memory of views over tens of millions of rows.
+using Row = std::uint32_t;
+constexpr std::size_t max_rows_v{std::numeric_limits<Row>::max()};
+// rows per filtering job, and minimum rows per sorted run.
+constexpr std::size_t chunk_rows_v{64 * 1024};
+constexpr std::size_t cancel_interval_v{1024};
+constexpr double wheel_rows_v{3.0};
+
+struct SortKey {
+	std::size_t column{};
+	bool descending{};
+};
+
+struct Request {
+	std::uint64_t generation{};
+	std::size_t row_count{};
+	std::vector<SortKey> keys{};
+	std::string filter{};
+};
+
+struct Result {
+	std::uint64_t generation{};
+	std::vector<Row> rows{};
+};
+
+// thrown out of (parallel) sorting / filtering when a newer request supersedes it.
+struct Cancelled {};
+
+class Job {
+  public:
+	explicit Job(Request const& request, std::stop_token const& stop, std::atomic<std::uint64_t> const& generation)
+		: m_request(request), m_stop(stop), m_generation(generation) {}
+
+	[[nodiscard]] auto get_request() const -> Request const& { return m_request; }
+
+	void check_cancelled() const {
+		if (m_stop.stop_requested() || m_generation.load(std::memory_order_relaxed) != m_request.generation) { throw Cancelled{}; }
+	}
+
+  private:
+	Request const& m_request;
+	std::stop_token const& m_stop;
+	std::atomic<std::uint64_t> const& m_generation;
+};
+
+auto to_lower(char const c) -> char { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+auto get_helper_count(std::uint32_t const sort_threads) -> std::uint32_t {
+	auto const threads = sort_threads == 0 ? std::thread::hardware_concurrency() : sort_threads;
+	// the coordinating thread participates in each batch.
+	return std::max(threads, 1u) - 1;
+}
+} // namespace
+
+auto TableSource::compare(std::size_t const column, std::size_t const lhs, std::size_t const rhs) const -> std::weak_ordering {
+	auto const rows = std::array{lhs, rhs};
+	auto text = std::array<std::string, 2>{};
+	format(column, rows, text);
+	return text[0] <=> text[1];
+}
+
+auto TableSource::matches(std::size_t const row, std::string_view const filter) const -> bool {
+	auto const equal = [](char const lhs, char const rhs) { return to_lower(lhs) == to_lower(rhs); };
+	auto text = std::array<std::string, 1>{};
+	for (std::size_t column = 0; column < get_columns().size(); ++column) {
+		text[0].clear();
+		format(column, std::span{&row, 1}, text);
+		if (!std::ranges::search(text[0], filter, equal).empty()) { return true; }
+	}
+	return false;
+}
+
+class Table::Impl {
+  public:
+	Impl(Impl const&) = delete;
+	Impl(Impl&&) = delete;
+	auto operator=(Impl const&) = delete;
+	auto operator=(Impl&&) = delete;
+
+	explicit Impl(TableCreateInfo const& create_info)
+		: m_source(create_info.source), m_cached_rows(std::max(create_info.cached_rows, 64u)), m_filter_input(create_info.filter_input),
+		  m_pool(get_helper_count(create_info.sort_threads)) {
+		if (!m_source) { throw Exception{"Table: Null TableSource"}; }
+		m_columns = m_source->get_columns();
+		if (m_columns.empty()) { throw Exception{"Table: TableSource has no columns"}; }
+
+		// started last: the worker only reads the source and the pool outside the lock.
+		m_thread = std::jthread{[this](std::stop_token const& stop) { work(stop); }};
+	}
+
+	~Impl() = default;
+
+	auto draw(char const* label, ImVec2 const size) -> bool {
+		rethrow_error();
+
+		static constexpr auto window_flags_v = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse;
+		if (!ImGui::BeginChild(label, size, ImGuiChildFlags_None, window_flags_v)) {
+			ImGui::EndChild();
+			return false;
+		}
+
+		poll();
+		if (m_filter_input) { draw_filter_input(); }
+
+		auto const pos = ImGui::GetCursorScreenPos();
+		auto const extent = ImGui::GetContentRegionAvail();
+		auto const& style = ImGui::GetStyle();
+		auto const row_height = ImGui::GetTextLineHeight() + (2.0f * style.CellPadding.y);
+		if (extent.x < 1.0f || extent.y < 2.0f * row_height) {
+			ImGui::EndChild();
+			return true;
+		}
+
+		// rows fully visible below the header row.
+		auto const page_rows = static_cast<std::size_t>((extent.y - row_height) / row_height);
+		auto const view_rows = get_view_size();
+		auto const scrollable = view_rows > page_rows;
+		auto const table_width = scrollable ? extent.x - style.ScrollbarSize : extent.x;
+
+		update_scroll(view_rows, page_rows);
+		if (scrollable) {
+			auto const min = ImVec2{pos.x + table_width, pos.y + row_height};
+			draw_scrollbar(min, ImVec2{pos.x + extent.x, pos.y + extent.y}, view_rows, page_rows);
+		}
+		m_follow = scrollable && m_scroll >= static_cast<double>(view_rows - page_rows);
+
+		auto const frame = ImGui::GetFrameCount();
+		auto const first = static_cast<std::size_t>(m_scroll);
+		auto const count = std::min(page_rows + 1, view_rows - first);
+		fetch(first, count, frame);
+
+		ImGui::SetCursorScreenPos(pos);
+		if (ImGui::BeginTable("##table", static_cast<int>(m_columns.size()), table_flags_v, ImVec2{table_width, extent.y})) {
+			auto const sort_changed = setup_columns();
+			draw_rows(first, count, row_height);
+			ImGui::EndTable();
+			// after drawing: the rows fetched above are those of the current view.
+			if (sort_changed) { request(); }
+		}
+
+		ImGui::EndChild();
+		return true;
+	}
+
+	void set_filter(std::string_view const filter) {
+		if (filter == m_filter) { return; }
+		m_filter = filter;
+		auto const length = std::min(filter.size(), m_filter_buffer.size() - 1);
+		std::ranges::copy(filter.substr(0, length), m_filter_buffer.begin());
+		m_filter_buffer[length] = '\0';
+		request();
+	}
+
+	[[nodiscard]] auto get_filter() const -> std::string_view { return m_filter; }
+
+	void refresh() {
+		m_cache.clear();
+		request();
+	}
+
+	[[nodiscard]] auto get_stats() const -> TableStats {
+		return TableStats{
+			.rows = m_row_count,
+			.view_rows = get_view_size(),
+			.cached_rows = static_cast<std::uint32_t>(m_cache.size()),
+			.total_formatted = m_total_formatted,
+			.sorting = m_pending,
+		};
+	}
+
+  private:
+	static constexpr auto table_flags_v = ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable |
+										  ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_SortTristate |
+										  ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_BordersOuterH;
+
+	struct CachedRow {
+		std::vector<std::string> cells{};
+		int last_used{};
+	};
+
+	[[nodiscard]] auto is_permuted() const -> bool { return !m_sort.empty() || !m_filter.empty(); }
+
+	[[nodiscard]] auto get_view_size() const -> std::size_t { return m_view ? m_view->size() : m_row_count; }
+
+	[[nodiscard]] auto get_row(std::size_t const index) const -> std::size_t { return m_view ? (*m_view)[index] : index; }
+
+	// pick up a computed view, and recompute it if rows have been appended since.
+	void poll() {
+		auto const row_count = std::min(m_source->get_row_count(), max_rows_v);
+		auto lock = std::unique_lock{m_mutex};
+		auto result = std::move(m_result);
+		m_result.reset();
+		lock.unlock();
+
+		if (result && result->generation == m_generation.load(std::memory_order_relaxed)) {
+			m_view = std::move(result->rows);
+			m_pending = false;
+		}
+		if (row_count != m_row_count) {
+			m_row_count = row_count;
+			m_stale = is_permuted();
+		}
+		// not cancelling a pending view: it would never complete while rows are appended faster than it is computed.
+		if (m_stale && !m_pending) { request(); }
+	}
+
+	// replace any pending request (cancelling a view being computed), or drop the view if neither sorted nor filtered.
+	void request() {
+		m_stale = false;
+		auto lock = std::unique_lock{m_mutex};
+		auto const generation = m_generation.load(std::memory_order_relaxed) + 1;
+		m_generation.store(generation, std::memory_order_relaxed);
+		m_request.reset();
+		m_pending = is_permuted();
+		if (!m_pending) {
+			lock.unlock();
+			m_view.reset();
+			return;
+		}
+		m_request = Request{.generation = generation, .row_count = m_row_count, .keys = m_sort, .filter = m_filter};
+		lock.unlock();
+		m_work_cv.notify_one();
+	}
+
+	void rethrow_error() {
+		auto lock = std::unique_lock{m_mutex};
+		if (auto error = std::exchange(m_error, {})) {
+			m_pending = false;
+			std::rethrow_exception(error);
+		}
+	}
+
+	void draw_filter_input() {
+		ImGui::SetNextItemWidth(-std::numeric_limits<float>::min());
+		if (ImGui::InputTextWithHint("##filter", "Filter", m_filter_buffer.data(), m_filter_buffer.size())) {
+			m_filter = m_filter_buffer.data();
+			request();
+		}
+	}
+
+	void update_scroll(std::size_t const view_rows, std::size_t const page_rows) {
+		auto const max_first = static_cast<double>(view_rows - std::min(view_rows, page_rows));
+		if (m_follow) { m_scroll = max_first; }
+
+		auto const& io = ImGui::GetIO();
+		if (ImGui::IsWindowHovered() && io.MouseWheel != 0.0f) { m_scroll -= static_cast<double>(io.MouseWheel) * wheel_rows_v; }
+		if (ImGui::IsWindowFocused() && !ImGui::IsAnyItemActive()) {
+			auto const page = static_cast<double>(page_rows);
+			if (ImGui::IsKeyPressed(ImGuiKey_UpArrow)) { m_scroll -= 1.0; }
+			if (ImGui::IsKeyPressed(ImGuiKey_DownArrow)) { m_scroll += 1.0; }
+			if (ImGui::IsKeyPressed(ImGuiKey_PageUp)) { m_scroll -= page; }
+			if (ImGui::IsKeyPressed(ImGuiKey_PageDown)) { m_scroll += page; }
+			if (ImGui::IsKeyPressed(ImGuiKey_Home)) { m_scroll = 0.0; }
+			if (ImGui::IsKeyPressed(ImGuiKey_End)) { m_scroll = max_first; }
+		}
+		m_scroll = std::clamp(m_scroll, 0.0, max_first);
+	}
+
+	// vertical scrollbar mapping the grab position to a row index (not pixels), beside the rows below the header.
+	void draw_scrollbar(ImVec2 const min, ImVec2 const max, std::size_t const view_rows, std::size_t const page_rows) {
+		auto const& style = ImGui::GetStyle();
+		auto const max_first = static_cast<double>(view_rows - page_rows);
+		auto const track = max.y - min.y;
+		auto const grab = std::clamp(track * static_cast<float>(static_cast<double>(page_rows) / static_cast<double>(view_rows)),
+									 std::min(style.GrabMinSize, track), track);
+		auto const range = track - grab;
+		auto const grab_y = [&] { return min.y + (static_cast<float>(m_scroll / max_first) * range); };
+
+		ImGui::SetCursorScreenPos(min);
+		ImGui::InvisibleButton("##scrollbar", ImVec2{max.x - min.x, track});
+		auto const mouse_y = ImGui::GetIO().MousePos.y;
+		if (ImGui::IsItemActivated()) {
+			auto const y = grab_y();
+			// clicking the track outside the grab centres the grab on the cursor.
+			m_grab_offset = mouse_y >= y && mouse_y < y + grab ? mouse_y - y : 0.5f * grab;
+		}
+		if (ImGui::IsItemActive() && range > 0.0f) {
+			m_scroll = std::clamp(static_cast<double>((mouse_y - m_grab_offset - min.y) / range) * max_first, 0.0, max_first);
+		}
+
+		auto color = ImGuiCol_ScrollbarGrab;
+		if (ImGui::IsItemHovered()) { color = ImGuiCol_ScrollbarGrabHovered; }
+		if (ImGui::IsItemActive()) { color = ImGuiCol_ScrollbarGrabActive; }
+		auto& draw_list = *ImGui::GetWindowDrawList();
+		draw_list.AddRectFilled(min, max, ImGui::GetColorU32(ImGuiCol_ScrollbarBg));
+		auto const grab_min = ImVec2{min.x + 2.0f, grab_y()};
+		auto const grab_max = ImVec2{max.x - 2.0f, grab_min.y + grab};
+		draw_list.AddRectFilled(grab_min, grab_max, ImGui::GetColorU32(color), style.ScrollbarRounding);
+	}
+
+	// format the cells of visible rows that are not cached, a column at a time.
+	void fetch(std::size_t const first, std::size_t const count, int const frame) {
+		m_misses.clear();
+		for (auto index = first; index < first + count; ++index) {
+			auto const row = get_row(index);
+			if (auto const it = m_cache.find(row); it != m_cache.end()) {
+				it->second.last_used = frame;
+			} else {
+				m_misses.push_back(row);
+			}
+		}
+		if (m_misses.empty()) { return; }
+
+		if (m_cache.size() + m_misses.size() > m_cached_rows) {
+			std::erase_if(m_cache, [frame](auto const& entry) { return entry.second.last_used != frame; });
+		}
+		for (auto const row : m_misses) {
+			m_cache[row] = CachedRow{.cells = std::vector<std::string>(m_columns.size()), .last_used = frame};
+		}
+		for (std::size_t column = 0; column < m_columns.size(); ++column) {
+			m_texts.clear();
+			m_texts.resize(m_misses.size());
+			m_source->format(column, m_misses, m_texts);
+			for (std::size_t index = 0; index < m_misses.size(); ++index) {
+				m_cache[m_misses[index]].cells[column] = std::move(m_texts[index]);
+			}
+		}
+		m_total_formatted += m_misses.size() * m_columns.size();
+	}
+
+	// \returns true if the sort specs have changed.
+	auto setup_columns() -> bool {
+		for (auto const& column : m_columns) {
+			ImGuiTableColumnFlags flags = column.width > 0.0f ? ImGuiTableColumnFlags_WidthFixed : ImGuiTableColumnFlags_WidthStretch;
+			if (!column.sortable) { flags |= ImGuiTableColumnFlags_NoSort; }
+			ImGui::TableSetupColumn(column.name.c_str(), flags, column.width);
+		}
+		ImGui::TableHeadersRow();
+
+		auto* specs = ImGui::TableGetSortSpecs();
+		if (specs == nullptr || !specs->SpecsDirty) { return false; }
+		specs->SpecsDirty = false;
+
+		m_sort.clear();
+		for (auto const& spec : std::span{specs->Specs, static_cast<std::size_t>(specs->SpecsCount)}) {
+			m_sort.push_back(SortKey{
+				.column = static_cast<std::size_t>(spec.ColumnIndex),
+				.descending = spec.SortDirection == ImGuiSortDirection_Descending,
+			});
+		}
+		return true;
+	}
+
+	void draw_rows(std::size_t const first, std::size_t const count, float const row_height) {
+		auto const alt_color = ImGui::GetColorU32(ImGuiCol_TableRowBgAlt);
+		for (auto index = first; index < first + count; ++index) {
+			auto const& cells = m_cache[get_row(index)].cells;
+			ImGui::TableNextRow(ImGuiTableRowFlags_None, row_height);
+			// by view index: ImGuiTableFlags_RowBg would alternate by visible row, and stripes would stay put while scrolling.
+			if (index % 2 == 1) { ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, alt_color); }
+			for (std::size_t column = 0; column < cells.size(); ++column) {
+				if (!ImGui::TableSetColumnIndex(static_cast<int>(column))) { continue; }
+				auto const& text = cells[column];
+				ImGui::TextUnformatted(text.data(), text.data() + text.size());
+			}
+		}
+	}
+
+	void work(std::stop_token const& stop) {
+		while (true) {
+			auto lock = std::unique_lock{m_mutex};
+			if (!m_work_cv.wait(lock, stop, [this] { return m_request.has_value(); })) { return; }
+			auto const request = std::move(*m_request);
+			m_request.reset();
+			lock.unlock();
+
+			auto const job = Job{request, stop, m_generation};
+			auto rows = std::vector<Row>{};
+			auto error = std::exception_ptr{};
+			try {
+				filter(job, rows);
+				sort(job, rows);
+			} catch (Cancelled const&) {
+				continue;
+			} catch (...) { error = std::current_exception(); }
+
+			lock.lock();
+			if (request.generation != m_generation.load(std::memory_order_relaxed)) { continue; }
+			if (error) {
+				if (!m_error) { m_error = error; }
+			} else {
+				m_result = Result{.generation = request.generation, .rows = std::move(rows)};
+			}
+		}
+	}
+
+	// rows matching the filter in source order, in parallel chunks.
+	void filter(Job const& job, std::vector<Row>& out) {
+		auto const& request = job.get_request();
+		if (request.filter.empty()) {
+			out.resize(request.row_count);
+			std::iota(out.begin(), out.end(), Row{});
+			return;
+		}
+
+		auto matched = std::vector<std::vector<Row>>((request.row_count + chunk_rows_v - 1) / chunk_rows_v);
+		m_pool.for_each(matched.size(), [&](std::size_t const chunk, std::uint32_t /*thread*/) {
+			auto const first = chunk * chunk_rows_v;
+			auto const last = std::min(first + chunk_rows_v, request.row_count);
+			for (auto row = first; row < last; ++row) {
+				if (row % cancel_interval_v == 0) { job.check_cancelled(); }
+				if (m_source->matches(row, request.filter)) { matched[chunk].push_back(static_cast<Row>(row)); }
+			}
+		});
+
+		auto size = std::size_t{};
+		for (auto const& rows : matched) { size += rows.size(); }
+		out.reserve(size);
+		for (auto const& rows : matched) { out.insert(out.end(), rows.begin(), rows.end()); }
+	}
+
+	// sort runs in parallel, then merge adjacent pairs of runs in parallel until one remains.
+	void sort(Job const& job, std::vector<Row>& rows) {
+		auto const& keys = job.get_request().keys;
+		if (keys.empty() || rows.size() < 2) { return; }
+
+		auto const less = [&](Row const lhs, Row const rhs) {
+			job.check_cancelled();
+			for (auto const& key : keys) {
+				auto const order = m_source->compare(key.column, lhs, rhs);
+				if (order != 0) { return key.descending ? order > 0 : order < 0; }
+			}
+			// ties keep source order: the view does not depend on how rows were split into runs.
+			return lhs < rhs;
+		};
+
+		auto const runs = std::clamp(rows.size() / chunk_rows_v, std::size_t{1}, std::size_t{m_pool.get_thread_count()} + 1);
+		auto bounds = std::vector<std::size_t>(runs + 1);
+		for (std::size_t run = 0; run <= runs; ++run) { bounds[run] = rows.size() * run / runs; }
+		auto const get_run = [&](std::span<Row> const span, std::size_t const run) {
+			return span.subspan(bounds[run], bounds[run + 1] - bounds[run]);
+		};
+		m_pool.for_each(runs, [&](std::size_t const run, std::uint32_t /*thread*/) { std::ranges::sort(get_run(rows, run), less); });
+
+		auto scratch = std::vector<Row>(rows.size());
+		while (bounds.size() > 2) {
+			auto const run_count = bounds.size() - 1;
+			m_pool.for_each((run_count + 1) / 2, [&](std::size_t const pair, std::uint32_t /*thread*/) {
+				auto const lhs = get_run(rows, 2 * pair);
+				auto const rhs = 2 * pair + 1 < run_count ? get_run(rows, 2 * pair + 1) : std::span<Row>{};
+				std::ranges::merge(lhs, rhs, std::span{scratch}.subspan(bounds[2 * pair]).begin(), less);
+			});
+			std::swap(rows, scratch);
+			auto merged = std::vector<std::size_t>{};
+			for (std::size_t index = 0; index < bounds.size(); index += 2) { merged.push_back(bounds[index]); }
+			if (merged.back() != rows.size()) { merged.push_back(rows.size()); }
+			bounds = std::move(merged);
+		}
+	}
+
+	std::shared_ptr<TableSource const> m_source;
+	std::size_t m_cached_rows;
+	bool m_filter_input;
+	std::span<TableColumn const> m_columns{};
+
+	std::size_t m_row_count{};
+	std::vector<SortKey> m_sort{};
+	std::string m_filter{};
+	std::array<char, 256> m_filter_buffer{};
+	// permutation of source rows, null if neither sorted nor filtered (identity).
+	std::optional<std::vector<Row>> m_view{};
+	// a request has been made since the current view was computed.
+	bool m_pending{};
+	// rows have been appended since the current view was requested.
+	bool m_stale{};
+
+	double m_scroll{};
+	float m_grab_offset{};
+	bool m_follow{};
+
+	std::unordered_map<std::size_t, CachedRow> m_cache{};
+	std::vector<std::size_t> m_misses{};
+	std::vector<std::string> m_texts{};
+	std::uint64_t m_total_formatted{};
+
+	// bumped by the UI thread (under m_mutex) for each request, polled by the worker to cancel superseded ones.
+	std::atomic<std::uint64_t> m_generation{};
+	std::mutex m_mutex{};
+	std::condition_variable_any m_work_cv{};
+	std::optional<Request> m_request{};
+	std::optional<Result> m_result{};
+	std::exception_ptr m_error{};
+
+	detail::ThreadPool m_pool;
+	// declared last: joined before any other member is destroyed.
+	std::jthread m_thread{};
+};
+
+void Table::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
+
+Table::Table(TableCreateInfo const& create_info) : m_impl(new Impl{create_info}) {}
+
+auto Table::draw(char const* label, ImVec2 const size) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->draw(label, size);
+}
+
+void Table::set_filter(std::string_view const filter) {
+	if (m_impl) { m_impl->set_filter(filter); }
+}
+
+auto Table::get_filter() const -> std::string_view {
+	if (!m_impl) { return {}; }
+	return m_impl->get_filter();
+}
+
+void Table::refresh() {
+	if (m_impl) { m_impl->refresh(); }
+}
+
+auto Table::get_stats() const -> TableStats {
+	if (!m_impl) { return {}; }
+	return m_impl->get_stats();
+}
+} // namespace gvdi
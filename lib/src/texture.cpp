@@ -0,0 +1,37 @@
+#include "detail/texture_store.hpp"
+#include "gvdi/texture.hpp"
+#include <utility>
+
+namespace gvdi {
+Texture::Texture(std::shared_ptr<detail::TextureStore> const& store, std::uint32_t const handle) : m_store(store), m_handle(handle) {
+	m_id = store->get_texture_id(handle);
+	auto const extent = store->get_extent(handle);
+	m_size = ImVec2{static_cast<float>(extent.width), static_cast<float>(extent.height)};
+}
+
+Texture::Texture(Texture&& rhs) noexcept { swap(rhs); }
+
+auto Texture::operator=(Texture&& rhs) noexcept -> Texture& {
+	if (&rhs != this) {
+		release();
+		swap(rhs);
+	}
+	return *this;
+}
+
+Texture::~Texture() { release(); }
+
+void Texture::swap(Texture& rhs) noexcept {
+	std::swap(m_store, rhs.m_store);
+	std::swap(m_handle, rhs.m_handle);
+	std::swap(m_id, rhs.m_id);
+	std::swap(m_size, rhs.m_size);
+}
+
+void Texture::release() {
+	if (auto store = m_store.lock()) { store->destroy(m_handle); }
+	m_store.reset();
+	m_id = {};
+	m_size = {};
+}
+} // namespace gvdi
@@ -0,0 +1,551 @@
+#include "detail/texture_store.hpp"
+#include "gvdi/exception.hpp"
+#include "gvdi/virtual_image.hpp"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gvdi {
+namespace {
+constexpr int tile_size_v{VirtualImage::tile_size_v};
+constexpr int slot_size_v{tile_size_v + 2};
+// 15 * 258 = 3870: within the minimum guaranteed maxImageDimension2D (4096).
+constexpr std::uint32_t page_columns_v{15};
+constexpr std::uint32_t page_slots_v{page_columns_v * page_columns_v};
+constexpr auto no_slot_v = std::numeric_limits<std::uint32_t>::max();
+
+constexpr double max_zoom_v{32.0};
+constexpr double zoom_step_v{0.85};
+
+struct Level {
+	int width{};
+	int height{};
+	int columns{};
+	int rows{};
+	std::uint32_t first_tile{};
+};
+
+struct Tile {
+	std::uint32_t level{};
+	int x{};
+	int y{};
+};
+
+// image space rect (in level 0 pixels).
+struct Rect {
+	double x0{};
+	double y0{};
+	double x1{};
+	double y1{};
+};
+} // namespace
+
+class VirtualImage::Impl {
+  public:
+	Impl(Impl const&) = delete;
+	Impl(Impl&&) = delete;
+	auto operator=(Impl const&) = delete;
+	auto operator=(Impl&&) = delete;
+
+	explicit Impl(std::shared_ptr<detail::TextureStore> const& store, VirtualImageCreateInfo const& create_info)
+		: m_store(store), m_source(create_info.source), m_uploads_per_frame(std::max(create_info.uploads_per_frame, 1u)) {
+		if (!m_source) { throw Exception{"VirtualImage: Null ImageSource"}; }
+		auto const width = m_source->get_width();
+		auto const height = m_source->get_height();
+		if (width <= 0 || height <= 0) { throw Exception{"VirtualImage: Invalid ImageSource size"}; }
+
+		create_levels(width, height);
+		create_pages(*store, std::max(create_info.cache_tiles, 16u));
+
+		auto const threads = std::max(create_info.decode_threads, 1u);
+		auto const buffers = (2 * m_uploads_per_frame) + threads;
+		m_buffers.resize(buffers, std::vector<std::byte>(std::size_t(slot_size_v) * slot_size_v * 4));
+		for (std::uint32_t buffer = 0; buffer < buffers; ++buffer) { m_free_buffers.push_back(buffer); }
+
+		// started last: workers only read immutable members (levels, source, buffers) outside the lock.
+		m_threads.reserve(threads);
+		for (std::uint32_t thread = 0; thread < threads; ++thread) {
+			m_threads.emplace_back([this](std::stop_token const& stop) { work(stop); });
+		}
+	}
+
+	~Impl() = default;
+
+	auto draw(char const* label, ImVec2 const size) -> bool {
+		auto store = m_store.lock();
+		if (!store) { return false; }
+		rethrow_error();
+
+		static constexpr auto window_flags_v = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse;
+		if (!ImGui::BeginChild(label, size, ImGuiChildFlags_None, window_flags_v)) {
+			ImGui::EndChild();
+			return false;
+		}
+
+		auto const pos = ImGui::GetCursorScreenPos();
+		auto const extent = ImGui::GetContentRegionAvail();
+		if (extent.x < 1.0f || extent.y < 1.0f) {
+			ImGui::EndChild();
+			return true;
+		}
+		ImGui::InvisibleButton("##virtual_image", extent);
+		update_view(pos, extent);
+
+		auto const frame = ImGui::GetFrameCount();
+		collect(pos, extent, frame);
+
+		auto& draw_list = *ImGui::GetWindowDrawList();
+		auto const max = ImVec2{pos.x + extent.x, pos.y + extent.y};
+		draw_list.AddRectFilled(pos, max, ImGui::GetColorU32(ImGuiCol_FrameBg));
+		draw_list.PushClipRect(pos, max, true);
+		// grouped by page: consecutive images with the same texture share a draw command.
+		std::ranges::sort(m_quads, {}, &Quad::page);
+		for (auto const& quad : m_quads) { draw_list.AddImage(m_pages[quad.page].get_id(), quad.min, quad.max, quad.uv_min, quad.uv_max); }
+		draw_list.PopClipRect();
+
+		request();
+		upload(*store, frame);
+
+		ImGui::EndChild();
+		return true;
+	}
+
+	void fit() { m_fit = true; }
+
+	[[nodiscard]] auto get_image_size() const -> ImVec2 {
+		return ImVec2{static_cast<float>(m_source->get_width()), static_cast<float>(m_source->get_height())};
+	}
+
+	[[nodiscard]] auto get_stats() const -> VirtualImageStats {
+		return VirtualImageStats{
+			.resident_tiles = m_resident,
+			.pending_tiles = m_pending,
+			.total_uploads = m_total_uploads,
+			.level = m_level,
+			.level_count = static_cast<std::uint32_t>(m_levels.size()),
+		};
+	}
+
+	[[nodiscard]] auto is_valid() const -> bool { return !m_store.expired(); }
+
+  private:
+	struct Slot {
+		std::uint32_t tile{no_slot_v};
+		int last_used{-1};
+	};
+
+	struct Decoded {
+		std::uint32_t tile{};
+		std::uint32_t buffer{};
+		int width{};
+		int height{};
+	};
+
+	struct Quad {
+		std::uint32_t page{};
+		ImVec2 min{};
+		ImVec2 max{};
+		ImVec2 uv_min{};
+		ImVec2 uv_max{};
+	};
+
+	void create_levels(int const width, int const height) {
+		auto total = std::uint64_t{};
+		for (std::uint32_t level = 0;; ++level) {
+			auto const scale = std::int64_t{1} << level;
+			auto const level_width = static_cast<int>((width + scale - 1) / scale);
+			auto const level_height = static_cast<int>((height + scale - 1) / scale);
+			auto const columns = (level_width + tile_size_v - 1) / tile_size_v;
+			auto const rows = (level_height + tile_size_v - 1) / tile_size_v;
+			m_levels.push_back(Level{
+				.width = level_width,
+				.height = level_height,
+				.columns = columns,
+				.rows = rows,
+				.first_tile = static_cast<std::uint32_t>(total),
+			});
+			total += std::uint64_t(columns) * std::uint64_t(rows);
+			if (total >= no_slot_v) { throw Exception{"VirtualImage: Image too large"}; }
+			if (columns == 1 && rows == 1) { break; }
+		}
+		m_tile_slots.resize(total, no_slot_v);
+	}
+
+	void create_pages(detail::TextureStore& store, std::uint32_t const slots) {
+		m_slots.resize(slots);
+		for (std::uint32_t first = 0; first < slots; first += page_slots_v) {
+			auto const count = std::min(slots - first, page_slots_v);
+			auto const columns = std::min(count, page_columns_v);
+			auto const rows = (count + page_columns_v - 1) / page_columns_v;
+			auto const extent = vk::Extent2D{columns * slot_size_v, rows * slot_size_v};
+			auto const handle = store.create(extent);
+			// constructed immediately: releases the handle if a later page throws.
+			m_pages.emplace_back(m_store.lock(), handle);
+			m_page_handles.push_back(handle);
+		}
+	}
+
+	[[nodiscard]] auto get_tile_id(std::uint32_t const level, int const x, int const y) const -> std::uint32_t {
+		auto const& l = m_levels[level];
+		return l.first_tile + static_cast<std::uint32_t>((y * l.columns) + x);
+	}
+
+	[[nodiscard]] auto get_tile(std::uint32_t const id) const -> Tile {
+		auto level = static_cast<std::uint32_t>(m_levels.size() - 1);
+		while (m_levels[level].first_tile > id) { --level; }
+		auto const index = static_cast<int>(id - m_levels[level].first_tile);
+		auto const columns = m_levels[level].columns;
+		return Tile{.level = level, .x = index % columns, .y = index / columns};
+	}
+
+	[[nodiscard]] auto get_tile_rect(Tile const& tile) const -> Rect {
+		auto const& level = m_levels[tile.level];
+		auto const scale = static_cast<double>(std::int64_t{1} << tile.level);
+		auto const x0 = tile.x * tile_size_v;
+		auto const y0 = tile.y * tile_size_v;
+		return Rect{
+			.x0 = x0 * scale,
+			.y0 = y0 * scale,
+			.x1 = std::min(x0 + tile_size_v, level.width) * scale,
+			.y1 = std::min(y0 + tile_size_v, level.height) * scale,
+		};
+	}
+
+	void update_view(ImVec2 const pos, ImVec2 const extent) {
+		auto const& io = ImGui::GetIO();
+		auto const hovered = ImGui::IsItemHovered();
+		auto const width = static_cast<double>(m_source->get_width());
+		auto const height = static_cast<double>(m_source->get_height());
+		auto const fit_scale = std::min(static_cast<double>(extent.x) / width, static_cast<double>(extent.y) / height);
+
+		if (hovered && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) { m_fit = true; }
+		if (m_fit) {
+			m_scale = fit_scale;
+			m_offset_x = 0.5 * (width - (static_cast<double>(extent.x) / m_scale));
+			m_offset_y = 0.5 * (height - (static_cast<double>(extent.y) / m_scale));
+		}
+
+		if (hovered && io.MouseWheel != 0.0f) {
+			auto const cursor_x = static_cast<double>(io.MousePos.x - pos.x);
+			auto const cursor_y = static_cast<double>(io.MousePos.y - pos.y);
+			auto const anchor_x = m_offset_x + (cursor_x / m_scale);
+			auto const anchor_y = m_offset_y + (cursor_y / m_scale);
+			auto const scale = m_scale / std::pow(zoom_step_v, static_cast<double>(io.MouseWheel));
+			m_scale = std::clamp(scale, std::min(0.5 * fit_scale, max_zoom_v), max_zoom_v);
+			m_offset_x = anchor_x - (cursor_x / m_scale);
+			m_offset_y = anchor_y - (cursor_y / m_scale);
+			m_fit = false;
+		}
+		if (ImGui::IsItemActive() && ImGui::IsMouseDragging(ImGuiMouseButton_Left)) {
+			m_offset_x -= static_cast<double>(io.MouseDelta.x) / m_scale;
+			m_offset_y -= static_cast<double>(io.MouseDelta.y) / m_scale;
+			if (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f) { m_fit = false; }
+		}
+	}
+
+	// select the level whose texels are closest to screen pixels, and gather quads of resident tiles (or ancestors) covering the view.
+	void collect(ImVec2 const pos, ImVec2 const extent, int const frame) {
+		auto const top = static_cast<std::uint32_t>(m_levels.size() - 1);
+		auto const lod = std::round(std::log2(1.0 / m_scale));
+		m_level = static_cast<std::uint32_t>(std::clamp(lod, 0.0, static_cast<double>(top)));
+
+		m_quads.clear();
+		m_wanted.clear();
+		m_pending = 0;
+
+		auto const view = Rect{
+			.x0 = m_offset_x,
+			.y0 = m_offset_y,
+			.x1 = m_offset_x + (static_cast<double>(extent.x) / m_scale),
+			.y1 = m_offset_y + (static_cast<double>(extent.y) / m_scale),
+		};
+		auto const& level = m_levels[m_level];
+		auto const span = static_cast<double>(std::int64_t{tile_size_v} << m_level);
+		auto const first_x = std::clamp(static_cast<int>(std::floor(view.x0 / span)), 0, level.columns - 1);
+		auto const first_y = std::clamp(static_cast<int>(std::floor(view.y0 / span)), 0, level.rows - 1);
+		auto const last_x = std::clamp(static_cast<int>(std::floor(view.x1 / span)), 0, level.columns - 1);
+		auto const last_y = std::clamp(static_cast<int>(std::floor(view.y1 / span)), 0, level.rows - 1);
+		auto const centre_x = 0.5 * (view.x0 + view.x1);
+		auto const centre_y = 0.5 * (view.y0 + view.y1);
+
+		for (auto y = first_y; y <= last_y; ++y) {
+			for (auto x = first_x; x <= last_x; ++x) {
+				auto const tile = Tile{.level = m_level, .x = x, .y = y};
+				auto const rect = get_tile_rect(tile);
+				if (rect.x1 <= view.x0 || rect.y1 <= view.y0 || rect.x0 >= view.x1 || rect.y0 >= view.y1) { continue; }
+
+				auto const id = get_tile_id(m_level, x, y);
+				if (m_tile_slots[id] == no_slot_v) {
+					m_wanted.push_back(Wanted{.tile = id, .distance = distance(rect, centre_x, centre_y)});
+					++m_pending;
+				}
+				// the tile itself if resident, otherwise its nearest resident ancestor.
+				for (auto ancestor = m_level; ancestor <= top; ++ancestor) {
+					auto const shift = ancestor - m_level;
+					auto const ancestor_id = get_tile_id(ancestor, x >> shift, y >> shift);
+					if (m_tile_slots[ancestor_id] == no_slot_v) { continue; }
+					add_quad(Tile{.level = ancestor, .x = x >> shift, .y = y >> shift}, ancestor_id, rect, pos, frame);
+					break;
+				}
+			}
+		}
+
+		// the single tile of the top level is always wanted first: every other tile falls back to it.
+		auto const root = get_tile_id(top, 0, 0);
+		if (m_tile_slots[root] == no_slot_v) {
+			m_wanted.push_back(Wanted{.tile = root, .distance = -1.0});
+		} else {
+			m_slots[m_tile_slots[root]].last_used = frame;
+		}
+	}
+
+	[[nodiscard]] static auto distance(Rect const& rect, double const x, double const y) -> double {
+		auto const dx = (0.5 * (rect.x0 + rect.x1)) - x;
+		auto const dy = (0.5 * (rect.y0 + rect.y1)) - y;
+		return (dx * dx) + (dy * dy);
+	}
+
+	// draw rect (image space) from the resident tile id.
+	void add_quad(Tile const& tile, std::uint32_t const id, Rect const& rect, ImVec2 const pos, int const frame) {
+		auto const slot = m_tile_slots[id];
+		m_slots[slot].last_used = frame;
+
+		auto const page = slot / page_slots_v;
+		auto const index = slot % page_slots_v;
+		auto const page_size = m_pages[page].get_size();
+		auto const scale = static_cast<double>(std::int64_t{1} << tile.level);
+		auto const origin = get_tile_rect(tile);
+		// texels of the tile start after the border of its slot.
+		auto const texel_x = static_cast<double>((index % page_columns_v) * slot_size_v) + 1.0;
+		auto const texel_y = static_cast<double>((index / page_columns_v) * slot_size_v) + 1.0;
+		auto const to_u = [&](double const x) { return static_cast<float>((texel_x + ((x - origin.x0) / scale)) / page_size.x); };
+		auto const to_v = [&](double const y) { return static_cast<float>((texel_y + ((y - origin.y0) / scale)) / page_size.y); };
+		auto const to_x = [&](double const x) { return pos.x + static_cast<float>((x - m_offset_x) * m_scale); };
+		auto const to_y = [&](double const y) { return pos.y + static_cast<float>((y - m_offset_y) * m_scale); };
+
+		m_quads.push_back(Quad{
+			.page = page,
+			.min = ImVec2{to_x(rect.x0), to_y(rect.y0)},
+			.max = ImVec2{to_x(rect.x1), to_y(rect.y1)},
+			.uv_min = ImVec2{to_u(rect.x0), to_v(rect.y0)},
+			.uv_max = ImVec2{to_u(rect.x1), to_v(rect.y1)},
+		});
+	}
+
+	// replace pending requests with the tiles wanted this frame (nearest the centre of the view first).
+	void request() {
+		std::ranges::sort(m_wanted, std::ranges::greater{}, &Wanted::distance);
+		auto lock = std::unique_lock{m_mutex};
+		m_requests.clear();
+		for (auto const& wanted : m_wanted) {
+			if (std::ranges::find(m_active, wanted.tile) != m_active.end()) { continue; }
+			if (std::ranges::find(m_decoded, wanted.tile, &Decoded::tile) != m_decoded.end()) { continue; }
+			m_requests.push_back(wanted.tile);
+		}
+		lock.unlock();
+		if (!m_requests.empty()) { m_work_cv.notify_all(); }
+	}
+
+	void upload(detail::TextureStore& store, int const frame) {
+		auto lock = std::unique_lock{m_mutex};
+		auto const count = std::min(m_decoded.size(), std::size_t{m_uploads_per_frame});
+		m_ready.assign(m_decoded.begin(), m_decoded.begin() + static_cast<std::ptrdiff_t>(count));
+		m_decoded.erase(m_decoded.begin(), m_decoded.begin() + static_cast<std::ptrdiff_t>(count));
+		lock.unlock();
+
+		auto uploaded = std::size_t{};
+		for (; uploaded < m_ready.size(); ++uploaded) {
+			auto const& decoded = m_ready[uploaded];
+			if (m_tile_slots[decoded.tile] != no_slot_v) { continue; }
+			auto const slot = evict(frame);
+			if (slot == no_slot_v) { break; }
+
+			auto const page = slot / page_slots_v;
+			auto const index = slot % page_slots_v;
+			auto const offset = vk::Offset2D{
+				static_cast<std::int32_t>((index % page_columns_v) * slot_size_v),
+				static_cast<std::int32_t>((index / page_columns_v) * slot_size_v),
+			};
+			auto const bytes = std::span{m_buffers[decoded.buffer]}.first(std::size_t(decoded.width) * std::size_t(decoded.height) * 4);
+			store.update(m_page_handles[page], Bitmap{.bytes = bytes, .width = decoded.width, .height = decoded.height}, offset);
+
+			m_slots[slot] = Slot{.tile = decoded.tile, .last_used = frame};
+			m_tile_slots[decoded.tile] = slot;
+			++m_resident;
+			++m_total_uploads;
+		}
+
+		lock.lock();
+		for (std::size_t index = 0; index < m_ready.size(); ++index) {
+			// tiles without a free slot are retried next frame.
+			if (index >= uploaded) {
+				m_decoded.push_back(m_ready[index]);
+			} else {
+				m_free_buffers.push_back(m_ready[index].buffer);
+			}
+		}
+		lock.unlock();
+		if (uploaded > 0) { m_work_cv.notify_all(); }
+	}
+
+	// least recently drawn slot not drawn this frame, no_slot_v if none.
+	auto evict(int const frame) -> std::uint32_t {
+		auto ret = no_slot_v;
+		for (std::uint32_t slot = 0; slot < m_slots.size(); ++slot) {
+			auto const last_used = m_slots[slot].last_used;
+			if (last_used < frame && (ret == no_slot_v || last_used < m_slots[ret].last_used)) { ret = slot; }
+		}
+		if (ret != no_slot_v && m_slots[ret].tile != no_slot_v) {
+			m_tile_slots[m_slots[ret].tile] = no_slot_v;
+			--m_resident;
+		}
+		return ret;
+	}
+
+	void rethrow_error() {
+		auto lock = std::unique_lock{m_mutex};
+		if (auto error = std::exchange(m_error, {})) { std::rethrow_exception(error); }
+	}
+
+	void work(std::stop_token const& stop) {
+		auto scratch = std::vector<std::byte>{};
+		while (true) {
+			auto lock = std::unique_lock{m_mutex};
+			auto const ready = [this] { return !m_requests.empty() && !m_free_buffers.empty(); };
+			if (!m_work_cv.wait(lock, stop, ready)) { return; }
+			auto decoded = Decoded{.tile = m_requests.back(), .buffer = m_free_buffers.back()};
+			m_requests.pop_back();
+			m_free_buffers.pop_back();
+			m_active.push_back(decoded.tile);
+			lock.unlock();
+
+			auto error = std::exception_ptr{};
+			try {
+				decode(decoded, scratch);
+			} catch (...) { error = std::current_exception(); }
+
+			lock.lock();
+			std::erase(m_active, decoded.tile);
+			if (error) {
+				if (!m_error) { m_error = error; }
+				m_free_buffers.push_back(decoded.buffer);
+			} else {
+				m_decoded.push_back(decoded);
+			}
+		}
+	}
+
+	// read a tile and its border (replicating edge pixels) into its buffer.
+	void decode(Decoded& out, std::vector<std::byte>& scratch) {
+		auto const tile = get_tile(out.tile);
+		auto const& level = m_levels[tile.level];
+		auto const x0 = tile.x * tile_size_v;
+		auto const y0 = tile.y * tile_size_v;
+		auto const width = std::min(tile_size_v, level.width - x0);
+		auto const height = std::min(tile_size_v, level.height - y0);
+
+		auto const region = ImageRegion{
+			.level = tile.level,
+			.x = std::max(x0 - 1, 0),
+			.y = std::max(y0 - 1, 0),
+			.width = std::min(x0 + width + 1, level.width) - std::max(x0 - 1, 0),
+			.height = std::min(y0 + height + 1, level.height) - std::max(y0 - 1, 0),
+		};
+		scratch.resize(std::size_t(region.width) * std::size_t(region.height) * 4);
+		m_source->read(region, scratch);
+
+		out.width = width + 2;
+		out.height = height + 2;
+		auto* dst = m_buffers[out.buffer].data();
+		for (int y = 0; y < out.height; ++y) {
+			auto const src_y = std::clamp(y0 - 1 + y, region.y, region.y + region.height - 1) - region.y;
+			auto const* src_row = scratch.data() + (std::size_t(src_y) * std::size_t(region.width) * 4);
+			for (int x = 0; x < out.width; ++x) {
+				auto const src_x = std::clamp(x0 - 1 + x, region.x, region.x + region.width - 1) - region.x;
+				std::memcpy(dst, src_row + (std::size_t(src_x) * 4), 4);
+				dst += 4;
+			}
+		}
+	}
+
+	struct Wanted {
+		std::uint32_t tile{};
+		double distance{};
+	};
+
+	std::weak_ptr<detail::TextureStore> m_store;
+	std::shared_ptr<ImageSource const> m_source;
+	std::uint32_t m_uploads_per_frame;
+
+	std::vector<Level> m_levels{};
+	// slot of each tile (of all levels), no_slot_v if not resident.
+	std::vector<std::uint32_t> m_tile_slots{};
+	std::vector<Slot> m_slots{};
+	std::vector<Texture> m_pages{};
+	std::vector<std::uint32_t> m_page_handles{};
+
+	double m_offset_x{};
+	double m_offset_y{};
+	double m_scale{1.0};
+	bool m_fit{true};
+
+	std::uint32_t m_level{};
+	std::uint32_t m_resident{};
+	std::uint32_t m_pending{};
+	std::uint64_t m_total_uploads{};
+	std::vector<Quad> m_quads{};
+	std::vector<Wanted> m_wanted{};
+	std::vector<Decoded> m_ready{};
+
+	// fixed after construction: each buffer is accessed by either the main thread or a single worker at a time.
+	std::vector<std::vector<std::byte>> m_buffers{};
+
+	std::mutex m_mutex{};
+	std::condition_variable_any m_work_cv{};
+	// highest priority last.
+	std::vector<std::uint32_t> m_requests{};
+	std::vector<std::uint32_t> m_active{};
+	std::vector<Decoded> m_decoded{};
+	std::vector<std::uint32_t> m_free_buffers{};
+	std::exception_ptr m_error{};
+
+	// declared last: joined before any other member is destroyed.
+	std::vector<std::jthread> m_threads{};
+};
+
+void VirtualImage::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
+
+VirtualImage::VirtualImage(std::shared_ptr<detail::TextureStore> const& store, VirtualImageCreateInfo const& create_info)
+	: m_impl(new Impl{store, create_info}) {}
+
+auto VirtualImage::draw(char const* label, ImVec2 const size) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->draw(label, size);
+}
+
+void VirtualImage::fit() {
+	if (m_impl) { m_impl->fit(); }
+}
+
+auto VirtualImage::get_image_size() const -> ImVec2 {
+	if (!m_impl) { return {}; }
+	return m_impl->get_image_size();
+}
+
+auto VirtualImage::get_stats() const -> VirtualImageStats {
+	if (!m_impl) { return {}; }
+	return m_impl->get_stats();
+}
+
+auto VirtualImage::is_valid() const -> bool { return m_impl && m_impl->is_valid(); }
+} // namespace gvdi
@@ -0,0 +1,111 @@
+#include "GLFW/glfw3.h"
+#include "gvdi/app.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Posts tasks to a headless App from multiple threads (via post() and try_post()),
+// and checks that they all run on the main thread, and the post counters.
+
+namespace {
+using namespace std::chrono_literals;
+
+// Not a test failure: no Vulkan driver, or no headless surface support.
+constexpr auto skip_v = 77;
+constexpr auto timeout_v = 10s;
+constexpr int producers_v{4};
+constexpr int posts_v{1000};
+constexpr std::size_t bounded_capacity_v{8};
+
+class App : public gvdi::App {
+  public:
+	App() : gvdi::App(bounded_capacity_v) {}
+
+	[[nodiscard]] auto has_started() const -> bool { return m_started; }
+	[[nodiscard]] auto get_failures() const -> int { return m_failures; }
+
+  private:
+	void stage_initialize() final {
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		gvdi::App::stage_initialize();
+	}
+
+	auto create_glfw_window() -> GLFWwindow* final { return create_windowed_window("gvdi app post", 640, 360); }
+
+	void pre_first_frame() final {
+		m_started = true;
+		m_deadline = std::chrono::steady_clock::now() + timeout_v;
+		for (int i = 0; i < producers_v; ++i) {
+			m_producers.emplace_back([this] {
+				for (int j = 0; j < posts_v; ++j) {
+					post([this] { on_task(); });
+					// the bounded queue is drained once per frame: some of these are expected to be rejected.
+					if (try_post([this] { on_task(); })) { m_accepted.fetch_add(1, std::memory_order_relaxed); }
+				}
+				m_finished.fetch_add(1, std::memory_order_release);
+			});
+		}
+	}
+
+	void update() final {
+		if (m_finished.load(std::memory_order_acquire) < producers_v && std::chrono::steady_clock::now() < m_deadline) { return; }
+		// tasks posted after this frame's drain are run before the next update().
+		if (!std::exchange(m_drained, true)) { return; }
+
+		auto const accepted = m_accepted.load(std::memory_order_relaxed);
+		auto const stats = get_post_stats();
+		check(m_executed == (producers_v * posts_v) + accepted, "not all posted tasks were run");
+		check(stats.unbounded.pushed == std::uint64_t(producers_v * posts_v), "unbounded pushed count");
+		check(stats.unbounded.rejected == 0, "unbounded rejected count");
+		check(stats.bounded.pushed == std::uint64_t(accepted), "bounded pushed count");
+		check(stats.bounded.pushed + stats.bounded.rejected == std::uint64_t(producers_v * posts_v), "bounded rejected count");
+		check(stats.bounded.peak_depth <= bounded_capacity_v, "bounded peak depth");
+		set_should_close_window(true);
+	}
+
+	void post_event_loop() final { m_producers.clear(); }
+
+	void on_task() {
+		check(std::this_thread::get_id() == m_main_thread, "task was run on another thread");
+		++m_executed;
+	}
+
+	void check(bool const condition, std::string_view const what) {
+		if (condition) { return; }
+		++m_failures;
+		std::cerr << std::format("FAILED: {}\n", what);
+	}
+
+	std::thread::id m_main_thread{std::this_thread::get_id()};
+	std::vector<std::jthread> m_producers{};
+	std::atomic<int> m_accepted{};
+	std::atomic<int> m_finished{};
+	std::chrono::steady_clock::time_point m_deadline{};
+	int m_executed{};
+	int m_failures{};
+	bool m_drained{};
+	bool m_started{};
+};
+} // namespace
+
+auto main() -> int {
+	auto app = App{};
+	try {
+		app.run_event_loop();
+	} catch (std::exception const& e) {
+		std::cerr << std::format("{}: {}\n", app.has_started() ? "FAILED" : "SKIPPED", e.what());
+		return app.has_started() ? EXIT_FAILURE : skip_v;
+	}
+	if (app.get_failures() > 0) {
+		std::cerr << std::format("FAILED: {} checks\n", app.get_failures());
+		return EXIT_FAILURE;
+	}
+	std::cout << "PASSED: app post\n";
+}
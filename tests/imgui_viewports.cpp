@@ -0,0 +1,89 @@
+#include "GLFW/glfw3.h"
+#include "gvdi/app.hpp"
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+// Moves a Dear ImGui window out of the main viewport headless, and checks that its platform window is presented alongside the main one.
+// Requires a Dear ImGui build with viewports (docking branch, see GVDI_DEAR_IMGUI_DIR): skipped otherwise.
+
+namespace {
+// Not a test failure: no Vulkan driver, no headless surface support, or no viewports.
+constexpr auto skip_v = 77;
+
+#if defined(IMGUI_HAS_VIEWPORT)
+constexpr int frames_v{8};
+
+class App : public gvdi::App {
+  public:
+	[[nodiscard]] auto has_started() const -> bool { return m_started; }
+	[[nodiscard]] auto get_failures() const -> int { return m_failures; }
+
+  private:
+	void stage_initialize() final {
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		gvdi::App::stage_initialize();
+	}
+
+	auto create_glfw_window() -> GLFWwindow* final { return create_windowed_window("gvdi imgui viewports", 640, 360); }
+
+	[[nodiscard]] auto get_options() const -> gvdi::Options final {
+		auto ret = gvdi::Options{};
+		ret.imgui_viewports = true;
+		return ret;
+	}
+
+	void pre_first_frame() final {
+		m_started = true;
+		// windows outside the main viewport are not merged back into it.
+		ImGui::GetIO().ConfigViewportsNoAutoMerge = true;
+	}
+
+	void update() final {
+		auto const* main_viewport = ImGui::GetMainViewport();
+		ImGui::SetNextWindowPos(ImVec2{main_viewport->Pos.x + main_viewport->Size.x + 100.0f, main_viewport->Pos.y});
+		ImGui::SetNextWindowSize(ImVec2{200.0f, 100.0f});
+		if (ImGui::Begin("Viewport")) { ImGui::TextUnformatted("Platform window"); }
+		ImGui::End();
+
+		// stats refer to the previous frame: the platform window is created at the end of the first one.
+		if (++m_frame < frames_v) { return; }
+		check(ImGui::GetPlatformIO().Viewports.Size == 2, "platform window was not created");
+		check(get_frame_stats().windows == 2, "platform window was not presented");
+		check(get_frame_stats().imgui_draws > 0, "platform window was not drawn");
+		set_should_close_window(true);
+	}
+
+	void check(bool const condition, std::string_view const what) {
+		if (condition) { return; }
+		++m_failures;
+		std::cerr << std::format("FAILED: {}\n", what);
+	}
+
+	int m_frame{};
+	int m_failures{};
+	bool m_started{};
+};
+#endif
+} // namespace
+
+auto main() -> int {
+#if defined(IMGUI_HAS_VIEWPORT)
+	auto app = App{};
+	try {
+		app.run_event_loop();
+	} catch (std::exception const& e) {
+		std::cerr << std::format("{}: {}\n", app.has_started() ? "FAILED" : "SKIPPED", e.what());
+		return app.has_started() ? EXIT_FAILURE : skip_v;
+	}
+	if (app.get_failures() > 0) {
+		std::cerr << std::format("FAILED: {} checks\n", app.get_failures());
+		return EXIT_FAILURE;
+	}
+	std::cout << "PASSED: imgui viewports\n";
+#else
+	std::cout << "SKIPPED: Dear ImGui built without viewports\n";
+	return skip_v;
+#endif
+}
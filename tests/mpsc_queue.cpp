@@ -0,0 +1,151 @@
+#include "gvdi/mpsc_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Pushes from multiple producer threads into MpscQueue and BoundedMpscQueue while the main thread drains them,
+// and checks that nothing is lost or duplicated, that each producer's elements arrive in order, and the queues' counters.
+// Needs neither a window nor a Vulkan driver.
+
+namespace {
+using namespace std::chrono_literals;
+
+constexpr auto timeout_v = 10s;
+constexpr std::uint64_t producers_v{4};
+constexpr std::uint64_t pushes_v{50000};
+
+int g_failures{};
+
+void check(bool const condition, std::string_view const what) {
+	if (condition) { return; }
+	++g_failures;
+	std::cerr << std::format("FAILED: {}\n", what);
+}
+
+// producer index in the high bits, sequence number in the low bits.
+constexpr auto encode(std::uint64_t const producer, std::uint64_t const sequence) -> std::uint64_t { return (producer << 32) | sequence; }
+
+// checks that each producer's elements arrive exactly once, in order.
+class Receiver {
+  public:
+	void operator()(std::uint64_t const value) {
+		auto const producer = value >> 32;
+		auto const sequence = value & 0xffffffff;
+		if (producer >= producers_v || sequence != m_next[producer]) {
+			++m_out_of_order;
+			return;
+		}
+		++m_next[producer];
+		++m_received;
+	}
+
+	[[nodiscard]] auto get_received() const -> std::uint64_t { return m_received; }
+	[[nodiscard]] auto get_out_of_order() const -> std::uint64_t { return m_out_of_order; }
+
+  private:
+	std::vector<std::uint64_t> m_next = std::vector<std::uint64_t>(producers_v);
+	std::uint64_t m_received{};
+	std::uint64_t m_out_of_order{};
+};
+
+// runs push(producer, sequence) for each element on producers_v threads, draining queue on this thread meanwhile.
+template <typename Queue, typename Push>
+auto stress(Queue& queue, Push push) -> Receiver {
+	auto ret = Receiver{};
+	auto threads = std::vector<std::jthread>{};
+	for (std::uint64_t producer = 0; producer < producers_v; ++producer) {
+		threads.emplace_back([producer, &push] {
+			for (std::uint64_t i = 0; i < pushes_v; ++i) { push(producer, i); }
+		});
+	}
+	auto const deadline = std::chrono::steady_clock::now() + timeout_v;
+	while (ret.get_received() + ret.get_out_of_order() < producers_v * pushes_v && std::chrono::steady_clock::now() < deadline) {
+		if (queue.drain([&ret](std::uint64_t const value) { ret(value); }) == 0) { std::this_thread::yield(); }
+	}
+	threads.clear();
+	return ret;
+}
+
+void test_unbounded_stress() {
+	auto queue = gvdi::MpscQueue<std::uint64_t>{};
+	auto const received = stress(queue, [&queue](std::uint64_t const producer, std::uint64_t const sequence) {
+		queue.push(encode(producer, sequence));
+	});
+	check(received.get_out_of_order() == 0, "unbounded: elements out of order (or duplicated)");
+	check(received.get_received() == producers_v * pushes_v, "unbounded: elements lost");
+
+	auto value = std::uint64_t{};
+	check(!queue.pop(value), "unbounded: not empty after draining");
+	auto const stats = queue.get_stats();
+	check(stats.pushed == producers_v * pushes_v, "unbounded: pushed count");
+	check(stats.rejected == 0, "unbounded: rejected count");
+	check(stats.peak_depth > 0 && stats.peak_depth <= producers_v * pushes_v, "unbounded: peak depth");
+}
+
+void test_bounded_stress() {
+	auto queue = gvdi::BoundedMpscQueue<std::uint64_t>{64};
+	auto failures = std::atomic<std::uint64_t>{};
+	auto const received = stress(queue, [&queue, &failures](std::uint64_t const producer, std::uint64_t const sequence) {
+		while (!queue.try_push(encode(producer, sequence))) {
+			failures.fetch_add(1, std::memory_order_relaxed);
+			std::this_thread::yield();
+		}
+	});
+	check(received.get_out_of_order() == 0, "bounded: elements out of order (or duplicated)");
+	check(received.get_received() == producers_v * pushes_v, "bounded: elements lost");
+
+	auto const stats = queue.get_stats();
+	check(stats.pushed == producers_v * pushes_v, "bounded: pushed count");
+	check(stats.rejected == failures.load(), "bounded: rejected count");
+	check(stats.peak_depth > 0 && stats.peak_depth <= queue.get_capacity(), "bounded: peak depth");
+}
+
+void test_bounded_capacity() {
+	check(gvdi::BoundedMpscQueue<std::uint64_t>{0}.get_capacity() == 2, "capacity: minimum");
+	check(gvdi::BoundedMpscQueue<std::uint64_t>{100}.get_capacity() == 128, "capacity: rounded up to a power of two");
+
+	auto queue = gvdi::BoundedMpscQueue<std::uint64_t>{4};
+	for (std::uint64_t i = 0; i < 4; ++i) { check(queue.try_push(i), "capacity: push into a non-full queue"); }
+	check(!queue.try_push(4), "capacity: push into a full queue");
+	check(queue.get_stats().rejected == 1, "capacity: rejection counted");
+
+	auto popped = std::uint64_t{};
+	check(queue.pop(popped) && popped == 0, "capacity: pop order");
+	check(queue.try_push(4), "capacity: push after pop");
+	auto expected = std::uint64_t{1};
+	auto const drained = queue.drain([&expected](std::uint64_t const value) { check(value == expected++, "capacity: drain order"); });
+	check(drained == 4, "capacity: drain count");
+
+	auto const stats = queue.get_stats();
+	check(stats.pushed == 5, "capacity: pushed count");
+	check(stats.peak_depth == 4, "capacity: peak depth");
+}
+
+void test_drain_snapshot() {
+	auto queue = gvdi::MpscQueue<std::uint64_t>{};
+	for (std::uint64_t i = 0; i < 3; ++i) { queue.push(i); }
+	// elements pushed while draining are left for the next call.
+	auto const drained = queue.drain([&queue](std::uint64_t const value) { queue.push(value + 10); });
+	check(drained == 3, "drain: count");
+	check(queue.drain([](std::uint64_t /*value*/) {}) == 3, "drain: pushed while draining");
+	check(queue.get_stats().pushed == 6, "drain: pushed count");
+}
+} // namespace
+
+auto main() -> int {
+	test_unbounded_stress();
+	test_bounded_stress();
+	test_bounded_capacity();
+	test_drain_snapshot();
+	if (g_failures > 0) {
+		std::cerr << std::format("FAILED: {} checks\n", g_failures);
+		return EXIT_FAILURE;
+	}
+	std::cout << "PASSED: mpsc queue\n";
+}
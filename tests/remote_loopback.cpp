@@ -0,0 +1,226 @@
+#include "GLFW/glfw3.h"
+#include "detail/remote_protocol.hpp"
+#include "detail/remote_server.hpp"
+#include "detail/socket.hpp"
+#include "gvdi/app.hpp"
+#include "gvdi/remote.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Streams a known draw list and texture from a RemoteServer over 127.0.0.1, and checks what arrives:
+// decoded from the wire by a bare client, and drawn by a RemoteViewer.
+
+namespace {
+using namespace std::chrono_literals;
+
+// Not a test failure: no Vulkan driver, or no headless surface support.
+constexpr auto skip_v = 77;
+constexpr auto timeout_v = 5s;
+constexpr auto display_size_v = ImVec2{320.0f, 180.0f};
+
+// red, green, blue, white.
+constexpr auto pixels_v = std::array<std::uint8_t, 16>{255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 255, 255};
+
+template <typename Type>
+auto is_equal(ImVector<Type> const& lhs, std::span<Type const> const rhs) -> bool {
+	return std::size_t(lhs.Size) == rhs.size() && (rhs.empty() || std::memcmp(lhs.Data, rhs.data(), rhs.size_bytes()) == 0);
+}
+
+template <typename Pred>
+auto wait_for(Pred pred) -> bool {
+	auto const deadline = std::chrono::steady_clock::now() + timeout_v;
+	while (!pred()) {
+		if (std::chrono::steady_clock::now() > deadline) { return false; }
+		std::this_thread::sleep_for(5ms);
+	}
+	return true;
+}
+
+class App : public gvdi::App {
+  public:
+	[[nodiscard]] auto has_started() const -> bool { return m_started; }
+	[[nodiscard]] auto get_failures() const -> int { return m_failures; }
+
+  private:
+	void stage_initialize() final {
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		gvdi::App::stage_initialize();
+	}
+
+	auto create_glfw_window() -> GLFWwindow* final { return create_windowed_window("gvdi remote loopback", 640, 360); }
+
+	void pre_first_frame() final {
+		m_started = true;
+		run();
+		set_should_close_window(true);
+	}
+
+	void update() final {}
+
+	void check(bool const condition, std::string_view const what) {
+		if (condition) { return; }
+		++m_failures;
+		std::cerr << std::format("FAILED: {}\n", what);
+	}
+
+	void run() {
+		auto const bitmap = gvdi::Bitmap{.bytes = std::as_bytes(std::span{pixels_v}), .width = 2, .height = 2};
+		m_mirrored = create_texture(bitmap);
+		// drawn, but not mirrored by the server.
+		m_unmirrored = create_texture(bitmap);
+		build_draw_data();
+
+		using MirroredTexture = gvdi::detail::RemoteServer::MirroredTexture;
+		auto get_texture = [this](ImTextureID const id) -> std::optional<MirroredTexture> {
+			if (id != m_mirrored.get_id()) { return {}; }
+			return MirroredTexture{.pixels = std::as_bytes(std::span{pixels_v}), .width = 2, .height = 2, .generation = 1};
+		};
+		auto on_event = [](gvdi::detail::RemoteEvent const& /*event*/) {};
+		auto server = gvdi::detail::RemoteServer{"127.0.0.1:0", on_event, std::move(get_texture)};
+		auto const address = std::format("127.0.0.1:{}", server.get_port());
+
+		check_wire(server, address);
+		check(wait_for([&] { return !server.is_connected(); }), "server did not notice the client disconnecting");
+		check_viewer(server, address);
+	}
+
+	void build_draw_data() {
+		m_list.emplace(ImGui::GetDrawListSharedData());
+		auto& list = *m_list;
+		for (int i = 0; i < 8; ++i) {
+			auto const x = float((i % 4) * 40);
+			auto const y = float((i / 4) * 60);
+			auto const color = 0xff000000 | ImU32(i * 0x112233);
+			list.VtxBuffer.push_back(ImDrawVert{.pos = {x, y}, .uv = {float(i % 2), float(i / 4)}, .col = color});
+		}
+		for (ImDrawIdx const index : {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7}) { list.IdxBuffer.push_back(index); }
+		auto cmd = ImDrawCmd{};
+		cmd.ClipRect = ImVec4{0.0f, 0.0f, display_size_v.x, display_size_v.y};
+		cmd.TextureId = m_mirrored.get_id();
+		cmd.ElemCount = 6;
+		list.CmdBuffer.push_back(cmd);
+		cmd.TextureId = m_unmirrored.get_id();
+		cmd.IdxOffset = 6;
+		list.CmdBuffer.push_back(cmd);
+
+		m_draw_data.Valid = true;
+		m_draw_data.CmdLists.push_back(&list);
+		m_draw_data.CmdListsCount = 1;
+		m_draw_data.TotalVtxCount = list.VtxBuffer.Size;
+		m_draw_data.TotalIdxCount = list.IdxBuffer.Size;
+		m_draw_data.DisplaySize = display_size_v;
+		m_draw_data.FramebufferScale = ImVec2{1.0f, 1.0f};
+	}
+
+	// decodes a frame as sent, without a RemoteViewer.
+	void check_wire(gvdi::detail::RemoteServer& server, std::string const& address) {
+		auto const socket = gvdi::detail::Socket::connect(address);
+		check(gvdi::detail::exchange_remote_hello(socket), "hello");
+		check(wait_for([&] { return server.is_connected(); }), "server did not accept the client");
+		server.publish(m_draw_data);
+
+		auto message = std::vector<std::byte>{};
+		auto scratch = std::vector<std::byte>{};
+		auto const header = gvdi::detail::receive_remote_message(socket, message, scratch);
+		check(header && header->type == gvdi::detail::RemoteMessage::Frame, "no frame received");
+		if (!header) { return; }
+
+		auto reader = gvdi::detail::ByteReader{message};
+		auto const texture_count = reader.read<std::uint32_t>();
+		check(texture_count == 1, "only the mirrored texture is sent");
+		for (std::uint32_t i = 0; i < texture_count; ++i) {
+			auto const id = reader.read<std::uint64_t>();
+			auto const width = reader.read<std::int32_t>();
+			auto const height = reader.read<std::int32_t>();
+			auto const pixels = reader.read_bytes(std::size_t(width) * std::size_t(height) * 4);
+			check(id == gvdi::detail::to_remote_texture(m_mirrored.get_id()), "texture id");
+			check(width == 2 && height == 2, "texture size");
+			check(std::memcmp(pixels.data(), pixels_v.data(), pixels_v.size()) == 0, "texture pixels");
+		}
+
+		[[maybe_unused]] auto const display_pos = reader.read<ImVec2>();
+		auto const display_size = reader.read<ImVec2>();
+		[[maybe_unused]] auto const framebuffer_scale = reader.read<ImVec2>();
+		check(display_size.x == display_size_v.x && display_size.y == display_size_v.y, "display size");
+
+		check(reader.read<std::uint32_t>() == 1, "draw list count");
+		[[maybe_unused]] auto const hash = reader.read<std::uint64_t>();
+		check(reader.read<std::uint8_t>() == 0, "first draw list is sent in full");
+		auto const list = gvdi::detail::read_draw_list(reader);
+		check(reader.is_done(), "trailing bytes");
+		check(is_equal(m_list->VtxBuffer, std::span{list.vertices}), "vertices");
+		check(is_equal(m_list->IdxBuffer, std::span{list.indices}), "indices");
+		check(list.commands.size() == 2, "command count");
+		for (std::size_t i = 0; i < list.commands.size() && i < 2; ++i) {
+			auto const& expected = m_list->CmdBuffer[int(i)];
+			auto const& actual = list.commands[i];
+			check(actual.texture == gvdi::detail::to_remote_texture(expected.TextureId), "command texture");
+			check(actual.idx_offset == expected.IdxOffset && actual.elem_count == expected.ElemCount, "command range");
+		}
+	}
+
+	void check_viewer(gvdi::detail::RemoteServer& server, std::string const& address) {
+		auto viewer = gvdi::RemoteViewer{*this, address};
+		check(wait_for([&] { return server.is_connected(); }), "server did not accept the viewer");
+
+		// drawn at the remote display's size: positions are not scaled.
+		auto out = std::optional<ImDrawList>{};
+		auto const received = wait_for([&] {
+			server.publish(m_draw_data);
+			out.emplace(ImGui::GetDrawListSharedData());
+			out->_ResetForNewFrame();
+			out->PushClipRectFullScreen();
+			viewer.draw(*out, ImVec2{}, display_size_v);
+			return viewer.get_stats().frames > 0;
+		});
+		check(received, "viewer received no frame");
+		if (!received) { return; }
+
+		check(viewer.get_stats().textures == 1, "viewer received the mirrored texture");
+		check(is_equal(out->VtxBuffer, std::span<ImDrawVert const>{m_list->VtxBuffer.Data, std::size_t(m_list->VtxBuffer.Size)}),
+			  "viewer vertices");
+		check(is_equal(out->IdxBuffer, std::span<ImDrawIdx const>{m_list->IdxBuffer.Data, std::size_t(m_list->IdxBuffer.Size)}),
+			  "viewer indices");
+
+		auto textures = std::vector<ImTextureID>{};
+		for (auto const& cmd : out->CmdBuffer) {
+			if (cmd.ElemCount > 0) { textures.push_back(cmd.TextureId); }
+		}
+		// the local copy of the mirrored texture, and the placeholder.
+		check(textures.size() == 2 && textures[0] != textures[1], "viewer textures");
+	}
+
+	gvdi::Texture m_mirrored{};
+	gvdi::Texture m_unmirrored{};
+	std::optional<ImDrawList> m_list{};
+	ImDrawData m_draw_data{};
+	int m_failures{};
+	bool m_started{};
+};
+} // namespace
+
+auto main() -> int {
+	auto app = App{};
+	try {
+		app.run_event_loop();
+	} catch (std::exception const& e) {
+		std::cerr << std::format("{}: {}\n", app.has_started() ? "FAILED" : "SKIPPED", e.what());
+		return app.has_started() ? EXIT_FAILURE : skip_v;
+	}
+	if (app.get_failures() > 0) {
+		std::cerr << std::format("FAILED: {} checks\n", app.get_failures());
+		return EXIT_FAILURE;
+	}
+	std::cout << "PASSED: remote loopback\n";
+}
@@ -0,0 +1,85 @@
+#include "GLFW/glfw3.h"
+#include "gvdi/app.hpp"
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+// Opens a secondary window headless and draws into it, checking that it is presented (and drawn) alongside the main window
+// until it is destroyed.
+
+namespace {
+// Not a test failure: no Vulkan driver, or no headless surface support.
+constexpr auto skip_v = 77;
+constexpr int open_frames_v{4};
+
+class App : public gvdi::App {
+  public:
+	[[nodiscard]] auto has_started() const -> bool { return m_started; }
+	[[nodiscard]] auto get_failures() const -> int { return m_failures; }
+
+  private:
+	void stage_initialize() final {
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		gvdi::App::stage_initialize();
+	}
+
+	auto create_glfw_window() -> GLFWwindow* final { return create_windowed_window("gvdi secondary window", 640, 360); }
+
+	void pre_first_frame() final {
+		m_started = true;
+		m_secondary = create_secondary_window(gvdi::SecondaryWindowCreateInfo{.title = "gvdi secondary", .width = 320, .height = 180});
+		check(m_secondary.get_glfw_window() != nullptr, "secondary window has no GLFW window");
+	}
+
+	void update() final {
+		++m_frame;
+		if (m_secondary) {
+			auto& draw_list = m_secondary.get_draw_list();
+			draw_list.AddRectFilled(ImVec2{16.0f, 16.0f}, ImVec2{160.0f, 90.0f}, IM_COL32(255, 0, 0, 255));
+			draw_list.AddText(ImVec2{16.0f, 120.0f}, IM_COL32_WHITE, "Secondary window");
+		}
+
+		// stats refer to the previous frame.
+		if (m_frame == open_frames_v) {
+			auto const stats = get_frame_stats();
+			check(stats.windows == 2, "secondary window was not presented");
+			check(stats.imgui_draws > 0, "secondary window was not drawn");
+			check(!m_secondary.should_close(), "secondary window should not close");
+			glfwSetWindowShouldClose(m_secondary.get_glfw_window(), GLFW_TRUE);
+			check(m_secondary.should_close(), "secondary window should close");
+			m_secondary = {};
+		}
+		if (m_frame == open_frames_v + 2) {
+			check(get_frame_stats().windows == 1, "secondary window was not removed");
+			set_should_close_window(true);
+		}
+	}
+
+	void check(bool const condition, std::string_view const what) {
+		if (condition) { return; }
+		++m_failures;
+		std::cerr << std::format("FAILED: {}\n", what);
+	}
+
+	gvdi::SecondaryWindow m_secondary{};
+	int m_frame{};
+	int m_failures{};
+	bool m_started{};
+};
+} // namespace
+
+auto main() -> int {
+	auto app = App{};
+	try {
+		app.run_event_loop();
+	} catch (std::exception const& e) {
+		std::cerr << std::format("{}: {}\n", app.has_started() ? "FAILED" : "SKIPPED", e.what());
+		return app.has_started() ? EXIT_FAILURE : skip_v;
+	}
+	if (app.get_failures() > 0) {
+		std::cerr << std::format("FAILED: {} checks\n", app.get_failures());
+		return EXIT_FAILURE;
+	}
+	std::cout << "PASSED: secondary window\n";
+}
@@ -0,0 +1,117 @@
+#include "GLFW/glfw3.h"
+#include "gvdi/app.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <new>
+
+// Runs a static UI headless, and checks that frames past warm-up neither allocate (operator new or Dear ImGui's heap)
+// nor create Vulkan objects.
+
+namespace {
+std::atomic<std::uint64_t> g_allocations{};
+
+auto allocate(std::size_t const size) -> void* {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (auto* ret = std::malloc(size == 0 ? 1 : size)) { return ret; }
+	throw std::bad_alloc{};
+}
+
+auto allocate(std::size_t const size, std::align_val_t const align) -> void* {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	auto const alignment = static_cast<std::size_t>(align);
+	auto const rounded = (size + alignment - 1) / alignment * alignment;
+#if defined(_MSC_VER)
+	auto* ret = _aligned_malloc(rounded == 0 ? alignment : rounded, alignment);
+#else
+	auto* ret = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+#endif
+	if (ret == nullptr) { throw std::bad_alloc{}; }
+	return ret;
+}
+
+void deallocate(void* ptr, std::align_val_t const /*align*/) noexcept {
+#if defined(_MSC_VER)
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+// Not a test failure: no Vulkan driver, or no headless surface support.
+constexpr auto skip_v = 77;
+constexpr std::uint64_t warmup_frames_v{120};
+constexpr std::uint64_t measured_frames_v{240};
+
+class App : public gvdi::App {
+  public:
+	[[nodiscard]] auto has_started() const -> bool { return m_started; }
+	[[nodiscard]] auto get_failures() const -> int { return m_failures; }
+
+  private:
+	void stage_initialize() final {
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		gvdi::App::stage_initialize();
+	}
+
+	auto create_glfw_window() -> GLFWwindow* final { return create_windowed_window("gvdi steady state", 640, 360); }
+
+	void pre_first_frame() final { m_started = true; }
+
+	void update() final {
+		if (ImGui::Begin("Static")) {
+			ImGui::TextUnformatted("Steady state");
+			ImGui::Button("Button");
+		}
+		ImGui::End();
+
+		// counters since the previous update(): one full iteration of the event loop.
+		auto const allocations = g_allocations.exchange(0, std::memory_order_relaxed);
+		auto const imgui_allocations = get_imgui_alloc_stats().frame_allocations;
+		auto const vk_objects = get_frame_stats().vk_objects_created;
+		++m_frame;
+		if (m_frame > warmup_frames_v && (allocations > 0 || imgui_allocations > 0 || vk_objects > 0)) {
+			++m_failures;
+			std::cerr << std::format("frame {}: {} allocations, {} ImGui allocations, {} Vulkan objects\n", m_frame, allocations,
+									 imgui_allocations, vk_objects);
+			// not attributed to the next frame.
+			g_allocations.store(0, std::memory_order_relaxed);
+		}
+		if (m_frame == warmup_frames_v + measured_frames_v) { set_should_close_window(true); }
+	}
+
+	std::uint64_t m_frame{};
+	int m_failures{};
+	bool m_started{};
+};
+} // namespace
+
+auto operator new(std::size_t const size) -> void* { return allocate(size); }
+auto operator new[](std::size_t const size) -> void* { return allocate(size); }
+auto operator new(std::size_t const size, std::align_val_t const align) -> void* { return allocate(size, align); }
+auto operator new[](std::size_t const size, std::align_val_t const align) -> void* { return allocate(size, align); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t const /*size*/) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t const /*size*/) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t const align) noexcept { deallocate(ptr, align); }
+void operator delete[](void* ptr, std::align_val_t const align) noexcept { deallocate(ptr, align); }
+void operator delete(void* ptr, std::size_t const /*size*/, std::align_val_t const align) noexcept { deallocate(ptr, align); }
+void operator delete[](void* ptr, std::size_t const /*size*/, std::align_val_t const align) noexcept { deallocate(ptr, align); }
+
+auto main() -> int {
+	auto app = App{};
+	try {
+		app.run_event_loop();
+	} catch (std::exception const& e) {
+		std::cerr << std::format("{}: {}\n", app.has_started() ? "FAILED" : "SKIPPED", e.what());
+		return app.has_started() ? EXIT_FAILURE : skip_v;
+	}
+	if (app.get_failures() > 0) {
+		std::cerr << std::format("FAILED: {} of {} frames allocated\n", app.get_failures(), measured_frames_v);
+		return EXIT_FAILURE;
+	}
+	std::cout << std::format("PASSED: {} steady state frames\n", measured_frames_v);
+}